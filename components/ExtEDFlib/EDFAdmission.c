@@ -0,0 +1,481 @@
+// ************************* File Includes *************************** //
+#include "EDFAdmission.h"
+#include "ExtEDFlib.h"
+// ******************************************************************* //
+
+// ************************ Admission Defines ************************ //
+#define EDF_ADMISSION_NO_DEADLINE           UINT64_MAX
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef struct EDFAdmittedTask
+{
+    uint64_t ullWCET;
+    uint64_t ullPeriod;
+    uint64_t ullRelDeadline;
+} EDFAdmittedTask_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+// the admitted tasks of every core, the candidate of a test is placed right after them
+static EDFAdmittedTask_t xAdmittedTasks[EDF_NUM_OF_RUN_QUEUES][MAX_NUM_OF_PERIODIC_TASKS];
+static UBaseType_t uxNumOfAdmittedTasks[EDF_NUM_OF_RUN_QUEUES];
+// copy of the admitted tasks of one core for a trial, the candidate is placed right after them as well
+static EDFAdmittedTask_t xTrialTasks[MAX_NUM_OF_PERIODIC_TASKS];
+static UBaseType_t uxNumOfTrialTasks = 0;
+// ************************************************************************ //
+
+// ******************* Private Function Declarations ***************** //
+static uint64_t prvDemand(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullTime);
+static uint64_t prvLastDeadlineBefore(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullTime);
+static BaseType_t prvBusyPeriod(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullLimit, uint64_t * pullBusyPeriod);
+static BaseType_t prvSlackWalk(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullHorizon, uint64_t * pullSlack);
+static BaseType_t prvProcessorDemandTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, TickType_t * pxSlack);
+#if USE_GLOBAL_EDF == 1
+static BaseType_t prvIsTopPriority(const EDFAdmittedTask_t * pxTask);
+static BaseType_t prvGFBTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullCores);
+static BaseType_t prvBCLTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullCores);
+static BaseType_t prvGlobalTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks);
+#endif
+// ******************************************************************* //
+
+void vEDFAdmissionInit(void)
+{
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+    {
+        uxNumOfAdmittedTasks[xCore] = 0;
+    }
+}
+
+BaseType_t xEDFAdmissionTest(BaseType_t xCore, TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline, TickType_t * pxSlack)
+{
+    EDFAdmittedTask_t * pxTasks = xAdmittedTasks[xCore];
+    UBaseType_t uxNumOfTasks = uxNumOfAdmittedTasks[xCore];
+    TickType_t xSlack = 0;
+    BaseType_t xSchedulable = pdFALSE;
+
+    configASSERT((xCore >= 0) && (xCore < EDF_NUM_OF_RUN_QUEUES));
+    configASSERT(xPeriod > 0);
+    configASSERT(xRelDeadline <= xPeriod);
+
+    if (uxNumOfTasks < MAX_NUM_OF_PERIODIC_TASKS)
+    {
+        pxTasks[uxNumOfTasks].ullWCET = xWCET;
+        pxTasks[uxNumOfTasks].ullPeriod = xPeriod;
+        pxTasks[uxNumOfTasks].ullRelDeadline = xRelDeadline;
+        xSchedulable = prvProcessorDemandTest(pxTasks, uxNumOfTasks + 1, &xSlack);
+    }
+
+    if (pxSlack != NULL)
+    {
+        *pxSlack = xSlack;
+    }
+    return xSchedulable;
+}
+
+BaseType_t xEDFAdmissionAdd(BaseType_t xCore, TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline, TickType_t * pxSlack)
+{
+    BaseType_t xSchedulable = xEDFAdmissionTest(xCore, xWCET, xPeriod, xRelDeadline, pxSlack);
+
+    if (xSchedulable == pdTRUE)
+    {
+        // the candidate is already in place
+        uxNumOfAdmittedTasks[xCore]++;
+    }
+    return xSchedulable;
+}
+
+BaseType_t xEDFAdmissionRemove(BaseType_t xCore, TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline)
+{
+    EDFAdmittedTask_t * pxTasks = xAdmittedTasks[xCore];
+
+    configASSERT((xCore >= 0) && (xCore < EDF_NUM_OF_RUN_QUEUES));
+
+    for (UBaseType_t i = 0; i < uxNumOfAdmittedTasks[xCore]; i++)
+    {
+        if ((pxTasks[i].ullWCET == xWCET) && (pxTasks[i].ullPeriod == xPeriod) && (pxTasks[i].ullRelDeadline == xRelDeadline))
+        {
+            // the order of the admitted tasks does not matter to the tests
+            pxTasks[i] = pxTasks[--uxNumOfAdmittedTasks[xCore]];
+            return pdTRUE;
+        }
+    }
+    return pdFALSE;
+}
+
+void vEDFAdmissionTrialBegin(BaseType_t xCore)
+{
+    configASSERT((xCore >= 0) && (xCore < EDF_NUM_OF_RUN_QUEUES));
+
+    memcpy(xTrialTasks, xAdmittedTasks[xCore], uxNumOfAdmittedTasks[xCore] * sizeof(EDFAdmittedTask_t));
+    uxNumOfTrialTasks = uxNumOfAdmittedTasks[xCore];
+}
+
+BaseType_t xEDFAdmissionTrialRemove(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline)
+{
+    for (UBaseType_t i = 0; i < uxNumOfTrialTasks; i++)
+    {
+        if ((xTrialTasks[i].ullWCET == xWCET) && (xTrialTasks[i].ullPeriod == xPeriod) && (xTrialTasks[i].ullRelDeadline == xRelDeadline))
+        {
+            xTrialTasks[i] = xTrialTasks[--uxNumOfTrialTasks];
+            return pdTRUE;
+        }
+    }
+    return pdFALSE;
+}
+
+BaseType_t xEDFAdmissionTrialTest(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline)
+{
+    TickType_t xSlack;
+
+    configASSERT(xPeriod > 0);
+    configASSERT(xRelDeadline <= xPeriod);
+
+    if (uxNumOfTrialTasks >= MAX_NUM_OF_PERIODIC_TASKS)
+    {
+        return pdFALSE;
+    }
+    xTrialTasks[uxNumOfTrialTasks].ullWCET = xWCET;
+    xTrialTasks[uxNumOfTrialTasks].ullPeriod = xPeriod;
+    xTrialTasks[uxNumOfTrialTasks].ullRelDeadline = xRelDeadline;
+    #if USE_GLOBAL_EDF == 1
+    (void) xSlack;
+    return prvGlobalTest(xTrialTasks, uxNumOfTrialTasks + 1);
+    #else
+    return prvProcessorDemandTest(xTrialTasks, uxNumOfTrialTasks + 1, &xSlack);
+    #endif
+}
+
+#if USE_GLOBAL_EDF == 1
+BaseType_t xEDFGlobalAdmissionTest(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline)
+{
+    // the one task set of all cores is kept in the set of run queue 0
+    EDFAdmittedTask_t * pxTasks = xAdmittedTasks[0];
+    UBaseType_t uxNumOfTasks = uxNumOfAdmittedTasks[0];
+
+    configASSERT(xPeriod > 0);
+    configASSERT(xRelDeadline <= xPeriod);
+
+    if (uxNumOfTasks >= MAX_NUM_OF_PERIODIC_TASKS)
+    {
+        return pdFALSE;
+    }
+    pxTasks[uxNumOfTasks].ullWCET = xWCET;
+    pxTasks[uxNumOfTasks].ullPeriod = xPeriod;
+    pxTasks[uxNumOfTasks].ullRelDeadline = xRelDeadline;
+    return prvGlobalTest(pxTasks, uxNumOfTasks + 1);
+}
+
+BaseType_t xEDFGlobalAdmissionAdd(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline)
+{
+    BaseType_t xSchedulable = xEDFGlobalAdmissionTest(xWCET, xPeriod, xRelDeadline);
+
+    if (xSchedulable == pdTRUE)
+    {
+        // the candidate is already in place
+        uxNumOfAdmittedTasks[0]++;
+    }
+    return xSchedulable;
+}
+
+BaseType_t xEDFGlobalAdmissionRemove(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline)
+{
+    return xEDFAdmissionRemove(0, xWCET, xPeriod, xRelDeadline);
+}
+
+BaseType_t xEDFGlobalIsTopPriority(TickType_t xWCET, TickType_t xRelDeadline)
+{
+    EDFAdmittedTask_t xTask = {xWCET, xRelDeadline, xRelDeadline};
+    return prvIsTopPriority(&xTask);
+}
+#endif
+
+// ****************** Private Function Definitions ******************* //
+static uint64_t prvDemand(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullTime)
+{
+    // execution of the jobs released at 0 or later with a deadline at ullTime or earlier
+    uint64_t ullDemand = 0;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        if (pxTasks[i].ullRelDeadline <= ullTime)
+        {
+            ullDemand += ((ullTime - pxTasks[i].ullRelDeadline) / pxTasks[i].ullPeriod + 1) * pxTasks[i].ullWCET;
+        }
+    }
+    return ullDemand;
+}
+
+static uint64_t prvLastDeadlineBefore(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullTime)
+{
+    // latest absolute deadline strictly before ullTime, EDF_ADMISSION_NO_DEADLINE if there is none
+    uint64_t ullDeadline = EDF_ADMISSION_NO_DEADLINE;
+    uint64_t ullTaskDeadline;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        if (pxTasks[i].ullRelDeadline < ullTime)
+        {
+            ullTaskDeadline = pxTasks[i].ullRelDeadline + ((ullTime - 1 - pxTasks[i].ullRelDeadline) / pxTasks[i].ullPeriod) * pxTasks[i].ullPeriod;
+            if ((ullDeadline == EDF_ADMISSION_NO_DEADLINE) || (ullTaskDeadline > ullDeadline))
+            {
+                ullDeadline = ullTaskDeadline;
+            }
+        }
+    }
+    return ullDeadline;
+}
+
+static BaseType_t prvBusyPeriod(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullLimit, uint64_t * pullBusyPeriod)
+{
+    // length of the synchronous busy period, the fixed point of W(L) = sum(ceil(L / T) * C), pdFALSE past ullLimit
+    uint64_t ullLength = 0;
+    uint64_t ullWorkload;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        ullLength += pxTasks[i].ullWCET;
+    }
+
+    while (ullLength > 0)
+    {
+        ullWorkload = 0;
+        for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+        {
+            ullWorkload += ((ullLength + pxTasks[i].ullPeriod - 1) / pxTasks[i].ullPeriod) * pxTasks[i].ullWCET;
+        }
+        if (ullWorkload == ullLength)
+        {
+            break;
+        }
+        if (ullWorkload > ullLimit)
+        {
+            return pdFALSE;
+        }
+        ullLength = ullWorkload;
+    }
+
+    *pullBusyPeriod = ullLength;
+    return pdTRUE;
+}
+
+static BaseType_t prvSlackWalk(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullHorizon, uint64_t * pullSlack)
+{
+    // visits the deadlines up to ullHorizon backwards, pdFALSE with the overload in *pullSlack if the demand exceeds one
+    uint64_t ullDeadline = prvLastDeadlineBefore(pxTasks, uxNumOfTasks, ullHorizon + 1);
+    uint64_t ullDemand;
+
+    while (ullDeadline != EDF_ADMISSION_NO_DEADLINE)
+    {
+        ullDemand = prvDemand(pxTasks, uxNumOfTasks, ullDeadline);
+        if (ullDemand > ullDeadline)
+        {
+            *pullSlack = ullDemand - ullDeadline;
+            return pdFALSE;
+        }
+        if ((ullDeadline - ullDemand) < *pullSlack)
+        {
+            *pullSlack = ullDeadline - ullDemand;
+        }
+
+        // every deadline d in [h(t) + slack, t) has d - h(d) >= d - h(t) >= slack, so none of them can be tighter
+        // (with no slack left this is the QPA step to the last deadline before h(t))
+        ullDeadline = prvLastDeadlineBefore(pxTasks, uxNumOfTasks, ullDemand + *pullSlack);
+    }
+    return pdTRUE;
+}
+
+static BaseType_t prvProcessorDemandTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, TickType_t * pxSlack)
+{
+    uint64_t ullUtilization = 0;            // Q32 rounded down, above 1 the set is overloaded for sure
+    uint64_t ullUtilizationUp = 0;          // Q32 rounded up
+    uint64_t ullOffset = 0;                 // sum(C * (T - D) / T) in Q32 rounded up, h(t) <= U * t + offset
+    uint64_t ullWCETSum = 0;
+    uint64_t ullMaxPeriod = 0;
+    uint64_t ullMaxDeadline = 0;
+    uint64_t ullFirstDeadline = EDF_ADMISSION_NO_DEADLINE;
+    uint64_t ullHyperperiod = 1;            // EDF_ADMISSION_HORIZON or more once it does not fit
+    uint64_t ullHorizon = EDF_ADMISSION_NO_DEADLINE;
+    uint64_t ullTaskUtilization;
+    uint64_t ullSlack;
+    uint64_t ullDemand;
+    uint64_t ullBusyPeriod;
+    uint64_t a, b, r;
+    BaseType_t xResult;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        if (pxTasks[i].ullWCET > pxTasks[i].ullPeriod)
+        {
+            *pxSlack = 0;
+            return pdFALSE;
+        }
+        ullTaskUtilization = ((pxTasks[i].ullWCET << 32) + pxTasks[i].ullPeriod - 1) / pxTasks[i].ullPeriod;
+        ullUtilization += (pxTasks[i].ullWCET << 32) / pxTasks[i].ullPeriod;
+        ullUtilizationUp += ullTaskUtilization;
+        ullOffset += (pxTasks[i].ullPeriod - pxTasks[i].ullRelDeadline) * ullTaskUtilization;
+        ullWCETSum += pxTasks[i].ullWCET;
+        ullMaxPeriod = (pxTasks[i].ullPeriod > ullMaxPeriod) ? pxTasks[i].ullPeriod : ullMaxPeriod;
+        ullMaxDeadline = (pxTasks[i].ullRelDeadline > ullMaxDeadline) ? pxTasks[i].ullRelDeadline : ullMaxDeadline;
+        ullFirstDeadline = (pxTasks[i].ullRelDeadline < ullFirstDeadline) ? pxTasks[i].ullRelDeadline : ullFirstDeadline;
+
+        if (ullHyperperiod < EDF_ADMISSION_HORIZON)
+        {
+            a = ullHyperperiod;
+            b = pxTasks[i].ullPeriod;
+            while (b != 0)
+            {
+                r = a % b;
+                a = b;
+                b = r;
+            }
+            ullHyperperiod = (ullHyperperiod / a) * pxTasks[i].ullPeriod;
+        }
+    }
+    if (ullUtilization > (1ULL << 32))
+    {
+        *pxSlack = 0;
+        return pdFALSE;
+    }
+
+    // the slack at the first deadline bounds the walk
+    ullDemand = prvDemand(pxTasks, uxNumOfTasks, ullFirstDeadline);
+    if (ullDemand > ullFirstDeadline)
+    {
+        *pxSlack = ullDemand - ullFirstDeadline;
+        return pdFALSE;
+    }
+    ullSlack = ullFirstDeadline - ullDemand;
+
+    // t - h(t) >= (1 - U) * t - offset, no deadline after (slack + offset) / (1 - U) has less slack (limits for 64 bits)
+    if ((ullUtilizationUp < (1ULL << 32)) && (ullWCETSum < (1ULL << 30)) && (ullMaxPeriod < (1ULL << 31)))
+    {
+        ullHorizon = ((ullSlack << 32) + ullOffset) / ((1ULL << 32) - ullUtilizationUp) + 1;
+    }
+    if (ullHorizon > EDF_ADMISSION_HORIZON)
+    {
+        // U is 1 within the rounding or the bound is too far out: the busy period decides, it ends by the hyperperiod if U <= 1
+        if (prvBusyPeriod(pxTasks, uxNumOfTasks, (ullHyperperiod < EDF_ADMISSION_HORIZON) ? ullHyperperiod : EDF_ADMISSION_HORIZON, &ullBusyPeriod) == pdFALSE)
+        {
+            *pxSlack = 0;
+            return (ullHyperperiod < EDF_ADMISSION_HORIZON) ? pdFALSE : EDF_ADMISSION_UNDECIDED;
+        }
+        ullHorizon = EDF_ADMISSION_HORIZON;
+    }
+    // with U <= 1, t - h(t) only grows from one hyperperiod to the next
+    if ((ullHyperperiod < EDF_ADMISSION_HORIZON) && (ullHyperperiod + ullMaxDeadline < ullHorizon))
+    {
+        ullHorizon = ullHyperperiod + ullMaxDeadline;
+    }
+
+    xResult = prvSlackWalk(pxTasks, uxNumOfTasks, ullHorizon, &ullSlack);
+    *pxSlack = (ullSlack > portMAX_DELAY) ? portMAX_DELAY : (TickType_t)ullSlack;
+    return xResult;
+}
+
+#if USE_GLOBAL_EDF == 1
+static BaseType_t prvIsTopPriority(const EDFAdmittedTask_t * pxTask)
+{
+    #if USE_GLOBAL_EDF_US == 1
+    // EDF-US: density C / D above m / (2m - 1)
+    return ((pxTask->ullWCET * (2 * EDF_NUM_OF_CORES - 1)) > (pxTask->ullRelDeadline * EDF_NUM_OF_CORES)) ? pdTRUE : pdFALSE;
+    #else
+    (void)pxTask;
+    return pdFALSE;
+    #endif
+}
+
+static BaseType_t prvGFBTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullCores)
+{
+    // sum(C / D) <= m - (m - 1) * max(C / D) over the tasks scheduled by deadline, densities in Q32 rounded up
+    uint64_t ullDensitySum = 0;
+    uint64_t ullMaxDensity = 0;
+    uint64_t ullDensity;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        if (prvIsTopPriority(&pxTasks[i]) == pdTRUE)
+        {
+            continue;
+        }
+        ullDensity = ((pxTasks[i].ullWCET << 32) + pxTasks[i].ullRelDeadline - 1) / pxTasks[i].ullRelDeadline;
+        ullDensitySum += ullDensity;
+        if (ullDensity > ullMaxDensity)
+        {
+            ullMaxDensity = ullDensity;
+        }
+    }
+    return ((ullDensitySum + (ullCores - 1) * ullMaxDensity) <= (ullCores << 32)) ? pdTRUE : pdFALSE;
+}
+
+static BaseType_t prvBCLTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks, uint64_t ullCores)
+{
+    // a job of task k can only miss its deadline D_k if the other tasks keep every core busy for more than
+    // D_k - C_k of its window, each of them can do so for at most its workload in the window and at most D_k - C_k
+    uint64_t ullWindowSlack;
+    uint64_t ullInterference;
+    uint64_t ullJobs;
+    uint64_t ullWorkload;
+
+    for (UBaseType_t k = 0; k < uxNumOfTasks; k++)
+    {
+        if (prvIsTopPriority(&pxTasks[k]) == pdTRUE)
+        {
+            continue;
+        }
+        ullWindowSlack = pxTasks[k].ullRelDeadline - pxTasks[k].ullWCET;
+        ullInterference = 0;
+
+        for (UBaseType_t i = 0; (i < uxNumOfTasks) && (ullInterference < ullCores * ullWindowSlack); i++)
+        {
+            if ((i == k) || (prvIsTopPriority(&pxTasks[i]) == pdTRUE))
+            {
+                continue;
+            }
+            // jobs of task i with their deadline in the window, then the job carried in at its start
+            ullJobs = (pxTasks[i].ullRelDeadline <= pxTasks[k].ullRelDeadline) ? ((pxTasks[k].ullRelDeadline - pxTasks[i].ullRelDeadline) / pxTasks[i].ullPeriod + 1) : 0;
+            ullWorkload = ullJobs * pxTasks[i].ullWCET;
+            if (ullJobs * pxTasks[i].ullPeriod < pxTasks[k].ullRelDeadline)
+            {
+                ullWorkload += (pxTasks[k].ullRelDeadline - ullJobs * pxTasks[i].ullPeriod < pxTasks[i].ullWCET) ? (pxTasks[k].ullRelDeadline - ullJobs * pxTasks[i].ullPeriod) : pxTasks[i].ullWCET;
+            }
+            ullInterference += (ullWorkload < ullWindowSlack) ? ullWorkload : ullWindowSlack;
+        }
+
+        if (ullInterference >= ullCores * ullWindowSlack)
+        {
+            return pdFALSE;
+        }
+    }
+    return pdTRUE;
+}
+
+static BaseType_t prvGlobalTest(const EDFAdmittedTask_t * pxTasks, UBaseType_t uxNumOfTasks)
+{
+    // the top priority tasks of EDF-US run as soon as they are released, each takes a core away from the others
+    uint64_t ullCores = EDF_NUM_OF_CORES;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        if (pxTasks[i].ullWCET > pxTasks[i].ullRelDeadline)
+        {
+            return pdFALSE;
+        }
+        if (prvIsTopPriority(&pxTasks[i]) == pdTRUE)
+        {
+            if (ullCores == 1)
+            {
+                return pdFALSE;
+            }
+            ullCores--;
+        }
+    }
+
+    if (prvGFBTest(pxTasks, uxNumOfTasks, ullCores) == pdTRUE)
+    {
+        return pdTRUE;
+    }
+    return prvBCLTest(pxTasks, uxNumOfTasks, ullCores);
+}
+#endif
+// ******************************************************************* //
@@ -0,0 +1,54 @@
+// ************************* File Includes *************************** //
+#include "EDFArrivalQueue.h"
+#include "EDFRing.h"
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef struct EDFArrival
+{
+    uint32_t ulSequence;                    // of the ring, written last to publish the job
+    EDFAperiodicJob_t xJob;
+} EDFArrival_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+static EDFArrival_t xArrivals[EDF_ARRIVAL_QUEUE_SIZE];
+static EDFRing_t xArrivalQueue;
+// ************************************************************************ //
+
+void vEDFArrivalQueueInit(void)
+{
+    vEDFRingInitialise(&xArrivalQueue, xArrivals, EDF_ARRIVAL_QUEUE_SIZE, sizeof(EDFArrival_t));
+}
+
+BaseType_t xEDFArrivalSend(const EDFAperiodicJob_t * pxJob)
+{
+    uint32_t ulPosition;
+    EDFArrival_t * pxArrival = (EDFArrival_t *)pvEDFRingReserve(&xArrivalQueue, &ulPosition);
+
+    if (pxArrival == NULL)
+    {
+        return pdFALSE;
+    }
+    pxArrival->xJob = *pxJob;
+    vEDFRingPublish(&xArrivalQueue, ulPosition);
+    return pdTRUE;
+}
+
+BaseType_t xEDFArrivalReceive(EDFAperiodicJob_t * pxJob)
+{
+    EDFArrival_t * pxArrival = (EDFArrival_t *)pvEDFRingPeek(&xArrivalQueue);
+
+    if (pxArrival == NULL)
+    {
+        return pdFALSE;
+    }
+    *pxJob = pxArrival->xJob;
+    vEDFRingRelease(&xArrivalQueue);
+    return pdTRUE;
+}
+
+BaseType_t xEDFArrivalPending(void)
+{
+    return xEDFRingPending(&xArrivalQueue);
+}
@@ -0,0 +1,141 @@
+// ************************* File Includes *************************** //
+#include "EDFHeap.h"
+// ******************************************************************* //
+
+// ****************** Private Function Declarations ***************** //
+static void heapPlace(EDFHeap_t * pxHeap, EDFHeapItem_t * pxItem, UBaseType_t uxIndex);
+static void heapSiftUp(EDFHeap_t * pxHeap, UBaseType_t uxIndex);
+static void heapSiftDown(EDFHeap_t * pxHeap, UBaseType_t uxIndex);
+// ******************************************************************* //
+// ****************** Private Functions Definitions ****************** //
+static void heapPlace(EDFHeap_t * pxHeap, EDFHeapItem_t * pxItem, UBaseType_t uxIndex)
+{
+    pxHeap->pxItems[uxIndex] = pxItem;
+    pxItem->uxIndex = uxIndex;
+}
+
+static void heapSiftUp(EDFHeap_t * pxHeap, UBaseType_t uxIndex)
+{
+    EDFHeapItem_t * pxItem = pxHeap->pxItems[uxIndex];
+    UBaseType_t uxParent;
+
+    while (uxIndex > 0)
+    {
+        uxParent = (uxIndex - 1) >> 1;
+        if (heapIS_BEFORE(pxItem->xItemValue, pxHeap->pxItems[uxParent]->xItemValue) == pdFALSE)
+        {
+            break;
+        }
+        heapPlace(pxHeap, pxHeap->pxItems[uxParent], uxIndex);
+        uxIndex = uxParent;
+    }
+    heapPlace(pxHeap, pxItem, uxIndex);
+}
+
+static void heapSiftDown(EDFHeap_t * pxHeap, UBaseType_t uxIndex)
+{
+    EDFHeapItem_t * pxItem = pxHeap->pxItems[uxIndex];
+    UBaseType_t uxChild;
+
+    for (;;)
+    {
+        uxChild = (uxIndex << 1) + 1;
+        if (uxChild >= pxHeap->uxNumberOfItems)
+        {
+            break;
+        }
+        // pick the smaller of the two children
+        if (((uxChild + 1) < pxHeap->uxNumberOfItems) && (heapIS_BEFORE(pxHeap->pxItems[uxChild + 1]->xItemValue, pxHeap->pxItems[uxChild]->xItemValue) == pdTRUE))
+        {
+            uxChild++;
+        }
+        if (heapIS_BEFORE(pxHeap->pxItems[uxChild]->xItemValue, pxItem->xItemValue) == pdFALSE)
+        {
+            break;
+        }
+        heapPlace(pxHeap, pxHeap->pxItems[uxChild], uxIndex);
+        uxIndex = uxChild;
+    }
+    heapPlace(pxHeap, pxItem, uxIndex);
+}
+
+// ****************** Public Function Definitions ******************** //
+void vEDFHeapInitialise(EDFHeap_t * pxHeap, EDFHeapItem_t ** pxStorage, UBaseType_t uxCapacity)
+{
+    pxHeap->pxItems = pxStorage;
+    pxHeap->uxNumberOfItems = 0;
+    pxHeap->uxCapacity = uxCapacity;
+}
+
+void vEDFHeapInitialiseItem(EDFHeapItem_t * pxItem)
+{
+    pxItem->pxContainer = NULL;
+    pxItem->uxIndex = 0;
+}
+
+void vEDFHeapInsert(EDFHeap_t * pxHeap, EDFHeapItem_t * pxItem)
+{
+    configASSERT(pxItem->pxContainer == NULL);
+    configASSERT(pxHeap->uxNumberOfItems < pxHeap->uxCapacity);
+
+    pxItem->pxContainer = pxHeap;
+    heapPlace(pxHeap, pxItem, pxHeap->uxNumberOfItems);
+    pxHeap->uxNumberOfItems++;
+    heapSiftUp(pxHeap, pxItem->uxIndex);
+}
+
+UBaseType_t uxEDFHeapRemove(EDFHeapItem_t * pxItem)
+{
+    // removing an item that is not in a heap is allowed, same as calling uxListRemove on a fresh item
+    EDFHeap_t * pxHeap = pxItem->pxContainer;
+    EDFHeapItem_t * pxLast;
+    UBaseType_t uxIndex;
+
+    if (pxHeap == NULL)
+    {
+        return 0;
+    }
+
+    uxIndex = pxItem->uxIndex;
+    pxHeap->uxNumberOfItems--;
+    pxItem->pxContainer = NULL;
+
+    if (uxIndex != pxHeap->uxNumberOfItems)
+    {
+        // move the last item into the hole and restore the heap property in whichever direction is needed
+        pxLast = pxHeap->pxItems[pxHeap->uxNumberOfItems];
+        heapPlace(pxHeap, pxLast, uxIndex);
+        if ((uxIndex > 0) && (heapIS_BEFORE(pxLast->xItemValue, pxHeap->pxItems[(uxIndex - 1) >> 1]->xItemValue) == pdTRUE))
+        {
+            heapSiftUp(pxHeap, uxIndex);
+        }
+        else
+        {
+            heapSiftDown(pxHeap, uxIndex);
+        }
+    }
+
+    return pxHeap->uxNumberOfItems;
+}
+
+void vEDFHeapUpdateValue(EDFHeapItem_t * pxItem, TickType_t xNewValue)
+{
+    EDFHeap_t * pxHeap = pxItem->pxContainer;
+    TickType_t xOldValue = pxItem->xItemValue;
+
+    pxItem->xItemValue = xNewValue;
+    if (pxHeap == NULL)
+    {
+        return;
+    }
+
+    if (heapIS_BEFORE(xNewValue, xOldValue) == pdTRUE)
+    {
+        heapSiftUp(pxHeap, pxItem->uxIndex);
+    }
+    else
+    {
+        heapSiftDown(pxHeap, pxItem->uxIndex);
+    }
+}
+// ******************************************************************* //
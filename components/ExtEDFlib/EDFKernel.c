@@ -0,0 +1,79 @@
+// ************************* File Includes *************************** //
+#include "EDFKernel.h"
+#include "ExtEDFlib.h"
+// ******************************************************************* //
+
+#if configUSE_EDF == 1
+// ******************* Private Function Declarations ***************** //
+static extTCB_t * prvKernelTCB(ListItem_t * pxItem);
+// ******************************************************************* //
+
+static extTCB_t * prvKernelTCB(ListItem_t * pxItem)
+{
+    // the owner of the state list item of a task is its TCB, i.e. its handle
+    return (extTCB_t *)pvTaskGetThreadLocalStoragePointer((TaskHandle_t)listGET_LIST_ITEM_OWNER(pxItem), LOCAL_STORAGE_INDEX);
+}
+
+BaseType_t xEDFKernelPlaceReadyTask(List_t * pxReadyList, ListItem_t * pxItem, TaskHandle_t xCurrentTask)
+{
+    extTCB_t * xTCB = prvKernelTCB(pxItem);
+    extTCB_t * xCurrentTCB;
+    ListItem_t * pxNext;
+
+    if (xTCB == NULL)
+    {
+        pxReadyList->pxIndex = (ListItem_t *)listGET_END_MARKER(pxReadyList);
+        return pdFALSE;
+    }
+
+    if (xTCB->status == TASK_BLOCKED)
+    {
+        // made ready by the release of its next job, a preempted task is placed again without one
+        xTCB->status = TASK_READY;
+        EDF_TRACE_RELEASE_EVENT(xTCB->xTaskNumber, xTCB->absDeadline);
+    }
+
+    // in front of the first later deadline, behind the equal ones
+    listSET_LIST_ITEM_VALUE(pxItem, xTCB->absDeadline);
+    for (pxNext = listGET_HEAD_ENTRY(pxReadyList); pxNext != listGET_END_MARKER(pxReadyList); pxNext = listGET_NEXT(pxNext))
+    {
+        if (heapIS_BEFORE(xTCB->absDeadline, listGET_LIST_ITEM_VALUE(pxNext)) == pdTRUE)
+        {
+            break;
+        }
+    }
+    pxReadyList->pxIndex = pxNext;
+
+    if ((xCurrentTask == NULL) || (xCurrentTask == (TaskHandle_t)listGET_LIST_ITEM_OWNER(pxItem)))
+    {
+        return pdFALSE;
+    }
+    // a task below the EDF priority is preempted by the kernel already, other tasks have no extended TCB
+    xCurrentTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xCurrentTask, LOCAL_STORAGE_INDEX);
+    return ((xCurrentTCB != NULL) && (xCurrentTCB->xPriority == configEDF_PRIORITY)) ? heapIS_BEFORE(xTCB->absDeadline, xCurrentTCB->absDeadline) : pdFALSE;
+}
+
+void vEDFKernelSelectEarliest(List_t * pxReadyList, ListItem_t * pxCurrentItem)
+{
+    extTCB_t * xTCB;
+    ListItem_t * pxNext;
+
+    if (listIS_CONTAINED_WITHIN(pxReadyList, pxCurrentItem) == pdTRUE)
+    {
+        // still ready, its deadline moved on if its job completed after the next release and it did not block
+        xTCB = prvKernelTCB(pxCurrentItem);
+        pxNext = listGET_NEXT(pxCurrentItem);
+        if ((xTCB != NULL) && (pxNext != listGET_END_MARKER(pxReadyList)) && (heapIS_BEFORE(listGET_LIST_ITEM_VALUE(pxNext), xTCB->absDeadline) == pdTRUE))
+        {
+            (void)uxListRemove(pxCurrentItem);
+            (void)xEDFKernelPlaceReadyTask(pxReadyList, pxCurrentItem, NULL);
+            vListInsertEnd(pxReadyList, pxCurrentItem);
+        }
+        else if (xTCB != NULL)
+        {
+            listSET_LIST_ITEM_VALUE(pxCurrentItem, xTCB->absDeadline);
+        }
+    }
+    pxReadyList->pxIndex = (ListItem_t *)listGET_END_MARKER(pxReadyList);
+}
+#endif
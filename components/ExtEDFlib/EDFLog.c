@@ -0,0 +1,158 @@
+// ************************* File Includes *************************** //
+#include <stdio.h>
+
+#include "EDFLog.h"
+#include "EDFPool.h"
+#include "EDFRing.h"
+// ******************************************************************* //
+
+#if EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE
+
+// *************************** Globals ************************************ //
+static EDFLogRecord_t xLogRecords[portNUM_PROCESSORS][EDF_LOG_RING_SIZE];
+static EDFRing_t xLogRings[portNUM_PROCESSORS];
+static uint32_t ulLogDropped[portNUM_PROCESSORS];   // records lost because the ring was full
+
+static const char * const pcLogFormats[EDF_LOG_NUM_OF_EVENTS] = {
+    [EDF_LOG_JOB_START]             = "[INFO] Task %lu released at %lu, absDeadline: %lu, priority: %lu",
+    [EDF_LOG_JOB_END]               = "[INFO] Task %lu instance completed (next absDeadline: %lu) at %lu",
+    [EDF_LOG_APERIODIC_START]       = "[INFO] Aperiodic Task %lu started",
+    [EDF_LOG_APERIODIC_END]         = "[INFO] Aperiodic Task %lu completed execution",
+    [EDF_LOG_TASK_CREATED]          = "[INFO] Task %lu created with priority %lu, period: %lu, releaseTime: %lu",
+    [EDF_LOG_TASK_CREATE_FAILED]    = "[ERROR] Could not allocate memory for task %lu",
+    [EDF_LOG_SERVER_CREATED]        = "[INFO] Created Server for %lu Aperiodic Tasks",
+    [EDF_LOG_SERVER_CREATE_FAILED]  = "[ERROR] Could not allocate memory for server",
+    [EDF_LOG_SYSTEM_START]          = "[INFO] System Start Time: %lu",
+    [EDF_LOG_WCET_RESUMED]          = "[INFO] Suspended Task %lu resumed at %lu with absDeadline: %lu, period: %lu",
+    [EDF_LOG_WCET_OVERFLOW]         = "[INFO] Task %lu crossed WCET, WCET: %lu us, measured Execution Time: %lu us. NextUnblockTime: %lu with period doubled. Task Suspended",
+    [EDF_LOG_DEADLINE_MISS]         = "[INFO] Task %lu missed its deadline of %lu with current time: %lu. Task Deleted",
+    [EDF_LOG_CBS_POSTPONED]         = "[INFO] Aperiodic server budget exhausted, deadline postponed to %lu at %lu",
+    [EDF_LOG_APERIODIC_REJECTED]    = "[ERROR] Aperiodic job arriving at %lu rejected, too many jobs waiting",
+    [EDF_LOG_TASK_REMOVED]          = "[INFO] Task %lu removed, its utilization is freed after %lu",
+    [EDF_LOG_JOB_ABORTED]           = "[INFO] Job of Task %lu aborted at %lu, task restarts at %lu",
+    [EDF_LOG_JOB_EXTENDED]          = "[INFO] Job of Task %lu continues at %lu with absDeadline: %lu",
+    [EDF_LOG_TASK_ADMITTED]         = "[INFO] Task admitted on run queue %lu, periodic utilization: %lu/1000, slack: %lu",
+    [EDF_LOG_TASK_REJECTED]         = "[ERROR] Task with period %lu, relDeadline %lu, WCET %lu failed schedulability check",
+    [EDF_LOG_TASK_LIMIT]            = "[ERROR] Task with period %lu, relDeadline %lu, WCET %lu not added, too many periodic tasks",
+    [EDF_LOG_POLICY_REJECTED]       = "[ERROR] Task with period %lu, relDeadline %lu, WCET %lu not added, aborting jobs needs USE_STATIC_ALLOCATION or USE_WCET_CHECKS",
+};
+
+#if USE_LOG_DRAIN_TASK == 1
+static TaskHandle_t xLogDrainHandle = NULL;
+#endif
+// ************************************************************************ //
+
+void vEDFLogInit(void)
+{
+    for (BaseType_t xCore = 0; xCore < portNUM_PROCESSORS; xCore++)
+    {
+        vEDFRingInitialise(&xLogRings[xCore], xLogRecords[xCore], EDF_LOG_RING_SIZE, sizeof(EDFLogRecord_t));
+        ulLogDropped[xCore] = 0;
+    }
+}
+
+void vEDFLogWrite(uint32_t ulEvent, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2, uint32_t ulArg3)
+{
+    BaseType_t xCore = edfLOG_CORE_ID();
+    uint32_t ulPosition;
+    EDFLogRecord_t * pxRecord = (EDFLogRecord_t *)pvEDFRingReserve(&xLogRings[xCore], &ulPosition);
+
+    if (pxRecord == NULL)
+    {
+        __atomic_fetch_add(&ulLogDropped[xCore], 1, __ATOMIC_RELAXED);
+        return;
+    }
+    pxRecord->ulTimestamp = (uint32_t)esp_timer_get_time();
+    pxRecord->ulEvent = ulEvent;
+    pxRecord->ulArgs[0] = ulArg0;
+    pxRecord->ulArgs[1] = ulArg1;
+    pxRecord->ulArgs[2] = ulArg2;
+    pxRecord->ulArgs[3] = ulArg3;
+    vEDFRingPublish(&xLogRings[xCore], ulPosition);
+}
+
+BaseType_t xEDFLogRead(BaseType_t xCore, EDFLogRecord_t * pxRecord)
+{
+    EDFLogRecord_t * pxSlot = (EDFLogRecord_t *)pvEDFRingPeek(&xLogRings[xCore]);
+
+    if (pxSlot == NULL)
+    {
+        return pdFALSE;
+    }
+    *pxRecord = *pxSlot;
+    vEDFRingRelease(&xLogRings[xCore]);
+    return pdTRUE;
+}
+
+uint32_t ulEDFLogGetDropped(BaseType_t xCore)
+{
+    return __atomic_load_n(&ulLogDropped[xCore], __ATOMIC_RELAXED);
+}
+
+void vEDFLogPrintRecord(BaseType_t xCore, const EDFLogRecord_t * pxRecord)
+{
+    printf("%10lu us core %d: ", (unsigned long)pxRecord->ulTimestamp, (int)xCore);
+    if (pxRecord->ulEvent < EDF_LOG_NUM_OF_EVENTS)
+    {
+        printf(pcLogFormats[pxRecord->ulEvent], (unsigned long)pxRecord->ulArgs[0], (unsigned long)pxRecord->ulArgs[1],
+               (unsigned long)pxRecord->ulArgs[2], (unsigned long)pxRecord->ulArgs[3]);
+    }
+    else
+    {
+        printf("[ERROR] Unknown log event %lu", (unsigned long)pxRecord->ulEvent);
+    }
+    printf("\n");
+}
+
+void vEDFLogDrain(void)
+{
+    EDFLogRecord_t xRecord;
+    static uint32_t ulReportedDrops[portNUM_PROCESSORS];
+
+    for (BaseType_t xCore = 0; xCore < portNUM_PROCESSORS; xCore++)
+    {
+        while (xEDFLogRead(xCore, &xRecord) == pdTRUE)
+        {
+            vEDFLogPrintRecord(xCore, &xRecord);
+        }
+        if (ulEDFLogGetDropped(xCore) != ulReportedDrops[xCore])
+        {
+            ulReportedDrops[xCore] = ulEDFLogGetDropped(xCore);
+            printf("[INFO] %lu log records dropped on core %d, increase EDF_LOG_RING_SIZE\n", (unsigned long)ulReportedDrops[xCore], (int)xCore);
+        }
+    }
+}
+
+#if USE_LOG_DRAIN_TASK == 1
+static void prvLogDrainTask(void * pvParameters)
+{
+    (void) pvParameters;
+
+    for (;;)
+    {
+        vEDFLogDrain();
+        vTaskDelay(pdMS_TO_TICKS(EDF_LOG_DRAIN_PERIOD_MS));
+    }
+}
+
+void vEDFLogStartDrainTask(void)
+{
+    if (xLogDrainHandle == NULL)
+    {
+        // share the idle priority so that formatting never delays an EDF task or the aperiodic server
+        xEDFCreateSystemTask(EDF_SYSTEM_TASK_LOG_DRAIN, prvLogDrainTask, "EDF Log Drain", EDF_LOG_DRAIN_STACK, NULL, tskIDLE_PRIORITY, &xLogDrainHandle, tskNO_AFFINITY);
+    }
+}
+
+void vEDFLogStopDrainTask(void)
+{
+    if (xLogDrainHandle != NULL)
+    {
+        vTaskDelete(xLogDrainHandle);
+        xLogDrainHandle = NULL;
+    }
+    vEDFLogDrain();
+}
+#endif
+
+#endif // EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE
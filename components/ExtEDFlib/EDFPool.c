@@ -0,0 +1,174 @@
+// ************************* File Includes *************************** //
+#include "EDFPool.h"
+// ******************************************************************* //
+
+#if USE_STATIC_ALLOCATION == 1
+
+// ************************** Pool Defines *************************** //
+#if USE_TBS == 1
+// TBS jobs use extended TCBs and tasks of their own
+#define EDF_POOL_NUM_OF_TCBS                (TOTAL_NUM_OF_TASKS)
+#else
+#define EDF_POOL_NUM_OF_TCBS                (MAX_NUM_OF_PERIODIC_TASKS)
+#endif
+#if EDF_NUM_OF_CORES > 1
+// vTaskSuspendAll() only stops the scheduler of the calling core
+static portMUX_TYPE xPoolLock = portMUX_INITIALIZER_UNLOCKED;
+#define edfPOOL_LOCK()                      taskENTER_CRITICAL(&xPoolLock)
+#define edfPOOL_UNLOCK()                    taskEXIT_CRITICAL(&xPoolLock)
+#else
+#define edfPOOL_LOCK()                      vTaskSuspendAll()
+#define edfPOOL_UNLOCK()                    (void)xTaskResumeAll()
+#endif
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+/*
+The extended TCB is the first member so that a slot can be found from the TCB handed out
+*/
+typedef struct EDFTaskSlot
+{
+    extTCB_t xTCB;
+    StaticTask_t xTaskBuffer;
+    StackType_t xStack[EDF_POOL_STACK_DEPTH];
+} EDFTaskSlot_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+static EDFTaskSlot_t xTaskSlots[EDF_POOL_NUM_OF_TCBS];
+static EDFTaskSlot_t * xFreeTaskSlots[EDF_POOL_NUM_OF_TCBS];
+static UBaseType_t uxNumOfFreeTaskSlots = 0;
+
+#if USE_TBS == 0
+static extTCBA_t xTCBAPool[MAX_NUM_OF_APERIODIC_TASKS];
+static UBaseType_t uxNumOfUsedTCBAs = 0;
+#endif
+
+static StaticTask_t xSystemTaskBuffers[EDF_NUM_OF_SYSTEM_TASKS];
+static StackType_t xSystemTaskStacks[EDF_NUM_OF_SYSTEM_TASKS][EDF_SYSTEM_STACK_DEPTH];
+// ************************************************************************ //
+
+void vEDFPoolInit(void)
+{
+    for (UBaseType_t i = 0; i < EDF_POOL_NUM_OF_TCBS; i++)
+    {
+        // hand out the slots in order, so the first TCB created gets the first slot
+        xFreeTaskSlots[i] = &xTaskSlots[EDF_POOL_NUM_OF_TCBS - 1 - i];
+    }
+    uxNumOfFreeTaskSlots = EDF_POOL_NUM_OF_TCBS;
+    #if USE_TBS == 0
+    uxNumOfUsedTCBAs = 0;
+    #endif
+}
+
+extTCB_t * pxEDFAllocTCB(void)
+{
+    extTCB_t * xTCB = NULL;
+
+    edfPOOL_LOCK();
+    if (uxNumOfFreeTaskSlots > 0)
+    {
+        xTCB = &xFreeTaskSlots[--uxNumOfFreeTaskSlots]->xTCB;
+    }
+    edfPOOL_UNLOCK();
+
+    return xTCB;
+}
+
+void vEDFFreeTCB(extTCB_t * xTCB)
+{
+    edfPOOL_LOCK();
+    xFreeTaskSlots[uxNumOfFreeTaskSlots++] = (EDFTaskSlot_t *)xTCB;
+    edfPOOL_UNLOCK();
+}
+
+#if USE_TBS == 0
+extTCBA_t * pxEDFAllocTCBA(void)
+{
+    extTCBA_t * xTCBA = NULL;
+
+    // aperiodic TCBs are never released, the server runs every aperiodic task once
+    edfPOOL_LOCK();
+    if (uxNumOfUsedTCBAs < MAX_NUM_OF_APERIODIC_TASKS)
+    {
+        xTCBA = &xTCBAPool[uxNumOfUsedTCBAs++];
+    }
+    edfPOOL_UNLOCK();
+
+    return xTCBA;
+}
+#endif
+
+BaseType_t xEDFCreateTask(extTCB_t * xTCB, TaskFunction_t pxTaskCode, const char * const pcName, uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    EDFTaskSlot_t * pxSlot = (EDFTaskSlot_t *)xTCB;
+
+    configASSERT(ulStackDepth <= EDF_POOL_STACK_DEPTH);
+    #if EDF_NUM_OF_CORES > 1
+    *pxCreatedTask = xTaskCreateStaticPinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxSlot->xStack, &pxSlot->xTaskBuffer, edfTASK_AFFINITY(xTCB));
+    #else
+    *pxCreatedTask = xTaskCreateStatic(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxSlot->xStack, &pxSlot->xTaskBuffer);
+    #endif
+
+    return (*pxCreatedTask != NULL) ? pdPASS : errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+}
+
+BaseType_t xEDFCreateSystemTask(EDFSystemTask_t xSystemTask, TaskFunction_t pxTaskCode, const char * const pcName, uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, BaseType_t xCoreID)
+{
+    configASSERT(ulStackDepth <= EDF_SYSTEM_STACK_DEPTH);
+    #if EDF_NUM_OF_CORES > 1
+    *pxCreatedTask = xTaskCreateStaticPinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, xSystemTaskStacks[xSystemTask], &xSystemTaskBuffers[xSystemTask], xCoreID);
+    #else
+    (void)xCoreID;
+    *pxCreatedTask = xTaskCreateStatic(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, xSystemTaskStacks[xSystemTask], &xSystemTaskBuffers[xSystemTask]);
+    #endif
+
+    return (*pxCreatedTask != NULL) ? pdPASS : errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+}
+
+#else
+
+void vEDFPoolInit(void)
+{
+}
+
+extTCB_t * pxEDFAllocTCB(void)
+{
+    return (extTCB_t *)pvPortMalloc(sizeof(extTCB_t));
+}
+
+void vEDFFreeTCB(extTCB_t * xTCB)
+{
+    vPortFree(xTCB);
+}
+
+#if USE_TBS == 0
+extTCBA_t * pxEDFAllocTCBA(void)
+{
+    return (extTCBA_t *)pvPortMalloc(sizeof(extTCBA_t));
+}
+#endif
+
+BaseType_t xEDFCreateTask(extTCB_t * xTCB, TaskFunction_t pxTaskCode, const char * const pcName, uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    // only the affinity of a pinned task is taken from it
+    (void)xTCB;
+    #if EDF_NUM_OF_CORES > 1
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, edfTASK_AFFINITY(xTCB));
+    #else
+    return xTaskCreate(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask);
+    #endif
+}
+
+BaseType_t xEDFCreateSystemTask(EDFSystemTask_t xSystemTask, TaskFunction_t pxTaskCode, const char * const pcName, uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, BaseType_t xCoreID)
+{
+    (void)xSystemTask;
+    #if EDF_NUM_OF_CORES > 1
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, xCoreID);
+    #else
+    (void)xCoreID;
+    return xTaskCreate(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask);
+    #endif
+}
+
+#endif // USE_STATIC_ALLOCATION == 1
@@ -0,0 +1,78 @@
+// ************************* File Includes *************************** //
+#include "EDFRing.h"
+// ******************************************************************* //
+
+// ****************** Private Function Declarations ***************** //
+static uint32_t * ringSlot(EDFRing_t * pxRing, uint32_t ulPosition);
+// ******************************************************************* //
+// ****************** Private Functions Definitions ****************** //
+static uint32_t * ringSlot(EDFRing_t * pxRing, uint32_t ulPosition)
+{
+    // the sequence number the slot starts with
+    return (uint32_t *)&pxRing->pucSlots[(ulPosition & pxRing->ulMask) * pxRing->ulSlotSize];
+}
+// ******************************************************************* //
+
+void vEDFRingInitialise(EDFRing_t * pxRing, void * pvSlots, uint32_t ulNumOfSlots, uint32_t ulSlotSize)
+{
+    configASSERT((ulNumOfSlots & (ulNumOfSlots - 1)) == 0);
+    pxRing->pucSlots = (uint8_t *)pvSlots;
+    pxRing->ulSlotSize = ulSlotSize;
+    pxRing->ulMask = ulNumOfSlots - 1;
+    pxRing->ulHead = 0;
+    pxRing->ulTail = 0;
+    for (uint32_t i = 0; i < ulNumOfSlots; i++)
+    {
+        *ringSlot(pxRing, i) = 0;
+    }
+}
+
+void * pvEDFRingReserve(EDFRing_t * pxRing, uint32_t * pulPosition)
+{
+    uint32_t ulHead = __atomic_load_n(&pxRing->ulHead, __ATOMIC_RELAXED);
+
+    // reserve a slot, only retried when another producer reserved one in between
+    do
+    {
+        if ((ulHead - __atomic_load_n(&pxRing->ulTail, __ATOMIC_ACQUIRE)) > pxRing->ulMask)
+        {
+            return NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&pxRing->ulHead, &ulHead, ulHead + 1, pdFALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    *pulPosition = ulHead;
+    return ringSlot(pxRing, ulHead);
+}
+
+void vEDFRingPublish(EDFRing_t * pxRing, uint32_t ulPosition)
+{
+    // the consumer only reads the slot once the sequence matches
+    __atomic_store_n(ringSlot(pxRing, ulPosition), ulPosition + 1, __ATOMIC_RELEASE);
+}
+
+void * pvEDFRingPeek(EDFRing_t * pxRing)
+{
+    uint32_t * pulSlot = ringSlot(pxRing, pxRing->ulTail);
+
+    if (__atomic_load_n(pulSlot, __ATOMIC_ACQUIRE) != pxRing->ulTail + 1)
+    {
+        return NULL;
+    }
+    return pulSlot;
+}
+
+void vEDFRingRelease(EDFRing_t * pxRing)
+{
+    // only after the slot has been read
+    __atomic_store_n(&pxRing->ulTail, pxRing->ulTail + 1, __ATOMIC_RELEASE);
+}
+
+BaseType_t xEDFRingPending(EDFRing_t * pxRing)
+{
+    // a reserved but unpublished slot counts as pending, the consumer then finds it on a later look
+    if (__atomic_load_n(&pxRing->ulHead, __ATOMIC_ACQUIRE) != __atomic_load_n(&pxRing->ulTail, __ATOMIC_ACQUIRE))
+    {
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
@@ -0,0 +1,55 @@
+// ************************* File Includes *************************** //
+#include "EDFSignalQueue.h"
+#include "EDFRing.h"
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef struct EDFSignal
+{
+    uint32_t ulSequence;                    // of the ring, written last to publish the signal
+    uint32_t ulEvent;
+    void * pvTCB;
+} EDFSignal_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+static EDFSignal_t xSignals[EDF_NUM_OF_RUN_QUEUES][EDF_SIGNAL_QUEUE_SIZE];
+static EDFRing_t xSignalQueues[EDF_NUM_OF_RUN_QUEUES];
+// ************************************************************************ //
+
+void vEDFSignalQueueInit(void)
+{
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+    {
+        vEDFRingInitialise(&xSignalQueues[xCore], xSignals[xCore], EDF_SIGNAL_QUEUE_SIZE, sizeof(EDFSignal_t));
+    }
+}
+
+BaseType_t xEDFSignalSend(BaseType_t xCore, uint32_t ulEvent, void * pvTCB)
+{
+    uint32_t ulPosition;
+    EDFSignal_t * pxSignal = (EDFSignal_t *)pvEDFRingReserve(&xSignalQueues[xCore], &ulPosition);
+
+    if (pxSignal == NULL)
+    {
+        return pdFALSE;
+    }
+    pxSignal->ulEvent = ulEvent;
+    pxSignal->pvTCB = pvTCB;
+    vEDFRingPublish(&xSignalQueues[xCore], ulPosition);
+    return pdTRUE;
+}
+
+BaseType_t xEDFSignalReceive(BaseType_t xCore, uint32_t * pulEvent, void ** ppvTCB)
+{
+    EDFSignal_t * pxSignal = (EDFSignal_t *)pvEDFRingPeek(&xSignalQueues[xCore]);
+
+    if (pxSignal == NULL)
+    {
+        return pdFALSE;
+    }
+    *pulEvent = pxSignal->ulEvent;
+    *ppvTCB = pxSignal->pvTCB;
+    vEDFRingRelease(&xSignalQueues[xCore]);
+    return pdTRUE;
+}
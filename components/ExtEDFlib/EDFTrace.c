@@ -0,0 +1,246 @@
+// ************************* File Includes *************************** //
+#include "EDFTrace.h"
+#include "EDFPool.h"
+// ******************************************************************* //
+
+#if USE_EDF_TRACE == 1
+
+// ************************* Data Structures ***************************** //
+typedef struct EDFTraceBuffer
+{
+    EDFTraceBlockHeader_t xHeader;          // the records follow right behind, a block is passed to the sink as is
+    uint8_t ucRecords[EDF_TRACE_BUFFER_SIZE];
+    uint32_t ulFull;                        // set by the writer when handing the buffer over, cleared by the drain
+} EDFTraceBuffer_t;
+
+typedef struct EDFTraceStream
+{
+    EDFTraceBuffer_t xBuffers[2];
+    uint32_t ulActive;                      // buffer the core writes to
+    int64_t xLastTime;                      // time of the last record, the next delta counts from it
+    uint32_t ulSequence;                    // blocks handed over
+    uint32_t ulDropped;                     // records lost because both buffers were waiting for the drain
+    uint32_t ulFlushRequest;                // set by the drain, the next record hands over the partly filled buffer
+} EDFTraceStream_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+static EDFTraceStream_t xTraceStreams[portNUM_PROCESSORS];
+static EDFTraceSink_t xTraceSink = NULL;
+
+#if USE_TRACE_DRAIN_TASK == 1
+static TaskHandle_t xTraceDrainHandle = NULL;
+#endif
+// ************************************************************************ //
+
+// ******************* Private Function Declarations ***************** //
+static BaseType_t prvTraceHandOver(EDFTraceStream_t * pxStream);
+static uint32_t prvTraceEncode(uint8_t * pucOut, uint64_t ullValue);
+static uint32_t prvTraceTaskNumber(uint32_t ulTaskNumber);
+static void prvTraceWrite(uint32_t ulEvent, uint32_t ulTaskNumber, BaseType_t xHasArgument, uint32_t ulArgument);
+// ******************************************************************* //
+
+static BaseType_t prvTraceHandOver(EDFTraceStream_t * pxStream)
+{
+    // called by the core of the stream with its interrupts masked, fails while the drain still holds the other buffer
+    EDFTraceBuffer_t * pxFull = &pxStream->xBuffers[pxStream->ulActive];
+    EDFTraceBuffer_t * pxNext = &pxStream->xBuffers[pxStream->ulActive ^ 1];
+
+    if (__atomic_load_n(&pxNext->ulFull, __ATOMIC_ACQUIRE) != 0)
+    {
+        return pdFALSE;
+    }
+    pxFull->xHeader.ulSequence = pxStream->ulSequence++;
+    pxFull->xHeader.ulDropped = pxStream->ulDropped;
+    __atomic_store_n(&pxFull->ulFull, 1, __ATOMIC_RELEASE);
+
+    pxNext->xHeader.usLength = 0;
+    pxNext->xHeader.xBaseTime = pxStream->xLastTime;
+    pxStream->ulActive ^= 1;
+    return pdTRUE;
+}
+
+static uint32_t prvTraceEncode(uint8_t * pucOut, uint64_t ullValue)
+{
+    // unsigned LEB128, 7 bits per byte with the top bit set on all but the last
+    uint32_t ulLength = 0;
+
+    while (ullValue >= 0x80)
+    {
+        pucOut[ulLength++] = (uint8_t)(ullValue | 0x80);
+        ullValue >>= 7;
+    }
+    pucOut[ulLength++] = (uint8_t)ullValue;
+    return ulLength;
+}
+
+static uint32_t prvTraceTaskNumber(uint32_t ulTaskNumber)
+{
+    // the numbers of the library tasks depend on TOTAL_NUM_OF_TASKS, the trace uses fixed ones below TASK_NUM_START
+    if (ulTaskNumber == SCHED_TASK_NUM)
+    {
+        return EDF_TRACE_TASK_SCHEDULER;
+    }
+    if (ulTaskNumber == APERIODIC_SERVER_NUM)
+    {
+        return EDF_TRACE_TASK_SERVER;
+    }
+    return ulTaskNumber;
+}
+
+void vEDFTraceInit(void)
+{
+    int64_t xNow = edfCLOCK_US();
+
+    for (BaseType_t xCore = 0; xCore < portNUM_PROCESSORS; xCore++)
+    {
+        EDFTraceStream_t * pxStream = &xTraceStreams[xCore];
+        for (BaseType_t i = 0; i < 2; i++)
+        {
+            pxStream->xBuffers[i].xHeader.ulMagic = EDF_TRACE_MAGIC;
+            pxStream->xBuffers[i].xHeader.ucVersion = EDF_TRACE_VERSION;
+            pxStream->xBuffers[i].xHeader.ucCore = (uint8_t)xCore;
+            pxStream->xBuffers[i].xHeader.usLength = 0;
+            pxStream->xBuffers[i].xHeader.xBaseTime = xNow;
+            pxStream->xBuffers[i].ulFull = 0;
+        }
+        pxStream->ulActive = 0;
+        pxStream->xLastTime = xNow;
+        pxStream->ulSequence = 0;
+        pxStream->ulDropped = 0;
+        pxStream->ulFlushRequest = 0;
+    }
+}
+
+static void prvTraceWrite(uint32_t ulEvent, uint32_t ulTaskNumber, BaseType_t xHasArgument, uint32_t ulArgument)
+{
+    UBaseType_t uxSavedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    EDFTraceStream_t * pxStream = &xTraceStreams[edfTRACE_CORE_ID()];
+    EDFTraceBuffer_t * pxBuffer = &pxStream->xBuffers[pxStream->ulActive];
+    int64_t xNow = edfCLOCK_US();
+    int64_t xDelta = xNow - pxStream->xLastTime;
+
+    if (pxBuffer->xHeader.usLength > (EDF_TRACE_BUFFER_SIZE - EDF_TRACE_MAX_RECORD))
+    {
+        if (prvTraceHandOver(pxStream) == pdFALSE)
+        {
+            __atomic_store_n(&pxStream->ulDropped, pxStream->ulDropped + 1, __ATOMIC_RELAXED);
+            portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedMask);
+            return;
+        }
+        pxBuffer = &pxStream->xBuffers[pxStream->ulActive];
+    }
+    else if ((__atomic_load_n(&pxStream->ulFlushRequest, __ATOMIC_RELAXED) != 0) && (pxBuffer->xHeader.usLength > 0))
+    {
+        // the drain came by, the records so far go out with its next run if the other buffer is free
+        if (prvTraceHandOver(pxStream) == pdTRUE)
+        {
+            pxBuffer = &pxStream->xBuffers[pxStream->ulActive];
+        }
+    }
+    __atomic_store_n(&pxStream->ulFlushRequest, 0, __ATOMIC_RELAXED);
+
+    pxBuffer->xHeader.usLength += prvTraceEncode(&pxBuffer->ucRecords[pxBuffer->xHeader.usLength], ((uint64_t)((xDelta > 0) ? xDelta : 0) << EDF_TRACE_EVENT_BITS) | ulEvent);
+    pxBuffer->xHeader.usLength += prvTraceEncode(&pxBuffer->ucRecords[pxBuffer->xHeader.usLength], prvTraceTaskNumber(ulTaskNumber));
+    if (xHasArgument == pdTRUE)
+    {
+        pxBuffer->xHeader.usLength += prvTraceEncode(&pxBuffer->ucRecords[pxBuffer->xHeader.usLength], ulArgument);
+    }
+    pxStream->xLastTime = xNow;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedMask);
+}
+
+void vEDFTraceWrite(uint32_t ulEvent, uint32_t ulTaskNumber)
+{
+    prvTraceWrite(ulEvent, ulTaskNumber, pdFALSE, 0);
+}
+
+void vEDFTraceWriteRelease(uint32_t ulTaskNumber, TickType_t xDeadline)
+{
+    // ticks to us, so readers get the slack and the release jitter without knowing the tick of the record
+    long int lTicksLeft = (long int)xDeadline - (long int)xTaskGetTickCountFromISR();
+    prvTraceWrite(EDF_TRACE_RELEASE, ulTaskNumber, pdTRUE, (lTicksLeft > 0) ? (uint32_t)edfTICKS_TO_US(lTicksLeft) : 0);
+}
+
+void vEDFTraceSetSink(EDFTraceSink_t xSink)
+{
+    __atomic_store_n(&xTraceSink, xSink, __ATOMIC_RELEASE);
+}
+
+uint32_t ulEDFTraceGetDropped(BaseType_t xCore)
+{
+    return __atomic_load_n(&xTraceStreams[xCore].ulDropped, __ATOMIC_RELAXED);
+}
+
+void vEDFTraceDrain(void)
+{
+    // single reader, a full buffer is not written to until it is cleared here
+    EDFTraceSink_t xSink = __atomic_load_n(&xTraceSink, __ATOMIC_ACQUIRE);
+
+    for (BaseType_t xCore = 0; xCore < portNUM_PROCESSORS; xCore++)
+    {
+        EDFTraceStream_t * pxStream = &xTraceStreams[xCore];
+        for (BaseType_t i = 0; i < 2; i++)
+        {
+            EDFTraceBuffer_t * pxBuffer = &pxStream->xBuffers[i];
+            if (__atomic_load_n(&pxBuffer->ulFull, __ATOMIC_ACQUIRE) != 0)
+            {
+                if (xSink != NULL)
+                {
+                    xSink(&pxBuffer->xHeader, sizeof(EDFTraceBlockHeader_t) + pxBuffer->xHeader.usLength);
+                }
+                __atomic_store_n(&pxBuffer->ulFull, 0, __ATOMIC_RELEASE);
+            }
+        }
+        __atomic_store_n(&pxStream->ulFlushRequest, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void vEDFTraceFlush(void)
+{
+    UBaseType_t uxSavedMask;
+    EDFTraceStream_t * pxStream;
+
+    // frees the other buffer first, the one being written can then always be handed over
+    vEDFTraceDrain();
+    uxSavedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    pxStream = &xTraceStreams[edfTRACE_CORE_ID()];
+    if (pxStream->xBuffers[pxStream->ulActive].xHeader.usLength > 0)
+    {
+        (void)prvTraceHandOver(pxStream);
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedMask);
+    vEDFTraceDrain();
+}
+
+#if USE_TRACE_DRAIN_TASK == 1
+static void prvTraceDrainTask(void * pvParameters)
+{
+    for (;;)
+    {
+        vEDFTraceDrain();
+        vTaskDelay(pdMS_TO_TICKS(EDF_TRACE_DRAIN_PERIOD_MS));
+    }
+}
+
+void vEDFTraceStartDrainTask(void)
+{
+    if (xTraceDrainHandle == NULL)
+    {
+        // share the idle priority, a slow sink never delays an EDF task
+        xEDFCreateSystemTask(EDF_SYSTEM_TASK_TRACE_DRAIN, prvTraceDrainTask, "EDF Trace Drain", EDF_TRACE_DRAIN_STACK, NULL, tskIDLE_PRIORITY, &xTraceDrainHandle, tskNO_AFFINITY);
+    }
+}
+
+void vEDFTraceStopDrainTask(void)
+{
+    if (xTraceDrainHandle != NULL)
+    {
+        vTaskDelete(xTraceDrainHandle);
+        xTraceDrainHandle = NULL;
+    }
+    vEDFTraceFlush();
+}
+#endif
+
+#endif // USE_EDF_TRACE == 1
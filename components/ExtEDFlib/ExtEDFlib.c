@@ -1,66 +1,213 @@
 // ************************* File Includes *************************** // 
 #include "ExtEDFlib.h"
+#include "EDFPool.h"
 // ******************************************************************* //
-// *************************** Globals ************************************ //
-/*
-Some of these variables and arrays are externed to the trace macros
-*/
-
-#ifdef TRACE_CONFIG
-int task_nums[TRACE_ARRAY_SIZE][TRACE_ARRAY_WIDTH];
-int trcIndex = 0;
-#endif
 
-#ifdef ESP_TRACE_CONFIG
-esp_timer_handle_t traceTimer;
-int64_t eventArray[MAX_NUM_OF_EVENTS][3];
-int64_t eventIndex = 0;
-void espTimerCallback(void *arg)  {return;}
-void vApplicationIdleHook(void) {return;}
-#endif
+// ************************* Data Structures ***************************** //
+// Admission state of a periodic task number, a removed task stays admitted until the deadline of its last job
+typedef enum EDFRecordState
+{
+    EDF_RECORD_FREE = 0,
+    EDF_RECORD_IN_USE,
+    EDF_RECORD_REMOVING,                    // removal requested, the scheduler of the core has not deleted the task yet
+    EDF_RECORD_RETIRING                     // deleted, admitted until xLastDeadline
+} EDFRecordState_t;
 
+typedef struct EDFTaskRecord
+{
+    TickType_t WCET;
+    TickType_t period;
+    TickType_t relDeadline;
+    TickType_t xLastDeadline;
+    BaseType_t xCoreID;
+    EDFRecordState_t xState;                // RETIRING is published by the scheduler, all other changes are made by the API
+} EDFTaskRecord_t;
+// *********************************************************************** //
+// *************************** Globals ************************************ //
 // ******************* Extended EDF Variables *********************** //
 // Task Lists
 // Initial Lists
 
-// Final Ready, Blocked and Suspended Lists
-static List_t xTCBReadyListVar;
-static List_t xTCBBlockedListVar;
-static List_t xTCBSuspendedListVar;
-static List_t xTCBAperiodicListVar;
-static List_t xTCBInitListVar;
-
-static List_t * xTCBReadyList = &xTCBReadyListVar;
-static List_t * xTCBBlockedList = &xTCBBlockedListVar;
-static List_t * xTCBSuspendedList = &xTCBSuspendedListVar;
-static List_t * xTCBAperiodicList = &xTCBAperiodicListVar;
-static List_t * xTCBInitList = &xTCBInitListVar;
-
-// Current and previous Task handles, used to control priorities
-static extTCB_t * xTCBToBlock;
-static extTCB_t * xTCBToSuspend;
-static extTCB_t * xTCBToReady;
-static extTCB_t * firstTaskToExecute;
+// Final Ready and Blocked Lists
+// Deadline ordered heaps, a task is in at most one of them at any time, and only in those of the core it is pinned to.
+// Tasks suspended by the application wait in the blocked heap
+static EDFHeap_t xTCBReadyList[EDF_NUM_OF_RUN_QUEUES];
+static EDFHeap_t xTCBBlockedList[EDF_NUM_OF_RUN_QUEUES];
+static EDFHeap_t xTCBInitList[EDF_NUM_OF_RUN_QUEUES];
+
+static EDFHeapItem_t * xTCBReadyListStorage[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
+static EDFHeapItem_t * xTCBBlockedListStorage[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
+static EDFHeapItem_t * xTCBInitListStorage[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
 
 #if USE_WCET_CHECKS == 1
-static extTCB_t * xTCBWCETOverflow;
-#endif 
+// Timer queue of the tasks suspended for a WCET overflow, ordered on nextUnblockTime, its head is the next WCET wakeup
+static EDFHeap_t xTCBWCETWakeList[EDF_NUM_OF_RUN_QUEUES];
+static EDFHeapItem_t * xTCBWCETWakeListStorage[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
+#endif
 
 #if USE_DEADLINE_CHECKS == 1
-static extTCB_t * xTCBDeadlineOverflow;
+// Deadline index of the pending jobs (released, not completed) of every run queue, ordered on absDeadline. A job joins
+// it when it is made ready and leaves it when it completes, so the head is the next deadline that can be missed.
+// The tick hook reads it from interrupt context, so it has its own lock, also on a single core
+static EDFHeap_t xTCBDeadlineList[EDF_NUM_OF_RUN_QUEUES];
+static EDFHeapItem_t * xTCBDeadlineListStorage[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
+static portMUX_TYPE xDeadlineLocks[EDF_NUM_OF_RUN_QUEUES] = {[0 ... (EDF_NUM_OF_RUN_QUEUES - 1)] = portMUX_INITIALIZER_UNLOCKED};
+#define edfINIT_DEADLINE_ITEM(xTCB)         do { vEDFHeapInitialiseItem(&(xTCB)->xDeadlineHeapItem); heapSET_ITEM_OWNER(&(xTCB)->xDeadlineHeapItem, (xTCB)); } while (0)
+#define edfWATCH_DEADLINE(xTCB)             EDFWatchDeadline(xTCB)
+#define edfUNWATCH_DEADLINE(xTCB)           EDFUnwatchDeadline(xTCB)
+#else
+#define edfINIT_DEADLINE_ITEM(xTCB)
+#define edfWATCH_DEADLINE(xTCB)
+#define edfUNWATCH_DEADLINE(xTCB)
+#endif
+
+#if USE_EDF_TASK_STATS == 1
+// EDF tasks switched in on every core, a job switched out is preempted if the count of its core moves on before it runs
+// again. The statistics are written without a lock, the counters that the checks of other cores update atomically
+static uint32_t ulStatsSwitchIns[EDF_NUM_OF_CORES] = {0};
+#define edfINIT_STATS(xTCB)                 do { memset(&(xTCB)->xStats, 0, sizeof(EDFTaskStats_t)); (xTCB)->xJobRunning = pdFALSE; (xTCB)->xSwitchedOutCore = -1; } while (0)
+#define edfSTATS_JOB_START(xTCB)            EDFStatsJobStart(xTCB)
+#define edfSTATS_JOB_END(xTCB, xMissed)     EDFStatsJobEnd((xTCB), (xMissed))
+#define edfSTATS_COUNT(xTCB, xCounter)      ((void)__atomic_fetch_add(&(xTCB)->xStats.xCounter, 1, __ATOMIC_RELAXED))
+#else
+#define edfINIT_STATS(xTCB)
+#define edfSTATS_JOB_START(xTCB)
+#define edfSTATS_JOB_END(xTCB, xMissed)
+#define edfSTATS_COUNT(xTCB, xCounter)
+#endif
+
+#if EDF_NUM_OF_CORES > 1
+// The hooks of a task can run on another core than its scheduler (the tick of core 0 unblocks the tasks of every core),
+// the heaps of a core are only changed with its lock held, and no kernel function is called with the lock held
+static portMUX_TYPE xCoreLocks[EDF_NUM_OF_RUN_QUEUES] = {[0 ... (EDF_NUM_OF_RUN_QUEUES - 1)] = portMUX_INITIALIZER_UNLOCKED};
+#define edfENTER_CORE_CRITICAL(xCore)       portENTER_CRITICAL_SAFE(&xCoreLocks[xCore])
+#define edfEXIT_CORE_CRITICAL(xCore)        portEXIT_CRITICAL_SAFE(&xCoreLocks[xCore])
+#else
+#define edfENTER_CORE_CRITICAL(xCore)
+#define edfEXIT_CORE_CRITICAL(xCore)
+#endif
+
+#if (USE_STATIC_ALLOCATION == 1) || (USE_WCET_CHECKS == 1)
+#define edfPOLICY_SUPPORTED(xPolicy)        (pdTRUE)
+#else
+// an aborted job restarts its task in its pool buffers (EDFRestartTask) or waits for its next release in the wake
+// queue of the WCET checks (EDFSuspendAbortedJob), an (m,k)-firm job that cannot be aborted finishes late
+#define edfPOLICY_SUPPORTED(xPolicy)        (((xPolicy) != EDF_POLICY_ABORT_JOB) ? pdTRUE : pdFALSE)
+#endif
+#define edfTASK_POLICY_SUPPORTED(pxPolicy)  (((pxPolicy) == NULL) || ((edfPOLICY_SUPPORTED((pxPolicy)->xOverrunPolicy) == pdTRUE) && \
+                                                                      (edfPOLICY_SUPPORTED((pxPolicy)->xMissPolicy) == pdTRUE)))
+
+#if EDF_NUM_OF_RUN_QUEUES > 1
+// Tasks created before EDFStartScheduling(), placed on the cores when scheduling starts
+static extTCB_t * xTCBsToPlace[TOTAL_NUM_OF_TASKS];
+static UBaseType_t uxNumOfTCBsToPlace = 0;
+// Core a is tried before core b (EDF_PARTITION_FIT): most utilized first for best fit, least utilized for worst fit
+#if EDF_PARTITION_FIT == EDF_BEST_FIT
+#define edfFIT_BEFORE(a, b)                 (Up_accepted[a] > Up_accepted[b])
+#elif EDF_PARTITION_FIT == EDF_WORST_FIT
+#define edfFIT_BEFORE(a, b)                 (Up_accepted[a] < Up_accepted[b])
+#else
+#define edfFIT_BEFORE(a, b)                 (pdFALSE)
+#endif
+#endif
+
+#if USE_GLOBAL_EDF == 1
+// Jobs the global scheduler has given a core to (DISPATCHED_TASK_PRIO or RUNNING_TASK_PRIO), at most one per core
+static extTCB_t * xGlobalRunningTasks[EDF_NUM_OF_CORES];
+static UBaseType_t uxNumOfGlobalRunningTasks = 0;
+// Deleted tasks that still ran on a core, their TCBs are freed by the first pass after the task was switched out
+static extTCB_t * xDeletedRunningTasks[TOTAL_NUM_OF_TASKS];
+static UBaseType_t uxNumOfDeletedRunningTasks = 0;
+#endif
+#if USE_GLOBAL_EDF_US == 1
+// Ready queue order, the jobs of heavy tasks (EDF-US) come before every deadline. Their keys move a quarter of the tick
+// range ahead of their deadlines, so they stay earlier than the keys of the other pending jobs across a tick overflow
+#define edfTOP_PRIORITY_LEAD                ((TickType_t)(portMAX_DELAY >> 2))
+#define edfREADY_KEY(xTCB)                  (((xTCB)->xTopPriority == pdTRUE) ? ((xTCB)->absDeadline - edfTOP_PRIORITY_LEAD) : (xTCB)->absDeadline)
+#else
+#define edfREADY_KEY(xTCB)                  ((xTCB)->absDeadline)
+#endif
+
+// Jobs the WCET and deadline checks apply to, with USE_WCET_CHECKS_TBS or USE_DEADLINE_CHECKS_TBS set only the periodic ones
+#if USE_TBS == 1 & USE_WCET_CHECKS_TBS == 1
+#define edfWCET_CHECKED(xTCB)               (((xTCB)->status == TASK_RUNNING) & ((xTCB)->WCETExceeded == pdFALSE) & ((xTCB)->isPeriodic == pdTRUE))
+#else
+#define edfWCET_CHECKED(xTCB)               (((xTCB)->status == TASK_RUNNING) & ((xTCB)->WCETExceeded == pdFALSE))
+#endif
+// Deadlines are watched for every pending job, not only the running one, the CBS server only has a server deadline
+#if USE_TBS == 1 & USE_DEADLINE_CHECKS_TBS == 1
+#define edfDEADLINE_CHECKED(xTCB)           (((xTCB)->deadlineExceeded == pdFALSE) & ((xTCB)->isPeriodic == pdTRUE))
+#elif USE_CBS == 1
+#define edfDEADLINE_CHECKED(xTCB)           (((xTCB)->deadlineExceeded == pdFALSE) & ((xTCB) != &xCBSServerTCB))
+#else
+#define edfDEADLINE_CHECKED(xTCB)           ((xTCB)->deadlineExceeded == pdFALSE)
 #endif
 
-// Library Task Handles
+#if EDF_SIGNAL_QUEUE_SIZE < (2 * (TOTAL_NUM_OF_TASKS))
+#error "EDF_SIGNAL_QUEUE_SIZE must be at least twice the number of tasks"
+#endif
+
+#if USE_SRP == 1
+// Resources locked on every core, the last one locked first, and the system ceiling, the shortest ceiling among them.
+// A job that has not started yet only runs if its relative deadline is shorter. xSRPHeldBack is set by the scheduler
+// when it held a job back, the next unlock then wakes it
+static EDFResource_t * pxSRPLocked[EDF_NUM_OF_RUN_QUEUES] = {NULL};
+static TickType_t xSystemCeiling[EDF_NUM_OF_RUN_QUEUES] = {[0 ... (EDF_NUM_OF_RUN_QUEUES - 1)] = portMAX_DELAY};
+static BaseType_t xSRPHeldBack[EDF_NUM_OF_RUN_QUEUES] = {pdFALSE};
+#define edfSRP_MAY_RUN(xCore, xTCB)         (((xTCB)->xJobStarted == pdTRUE) | ((xTCB)->relDeadline < xSystemCeiling[xCore]))
+#endif
+
+#if configUSE_EDF == 0
+// First task to run on every core, handed to the scheduler, the other requests are passed through the signal queue
+static extTCB_t * firstTaskToExecute[EDF_NUM_OF_RUN_QUEUES];
+// Task each scheduler has given its core to (partitioned EDF), kept across the passes
+static extTCB_t * currentRunningTaskOfCore[EDF_NUM_OF_RUN_QUEUES];
+#endif
+
+#if USE_EDF_TICKLESS == 1
+// One shot timer of every run queue, armed after each pass for the next event the tick hook would otherwise poll for
+static esp_timer_handle_t xEventTimer[EDF_NUM_OF_RUN_QUEUES];
+#endif
+
+// Library Task Handles, one scheduler per core, all of them are created and deleted together
 static TaskHandle_t EDFGenHandle = NULL;
-static TaskHandle_t EDFSchedulerHandle = NULL;
+#if (USE_EDF_INLINE_DISPATCH == 0) || (USE_EDF_TICKLESS == 0)
+static TaskHandle_t EDFSchedulerHandle[EDF_NUM_OF_RUN_QUEUES] = {NULL};
+#endif
+#if (USE_TBS == 0) || (USE_EDF_TICKLESS == 0)
 static TaskHandle_t EDFAperiodicServerHandle = NULL;
+#endif
+#if configUSE_EDF == 1
+// No scheduler task, the kernel selects the earliest deadline (EDFKernel.h)
+#define edfSCHEDULER_CREATED(xCore)         (pdFALSE)
+#elif USE_EDF_INLINE_DISPATCH == 1
+// No scheduler task, the tasks dispatch themselves. Events of the pass pended on the timer service task, 0 while none is
+#define edfSCHEDULER_CREATED(xCore)         (pdTRUE)
+static uint32_t ulDeferredEvents[EDF_NUM_OF_RUN_QUEUES] = {0};
+#else
+#define edfSCHEDULER_CREATED(xCore)         (EDFSchedulerHandle[xCore] != NULL)
+#endif
 
+// next declared aperiodic job to arrive
+BaseType_t aperiodicJobPointer = 0;
 #if USE_TBS == 0
 static extTCBA_t * aperiodicTCBQueue[MAX_NUM_OF_APERIODIC_TASKS];
-// Aperiodic Server 
-BaseType_t aperiodicJobPointer = 0;
+#if USE_CBS == 1
+// Constant Bandwidth Server: scheduled like an EDF task with the server deadline as absDeadline, and the budget left
+// in this server period, xCBSBudget is only changed with the lock of the run queue of the server held. The budget is
+// kept in us, what the server has used of it is its measuredExecTime
+static extTCB_t xCBSServerTCB;
+static int64_t xCBSBudget = 0;
+#endif
 #else
-static TickType_t d_k = 0;
+static TickType_t d_k[EDF_NUM_OF_RUN_QUEUES] = {0};
+// declared jobs, moved to the arrival queue by the tick hook when they arrive
+static EDFAperiodicJob_t xTBSDeclaredJobs[MAX_NUM_OF_APERIODIC_TASKS];
+// idle workers of every core, taken by the scheduler of run queue 0 and returned by the scheduler of the worker's core
+static extTCB_t * xTBSIdleWorkers[EDF_NUM_OF_RUN_QUEUES][EDF_TBS_NUM_OF_WORKERS];
+static UBaseType_t uxNumOfTBSIdleWorkers[EDF_NUM_OF_RUN_QUEUES] = {0};
+// names of the workers, the extended TCB only points to its name
+static char pcTBSWorkerNames[EDF_NUM_OF_RUN_QUEUES][EDF_TBS_NUM_OF_WORKERS][configMAX_TASK_NAME_LEN];
 #endif
 
 // System Start Time
@@ -70,76 +217,157 @@ static BaseType_t xNoOfPeriodicTasks = 0;
 static BaseType_t xNoOfAperiodicTasks = 0;
 //
 static BaseType_t startEDF = pdFALSE;
-// For resuming suspended tasks
-static TickType_t EarliestSchedWakeUp = 0;
-
-// periodic scheduler wake up frequency in ticks
-// to check for timing errors
-static TickType_t schedulerWakeUpFreq = 10;
-static TickType_t schedulerSleepCount = 0;
+#if USE_WCET_CHECKS == 1
+// For resuming suspended tasks, head of xTCBWCETWakeList or 0 if none is due, set by the scheduler, cleared once due
+static TickType_t EarliestSchedWakeUp[EDF_NUM_OF_RUN_QUEUES] = {0};
+#endif
 
 // ******************************************************************** //
 
-// Stats
-static float pUtilizationFactor = 0.0f;
-static float apUtilizationFactor = 0.0f;
-static unsigned int periodicCount = 0;
-static unsigned int aperiodicCount = 0;
-static unsigned int schedulerCount = 0;
-static unsigned int idleCount = 0;
-static unsigned int totalCount = 0;
-// Utilization Factor based on WCET
-static float Up_accepted = 0.0f;
+// Utilization Factor based on WCET, per core
+static EDFUtilization_t Up_accepted[EDF_NUM_OF_RUN_QUEUES] = {0};
+// Periodic task numbers (minus TASK_NUM_START) in use, or still admitted after their task was removed
+static EDFTaskRecord_t xTaskRecords[MAX_NUM_OF_PERIODIC_TASKS];
+// Tasks added to a core are released at this tick at the earliest, once the removed tasks whose utilization they
+// took have no job left
+static TickType_t xSafeReleaseTime[EDF_NUM_OF_RUN_QUEUES] = {0};
 // *********************************************************************** //
 
 // ******************* Private Function Declarations ***************** //
 static void generatorTaskEDF(void *pvParameters);
 static void addTCBToList(extTCB_t * xTCB);
-#if USE_TBS == 0
-static void addTCBAToList(extTCBA_t * xTCBA);
-#else
-static void addTBSTCBToList(extTCB_t * xTCB);
+#if USE_TBS == 1
+static TickType_t EDFTBSDeadline(BaseType_t xCore, TickType_t releaseTime, TickType_t WCET);
+static void EDFTBSCreateWorkers();
+static void EDFTBSWorker(void *pvParameters);
+static void EDFTBSReleaseDeclaredJobs();
 #endif
 static void deleteTCBFromList(extTCB_t * xTCB);
-static void swapLists(List_t ** aTCBList, List_t ** bTCBList);
+#if USE_TBS == 1
 static BaseType_t max(TickType_t r, TickType_t d);
+#endif
 
 // EDF Scheduler Functions
+#if configUSE_EDF == 0
 static void EDFSchedulerInit();
-static float EDFSchedulabilityCheck(TickType_t period, TickType_t WCET);
+#endif
+static BaseType_t EDFSchedulabilityCheck(BaseType_t xCore, TickType_t period, TickType_t relDeadline, TickType_t WCET, TickType_t * slack);
+static void EDFReleaseUtilization(BaseType_t xCore, TickType_t period, TickType_t relDeadline, TickType_t WCET);
+static BaseType_t EDFAdmitTask(TickType_t period, TickType_t relDeadline, TickType_t WCET, BaseType_t xRetire);
+static UBaseType_t EDFRetireRemovedTasks(BaseType_t xCore, BaseType_t xForce);
+static BaseType_t EDFAdmitsAfterRetiring(BaseType_t xCore, TickType_t period, TickType_t relDeadline, TickType_t WCET);
+static BaseType_t EDFRetainUtilization(extTCB_t * xTCB);
+static void EDFDeleteTask(BaseType_t xCore, extTCB_t * xTCB);
+static extTCB_t * EDFNewPeriodicTCB(const char* taskName, int stackSize, void (*instanceFunc)(void*), TickType_t period, TickType_t relDeadline, TickType_t phase, void *instanceParams, TickType_t WCET, BaseType_t xTaskNumber, const EDFTaskPolicy_t * pxPolicy);
+#if configUSE_EDF == 0
+static void EDFReleaseDueJob(extTCB_t * xTCB);
+#endif
+#if USE_WCET_CHECKS == 1 || USE_DEADLINE_CHECKS == 1
+static EDFJobPolicy_t EDFSelectJobPolicy(extTCB_t * xTCB, EDFJobEvent_t xEvent);
+static BaseType_t EDFApplyJobPolicy(BaseType_t xCore, extTCB_t * xTCB, EDFJobPolicy_t xPolicy, EDFJobEvent_t xEvent);
+#if USE_STATIC_ALLOCATION == 1
+static void EDFRestartTask(BaseType_t xCore, extTCB_t * xTCB, TickType_t xRelease);
+#elif USE_WCET_CHECKS == 1
+static void EDFSuspendAbortedJob(BaseType_t xCore, extTCB_t * xTCB, TickType_t xRelease);
+#endif
+#endif
+#if USE_SRP == 1
+static extTCB_t * EDFSRPEarliestTask(BaseType_t xCore);
+static void EDFSRPRelease(BaseType_t xCore, extTCB_t * xTCB, EDFResource_t * pxResource);
+#endif
+#if EDF_NUM_OF_RUN_QUEUES > 1
+static void EDFFitOrder(BaseType_t * xCores);
+static EDFUtilization_t EDFPlacementUtilization(extTCB_t * xTCB);
+static void EDFPartitionTasks();
+#endif
 static void EDFPeriodicWrapper(void *pvParameters);
+#if USE_TBS == 0
 static void EDFAperiodicServer(void *pvParameters);
-static void EDFSchedulerFunctionOpt(uint32_t events, extTCB_t ** firstTaskToRun);
+#endif
+#if configUSE_EDF == 0
+static void EDFSchedulerPass(BaseType_t xCore, uint32_t schedEvents);
+static void EDFSchedulerFunctionOpt(BaseType_t xCore, uint32_t events, extTCB_t ** firstTaskToRun);
+static extTCB_t * EDFTakeFirstTask(extTCB_t * currentRunningTask, extTCB_t ** firstTaskToRun);
+#endif
+#if (USE_GLOBAL_EDF == 0) && (configUSE_EDF == 0)
+static extTCB_t * EDFPreemptionDecision(BaseType_t xCore, extTCB_t * currentRunningTask);
+#endif
+#if USE_EDF_INLINE_DISPATCH == 1
+static void EDFDispatchInline(extTCB_t * xTCB, uint32_t event);
+static void EDFDeferredPass(void * pvParameter1, uint32_t ulCore);
+#endif
+#if configUSE_EDF == 1
+static BaseType_t EDFCreateKernelOrderedTask(extTCB_t * xTCB);
+#endif
 static void EDFInsertTaskToReadyList(extTCB_t * xTCB);
+static BaseType_t EDFSubmitJob(const EDFAperiodicJob_t * pxJob, BaseType_t * pxHigherPriorityTaskWoken);
 #if USE_TBS == 0
-static void EDFWakeAperiodicServer();
+static void EDFWakeAperiodicServer(BaseType_t * pxHigherPriorityTaskWoken);
+static BaseType_t EDFAperiodicJobDue();
+#else
+static void EDFTBSAdmitArrivals();
+#endif
+#if USE_CBS == 1
+static void EDFCBSInit();
+static void EDFCBSArrival(TickType_t xArrivalTime);
+static void EDFCBSConsumeBudget();
+#endif
+#if USE_GLOBAL_EDF == 1
+static UBaseType_t EDFEarliestTasks(EDFHeap_t * pxHeap, extTCB_t ** pxTasks, UBaseType_t uxMaxNumOfTasks);
+static BaseType_t EDFIsInTaskSet(extTCB_t * xTCB, extTCB_t ** pxTasks, UBaseType_t uxNumOfTasks);
+static void EDFGlobalDropStoppedTasks();
+static void EDFGlobalDispatch();
+static UBaseType_t EDFTakeSwitchedOutTasks(extTCB_t ** xTCBsToFree, UBaseType_t uxNumOfTCBsToFree);
+#endif
+#if configUSE_EDF == 0
+static UBaseType_t EDFQueueTCBToFree(extTCB_t * xTCB, extTCB_t ** xTCBsToFree, UBaseType_t uxNumOfTCBsToFree);
 #endif
-static BaseType_t EDFGetNextTaskToRun(extTCB_t ** nextTaskToRun, BaseType_t preEmptionReq);
 
 #if USE_WCET_CHECKS == 1
-static void EDFWakeSuspendedTasksDueToWCET();
+static void EDFWakeSuspendedTasksDueToWCET(BaseType_t xCore);
+static void EDFUpdateWCETWakeUp(BaseType_t xCore);
+#endif
+#if (USE_WCET_CHECKS == 1) || (USE_CBS == 1)
+static int64_t EDFExecTime(extTCB_t * xTCB, int64_t xNow);
+#endif
+#if USE_EDF_TASK_STATS == 1
+static void EDFStatsSwitchedOut(extTCB_t * xTCB);
+static void EDFStatsSwitchedIn(extTCB_t * xTCB);
+static void EDFStatsJobStart(extTCB_t * xTCB);
+static void EDFStatsJobEnd(extTCB_t * xTCB, BaseType_t xMissed);
+static UBaseType_t EDFStatsBucket(int64_t xTime);
+#endif
+static void EDFCheckRunningTask(BaseType_t xCore, extTCB_t * xTCB, int64_t xNow);
+#if USE_DEADLINE_CHECKS == 1
+static void EDFWatchDeadline(extTCB_t * xTCB);
+static void EDFUnwatchDeadline(extTCB_t * xTCB);
+static void EDFCheckDeadlines(BaseType_t xCore, TickType_t xCurTick);
+#endif
+static void EDFReleaseAperiodicJobs(BaseType_t * pxHigherPriorityTaskWoken);
+#if USE_EDF_TICKLESS == 1
+static void EDFEventTimerCallback(void * arg);
+static UBaseType_t EDFRunningTasks(BaseType_t xCore, extTCB_t ** pxTasks);
+static uint32_t EDFEventTimerExpired(BaseType_t xCore);
+static void EDFArmEventTimer(BaseType_t xCore);
 #endif
 
 // ******************************************************************* //
 // ************* Functions called from Trace Macros ****************** //
 // Not defined as static to enable call from trace macros
 // Not to be called by the user
-void EDFWakeScheduler(uint32_t event);
+void EDFWakeScheduler(BaseType_t xCore, uint32_t event);
+static void EDFNotifyScheduler(BaseType_t xCore, uint32_t event, BaseType_t * pxHigherPriorityTaskWoken);
+static void EDFSignalScheduler(uint32_t event, extTCB_t * xTCB);
 void EDFMovedTaskToReadyState(TaskHandle_t xTaskToReadyState);
 void EDFTaskSuspended(TaskHandle_t xTaskToSuspend);
 void EDFTaskBlocked();
 void EDFTaskResumed(TaskHandle_t xTaskToResume);
+void EDFTaskSwitchedOut(TaskHandle_t xTask);
+void EDFTaskSwitchedIn(TaskHandle_t xTask);
 
-#ifdef TRACE_CONFIG
-// Trace Macro Functions
-void tickTrace(BaseType_t xTickCount, BaseType_t xTaskNumber, BaseType_t xTCBNumber);
-void switchedOutTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);
-void switchedInTrace(BaseType_t xtaskNumber, BaseType_t xTCBNumber);
-#endif
-
-#ifdef ESP_TRACE_CONFIG
-void ESPSwitchedOutTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);
-void ESPSwitchedInTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);
+#if USE_EDF_TRACE == 1
+void EDFTraceSwitchedOut(BaseType_t xTaskNumber, BaseType_t xTCBNumber);
+void EDFTraceSwitchedIn(BaseType_t xTaskNumber, BaseType_t xTCBNumber);
 #endif
 // ******************************************************************* //
 // ****************** Private Functions Definitions ****************** //
@@ -155,38 +383,88 @@ static BaseType_t max(TickType_t r, TickType_t d)
 static void EDFPeriodicWrapper(void *pvParameters)
 {
     extTCB_t * curTask = (extTCB_t *)pvParameters;
-    TickType_t prevArrivalTime = xTaskGetTickCount();
+
+    #if configUSE_EDF == 0
+    if (curTask->xAddedOnline == pdTRUE)
+    {
+        // created above the EDF tasks by EDFAddPeriodicTask, suspending hands the task to the scheduler, which resumes
+        // it as ready with the deadline of its first job. It then waits here for its release if that is later
+        #if USE_GLOBAL_EDF == 1
+        // it runs already, if it is removed meanwhile its TCB is kept until it is switched out (EDFQueueTCBToFree)
+        curTask->xSwitchedInTime = edfCLOCK_US();
+        #endif
+        vTaskSetThreadLocalStoragePointer(NULL, LOCAL_STORAGE_INDEX, curTask);
+        vTaskSuspend(NULL);
+    }
+    #endif
+
+    TickType_t xIncrement;
 
     curTask->relArrivalTime = xSysStartTime;
     curTask->absDeadline = xSysStartTime + curTask->relDeadline + curTask->phase;
 
     if (curTask->phase != 0)
     {
+        #if configUSE_EDF == 1
+        // the kernel records the release when the delay makes the task ready
+        curTask->status = TASK_BLOCKED;
+        #endif
         vTaskDelayUntil(&curTask->relArrivalTime, curTask->phase);
     }
 
     for (;;)
     {
-        printf("[INFO] In Task %s with number: %d, prevArrivalTime: %ld, relArrival Time: %ld, current time: %ld, absDeadline: %ld, period: %ld, next wakeup: %ld, priority: %d\n", curTask->taskName, curTask->xTaskNumber, prevArrivalTime, curTask->relArrivalTime, xTaskGetTickCount(), curTask->absDeadline, curTask->period, curTask->relArrivalTime + curTask->period, curTask->xPriority);
+        EDF_LOG_INFO(EDF_LOG_JOB_START, curTask->xTaskNumber, curTask->relArrivalTime, curTask->absDeadline, curTask->xPriority);
+        edfSTATS_JOB_START(curTask);
 
         // Execute task function
         curTask->instanceFunc(curTask->instanceParams);
-        // Specify absolute deadline of next instance
-        curTask->absDeadline = curTask->relArrivalTime + curTask->relDeadline + curTask->period;
-        prevArrivalTime = curTask->relArrivalTime;
-
-        #if USE_TBS == 1
-        // Mark TBS Task as executed
-        if (curTask->isPeriodic == pdFALSE)
+        // the job is complete, its deadline can no longer be missed
+        edfUNWATCH_DEADLINE(curTask);
+        curTask->ulJobHistory = (curTask->ulJobHistory << 1) | ((((long int)curTask->absDeadline - (long int)xTaskGetTickCount()) >= 0) ? 1 : 0);
+        edfSTATS_JOB_END(curTask, ((curTask->ulJobHistory & 1) == 0) ? pdTRUE : pdFALSE);
+        // Specify absolute deadline of next instance, the one after it if the job took the next release
+        xIncrement = (curTask->xSkipRelease == pdTRUE) ? 2 * curTask->period : curTask->period;
+        curTask->xSkipRelease = pdFALSE;
+        curTask->absDeadline = curTask->relArrivalTime + curTask->relDeadline + xIncrement;
+
+        EDF_LOG_INFO(EDF_LOG_JOB_END, curTask->xTaskNumber, curTask->absDeadline, xTaskGetTickCount(), 0);
+        EDF_TRACE_EVENT(EDF_TRACE_BLOCK, curTask->xTaskNumber);
+        // the measured exec time is reset when the next job is released (EDFInsertTaskToReadyList)
+        curTask->xReleased = pdFALSE;
+        #if configUSE_EDF == 1
+        // the kernel queues the task on the new deadline when the release makes it ready again
+        curTask->status = TASK_BLOCKED;
+        if (xTaskDelayUntil(&curTask->relArrivalTime, xIncrement) == pdFALSE)
         {
-            curTask->executedTBSTask = pdTRUE;
+            // the job completed after the next release and the task did not block, it is put in order on the new
+            // deadline when it leaves the processor, so it gives way to any earlier job now
+            curTask->status = TASK_READY;
+            EDF_TRACE_RELEASE_EVENT(curTask->xTaskNumber, curTask->absDeadline);
+            taskYIELD();
         }
-        #endif
-        printf("[INFO] Task %s instance completed (next absDeadline: %ld) at %ld\n", curTask->taskName, curTask->absDeadline, xTaskGetTickCount());
-        vTaskDelayUntil(&curTask->relArrivalTime, curTask->period);
-
-        // reset measured exec time after waking up
+        edfENTER_CORE_CRITICAL(curTask->xCoreID);
+        curTask->status = TASK_RUNNING;
         curTask->measuredExecTime = 0;
+        if (curTask->xSwitchedInTime != edfNOT_SWITCHED_IN)
+        {
+            curTask->xSwitchedInTime = edfCLOCK_US();
+        }
+        edfEXIT_CORE_CRITICAL(curTask->xCoreID);
+        #else
+        #if USE_EDF_INLINE_DISPATCH == 1
+        EDFDispatchInline(curTask, SWITCH_ON_BLOCK);
+        #endif
+        vTaskDelayUntil(&curTask->relArrivalTime, xIncrement);
+        if (curTask->xReleased == pdFALSE)
+        {
+            // the job completed after the next release, so the task did not block and no hook has released the next job
+            EDFReleaseDueJob(curTask);
+        }
+        #if USE_EDF_INLINE_DISPATCH == 1
+        EDFDispatchInline(curTask, SWITCH_ON_READY);
+        #endif
+        #endif
     }
 }
 
@@ -194,34 +472,59 @@ static void EDFPeriodicWrapper(void *pvParameters)
 static void EDFAperiodicServer(void *pvParameters)
 {
     extTCBA_t * xTCBA;
-    TickType_t xLastWakeUpTime;
-    BaseType_t aperiodicJob = 0;
+    EDFAperiodicJob_t xJob;
+    BaseType_t xJobReceived = pdFALSE;
+
+    #if USE_CBS == 1
+    // the CBS is created above the EDF tasks once EDF has started, so it gets here at once. Suspending hands it to the
+    // scheduler, which keeps it at BLOCKED_TASK_PRIO, and the ready hook queues it with a server deadline whenever it
+    // is resumed. A job that arrives at the system start is therefore served from the next tick on
+    xCBSServerTCB.cTaskHandle = xTaskGetCurrentTaskHandle();
+    vTaskSetThreadLocalStoragePointer(NULL, LOCAL_STORAGE_INDEX, pvParameters);
+    vTaskSuspend(NULL);
+    #else
+    (void) pvParameters;
+    #endif
+
     for (;;)
     {
-        if (xNoOfAperiodicTasks > 0)
+        // serve the jobs in order of arrival, the declared ones are due once their arrival time has passed, the
+        // submitted ones arrived when they were queued. One submitted job is held while declared jobs go first
+        if (xJobReceived == pdFALSE)
+        {
+            xJobReceived = xEDFArrivalReceive(&xJob);
+        }
+
+        if ((EDFAperiodicJobDue() == pdTRUE) &&
+            ((xJobReceived == pdFALSE) || (((long int)(aperiodicTCBQueue[aperiodicJobPointer]->phase + xSysStartTime) - (long int)xJob.arrivalTime) <= 0)))
         {
-            xTCBA = aperiodicTCBQueue[aperiodicJob];
-            // Delay Server until arrival of aperiodic task
-            vTaskDelayUntil(&xLastWakeUpTime, xTCBA->phase + xSysStartTime);
-            
+            xTCBA = aperiodicTCBQueue[aperiodicJobPointer];
+            aperiodicJobPointer++;
+
             // Change task Number
             vTaskSetTaskNumber(EDFAperiodicServerHandle, xTCBA->xTaskNumber);
             // After wake up, execute the aperiodic task
-            printf("[INFO] In Task \"%s\" with Number: %d....\n", xTCBA->taskName, xTCBA->xTaskNumber);
+            EDF_LOG_INFO(EDF_LOG_APERIODIC_START, xTCBA->xTaskNumber, 0, 0, 0);
 
             // execute aperiodic funtion
             xTCBA->executedThisInstance = pdFALSE;
             xTCBA->instanceFunc(xTCBA->instanceParams);
             xTCBA->executedThisInstance = pdTRUE;
 
-            printf("[INFO] Task \"%s\" Completed Execution.\n", xTCBA->taskName);
-
-            aperiodicJob++;
-            xNoOfAperiodicTasks--;
+            EDF_LOG_INFO(EDF_LOG_APERIODIC_END, xTCBA->xTaskNumber, 0, 0, 0);
+        }
+        else if (xJobReceived == pdTRUE)
+        {
+            // submitted jobs run under the number of the server
+            vTaskSetTaskNumber(EDFAperiodicServerHandle, APERIODIC_SERVER_NUM);
+            EDF_LOG_INFO(EDF_LOG_APERIODIC_START, APERIODIC_SERVER_NUM, 0, 0, 0);
+            xJob.instanceFunc(xJob.instanceParams);
+            EDF_LOG_INFO(EDF_LOG_APERIODIC_END, APERIODIC_SERVER_NUM, 0, 0, 0);
+            xJobReceived = pdFALSE;
         }
         else
         {
-            // No more aperiodic tasks to run
+            // No aperiodic job has arrived, resumed from the tick hook or by the next submission
             vTaskSuspend(NULL);
         }
     }
@@ -231,263 +534,405 @@ static void EDFAperiodicServer(void *pvParameters)
 static void generatorTaskEDF(void *pvParameters)
 {
     extTCB_t * xTCB;
-    ListItem_t * xTCBListItem = listGET_HEAD_ENTRY(xTCBInitList);
-    const ListItem_t * xTCBListEndMarker = listGET_END_MARKER(xTCBInitList);
+    UBaseType_t uxTCBIndex = 0;
     BaseType_t taskCreated = pdFALSE;
+
+    (void) pvParameters;
+
     for (;;)
     {
-        // create all periodic tasks
-        while (xTCBListItem != xTCBListEndMarker)
-        {
-            xTCB = listGET_LIST_ITEM_OWNER(xTCBListItem);
-            printf("[INFO] Creating %s with priority %d, stack size %ld, period: %ld, releaseTime: %ld\n", xTCB->taskName, xTCB->xPriority, xTCB->stackSize, xTCB->period, xTCB->relArrivalTime);
-            taskCreated = xTaskCreate(EDFPeriodicWrapper, xTCB->taskName, xTCB->stackSize, (void *) xTCB, xTCB->xPriority, &(xTCB->cTaskHandle));
+        // get start time for tasks, on more than one core a task can start before the others are created
+        xSysStartTime = xTaskGetTickCount();
 
-            if (taskCreated == pdPASS)
+        // create all periodic tasks, each pinned to the core it was placed on (or free to migrate with global EDF)
+        for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+        {
+            uxTCBIndex = 0;
+            while (uxTCBIndex < heapCURRENT_LENGTH(&xTCBInitList[xCore]))
             {
-                printf("[INFO] %s created with priority %d and TCB Pointer: %p\n", xTCB->taskName, xTCB->xPriority, xTCB->cTaskHandle);
-                vTaskSetThreadLocalStoragePointer(xTCB->cTaskHandle, LOCAL_STORAGE_INDEX, xTCB);
+                xTCB = heapGET_ITEM_OWNER(heapGET_ITEM_AT(&xTCBInitList[xCore], uxTCBIndex));
+                #if configUSE_EDF == 1
+                taskCreated = EDFCreateKernelOrderedTask(xTCB);
+                #else
+                taskCreated = xEDFCreateTask(xTCB, EDFPeriodicWrapper, xTCB->taskName, xTCB->stackSize, (void *) xTCB, xTCB->xPriority, &(xTCB->cTaskHandle));
+                #endif
+
+                if (taskCreated == pdPASS)
+                {
+                    EDF_LOG_INFO(EDF_LOG_TASK_CREATED, xTCB->xTaskNumber, xTCB->xPriority, xTCB->period, xTCB->relArrivalTime);
+                    vTaskSetThreadLocalStoragePointer(xTCB->cTaskHandle, LOCAL_STORAGE_INDEX, xTCB);
+                    if (xTCB->pxHandle != NULL)
+                    {
+                        *xTCB->pxHandle = xTCB->cTaskHandle;
+                    }
+                    if (xTCB->phase == 0)
+                    {
+                        // the first job is released at the system start, a later one when the phase has passed
+                        EDF_TRACE_RELEASE_EVENT(xTCB->xTaskNumber, xSysStartTime + xTCB->relDeadline);
+                    }
+                }
+                else
+                {
+                    EDF_LOG_ERROR(EDF_LOG_TASK_CREATE_FAILED, xTCB->xTaskNumber, 0, 0, 0);
+                    #if EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE
+                    vEDFLogDrain();
+                    #endif
+                    abort();
+                }
+                vTaskSetTaskNumber(xTCB->cTaskHandle, xTCB->xTaskNumber);
+                uxTCBIndex++;
             }
-            else
+            #if configUSE_EDF == 1
+            // the library only keeps the tasks to find them again, they stay in the blocked list whatever their state
+            edfENTER_CORE_CRITICAL(xCore);
+            while (!heapIS_EMPTY(&xTCBInitList[xCore]))
             {
-                printf("[INFO] Could not allocate memory\n");
-                abort();
+                xTCB = heapGET_HEAD_OWNER(&xTCBInitList[xCore]);
+                uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+                vEDFHeapInsert(&xTCBBlockedList[xCore], &xTCB->xTCBHeapItem);
             }
-            vTaskSetTaskNumber(xTCB->cTaskHandle, xTCB->xTaskNumber);
-            xTCBListItem = listGET_NEXT(xTCBListItem);
+            edfEXIT_CORE_CRITICAL(xCore);
+            #endif
         }
 
         #if USE_TBS == 0
-        if (xNoOfAperiodicTasks > 0)
+        // the server is created even without declared aperiodic tasks, jobs can be submitted at runtime
         {
-            // create server with lowest possible priority with respect to all other tasks
-            taskCreated = xTaskCreate(EDFAperiodicServer, "Aperiodic Server", APERIODIC_SERVER_STACK, NULL, APERIODIC_PRIO, &EDFAperiodicServerHandle);
-            vTaskSetTaskNumber(EDFAperiodicServerHandle, aperiodicTCBQueue[0]->xTaskNumber);
-            //vTaskSuspend(EDFAperiodicServerHandle);
+            #if USE_CBS == 1
+            // the CBS is an EDF task of its run queue, it hands itself to the scheduler (see EDFAperiodicServer)
+            startEDF = pdTRUE;
+            taskCreated = xEDFCreateSystemTask(EDF_SYSTEM_TASK_APERIODIC_SERVER, EDFAperiodicServer, "Aperiodic Server", APERIODIC_SERVER_STACK, (void *) &xCBSServerTCB, SCHED_PRIO, &EDFAperiodicServerHandle, edfTASK_AFFINITY(&xCBSServerTCB));
+            #else
+            // create server with lowest possible priority with respect to all other tasks, it runs on any core that idles
+            taskCreated = xEDFCreateSystemTask(EDF_SYSTEM_TASK_APERIODIC_SERVER, EDFAperiodicServer, "Aperiodic Server", APERIODIC_SERVER_STACK, NULL, APERIODIC_PRIO, &EDFAperiodicServerHandle, tskNO_AFFINITY);
+            #endif
+            vTaskSetTaskNumber(EDFAperiodicServerHandle, APERIODIC_SERVER_NUM);
             if (taskCreated == pdTRUE)
             {
-                printf("[INFO] Created Server for %d Aperiodic Tasks.\n", xNoOfAperiodicTasks);
+                EDF_LOG_INFO(EDF_LOG_SERVER_CREATED, xNoOfAperiodicTasks, 0, 0, 0);
             }
             else
             {
-                printf("[INFO] Could not allocate memory for server.\n");
+                EDF_LOG_ERROR(EDF_LOG_SERVER_CREATE_FAILED, 0, 0, 0, 0);
             }
         }
         #endif
-        xSysStartTime = xTaskGetTickCount(); // get start time for tasks
-        printf("[INFO] System Start Time: %ld\n", xSysStartTime);
+        EDF_LOG_INFO(EDF_LOG_SYSTEM_START, xSysStartTime, 0, 0, 0);
         startEDF = pdTRUE;
+        #if USE_TBS == 1
+        // the workers hand themselves to the scheduler (see EDFTBSWorker), which then serves the jobs waiting already
+        EDFTBSCreateWorkers();
+        #endif
         vTaskDelete(NULL);
     }
 }
 
+#if configUSE_EDF == 1
+static BaseType_t EDFCreateKernelOrderedTask(extTCB_t * xTCB)
+{
+    // the kernel can only order a task on its deadline once its extended TCB is set, so the task is created below the
+    // EDF tasks and then raised to them, which queues it again. Nothing runs in between with the scheduler suspended
+    BaseType_t taskCreated;
+
+    vTaskSuspendAll();
+    taskCreated = xEDFCreateTask(xTCB, EDFPeriodicWrapper, xTCB->taskName, xTCB->stackSize, (void *) xTCB, BLOCKED_TASK_PRIO, &(xTCB->cTaskHandle));
+    if (taskCreated == pdPASS)
+    {
+        vTaskSetThreadLocalStoragePointer(xTCB->cTaskHandle, LOCAL_STORAGE_INDEX, xTCB);
+        // the deadline of the first job, as the wrapper sets it once it runs
+        xTCB->absDeadline = xSysStartTime + xTCB->relDeadline + xTCB->phase;
+        xTCB->status = TASK_READY;
+        xTCB->xPriority = RUNNING_TASK_PRIO;
+        vTaskPrioritySet(xTCB->cTaskHandle, RUNNING_TASK_PRIO);
+    }
+    (void) xTaskResumeAll();
+    return taskCreated;
+}
+#endif
+
+#if (USE_EDF_INLINE_DISPATCH == 0) && (configUSE_EDF == 0)
 static void EDFSchedulerTask(void *pvParameters)
 {
+    // every core runs a scheduler of its own, pinned to it
+    BaseType_t xCore = (BaseType_t)(intptr_t)pvParameters;
     uint32_t schedEvents;
+
+    #if USE_EDF_TICKLESS == 1
+    EDFArmEventTimer(xCore);
+    #endif
     for (;;)
     {
         xTaskNotifyWait(0x00, ALL_SWITCHES, &schedEvents, portMAX_DELAY);
-        //printf("Events: Ox%X\n", schedEvents);
-        EDFSchedulerFunctionOpt(schedEvents, &firstTaskToExecute);
-
-        #if USE_WCET_CHECKS == 1
-        if ((schedEvents & SWITCH_ON_WCET_WAKEUP) == SWITCH_ON_WCET_WAKEUP)
-        {
-            EDFWakeSuspendedTasksDueToWCET();
-        }
-        #endif
+        EDFSchedulerPass(xCore, schedEvents);
     }
 }
+#endif
 
-static void addTCBToList(extTCB_t * xTCB)
+#if configUSE_EDF == 0
+static void EDFSchedulerPass(BaseType_t xCore, uint32_t schedEvents)
 {
-    vListInitialiseItem(&xTCB->xTCBListItem);
-
-    listSET_LIST_ITEM_OWNER(&xTCB->xTCBListItem, xTCB);
-    listSET_LIST_ITEM_VALUE(&xTCB->xTCBListItem, xTCB->absDeadline);
+    #if USE_EDF_TICKLESS == 1
+    if ((schedEvents & SWITCH_ON_EVENT_TIMER) == SWITCH_ON_EVENT_TIMER)
+    {
+        // the checks raise their signals before the pass, so it services them at once
+        schedEvents |= EDFEventTimerExpired(xCore);
+    }
+    #endif
+    #if USE_TBS == 1
+    if ((schedEvents & SWITCH_ON_APERIODIC_ARRIVAL) == SWITCH_ON_APERIODIC_ARRIVAL)
+    {
+        // workers are resumed before the pass, so the decision already takes the new jobs into account
+        EDFTBSAdmitArrivals();
+    }
+    #endif
+    EDFSchedulerFunctionOpt(xCore, schedEvents, &firstTaskToExecute[xCore]);
 
-    // insert to initial list
-    vListInsert(xTCBInitList, &xTCB->xTCBListItem);
-}
+    #if USE_WCET_CHECKS == 1
+    if ((schedEvents & SWITCH_ON_WCET_WAKEUP) == SWITCH_ON_WCET_WAKEUP)
+    {
+        EDFWakeSuspendedTasksDueToWCET(xCore);
+    }
+    #endif
 
-#if USE_TBS == 0
-static void addTCBAToList(extTCBA_t * xTCBA)
-{
-    vListInitialiseItem(&xTCBA->xTCBAListItem);
-    listSET_LIST_ITEM_OWNER(&xTCBA->xTCBAListItem, xTCBA);
-    listSET_LIST_ITEM_VALUE(&xTCBA->xTCBAListItem, xTCBA->phase);
-    vListInsert(xTCBAperiodicList, &xTCBA->xTCBAListItem);
+    #if USE_EDF_TICKLESS == 1
+    EDFArmEventTimer(xCore);
+    #endif
 }
+#endif
 
-#else
-
-static void addTBSTCBToList(extTCB_t * xTCB)
+#if USE_EDF_INLINE_DISPATCH == 1
+static void EDFDeferredPass(void * pvParameter1, uint32_t ulCore)
 {
-    vListInitialiseItem(&xTCB->xTCBListItem);
-    listSET_LIST_ITEM_OWNER(&xTCB->xTCBListItem, xTCB);
-    listSET_LIST_ITEM_VALUE(&xTCB->xTCBListItem, xTCB->absDeadline);
-    // insert to initial list
+    // runs on the timer service task, above every EDF task. Events pended from now on pend the next pass
+    BaseType_t xCore = (BaseType_t) ulCore;
+    uint32_t schedEvents = __atomic_exchange_n(&ulDeferredEvents[xCore], 0, __ATOMIC_ACQ_REL);
+    (void) pvParameter1;
 
-    vListInsert(xTCBInitList, &xTCB->xTCBListItem);
+    if (startEDF == pdTRUE)
+    {
+        EDFSchedulerPass(xCore, schedEvents);
+    }
 }
 #endif
 
-static void deleteTCBFromList(extTCB_t * xTCB)
+static void addTCBToList(extTCB_t * xTCB)
 {
-    uxListRemove(&xTCB->xTCBListItem);
-    vPortFree(xTCB);
-}
+    vEDFHeapInitialiseItem(&xTCB->xTCBHeapItem);
+    edfINIT_DEADLINE_ITEM(xTCB);
 
-static void swapLists(List_t ** aTCBList, List_t ** bTCBList)
-{
-    List_t * tmp = *aTCBList;
-    *aTCBList = *bTCBList;
-    *bTCBList = tmp;
+    heapSET_ITEM_OWNER(&xTCB->xTCBHeapItem, xTCB);
+    // keyed as in the ready queue, so the first jobs of heavy EDF-US tasks get a core at start up as well
+    heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, edfREADY_KEY(xTCB));
+
+    // insert to initial list
+    vEDFHeapInsert(&xTCBInitList[xTCB->xCoreID], &xTCB->xTCBHeapItem);
 }
 
-static void EDFSchedulerInit()
+#if USE_TBS == 1
+static TickType_t EDFTBSDeadline(BaseType_t xCore, TickType_t releaseTime, TickType_t WCET)
 {
-    extTCB_t * xTCB;
-    ListItem_t * xListItem;
-    const ListItem_t * xListEndMarker;
-
-    // get first task to run
-    xListItem = listGET_HEAD_ENTRY(xTCBInitList);
+    // d_k = max(r_k, d_k-1) + C_k / Us, with the server bandwidth Us = 1 - Up of the core
+    // integer only so it can run from ISRs, rounded up so the server never gets more than Us
+    EDFUtilization_t Us;
 
-    // change ready task priority
-    xTCB = (extTCB_t *)listGET_LIST_ITEM_OWNER(xListItem);
-    xTCB->xPriority = RUNNING_TASK_PRIO;
-    firstTaskToExecute = xTCB;
+    configASSERT(Up_accepted[xCore] < EDF_UTIL_ONE);
+    Us = EDF_UTIL_ONE - Up_accepted[xCore];
+    return max(releaseTime, d_k[xCore]) + (TickType_t)((((uint64_t) WCET << EDF_UTIL_FRAC_BITS) + Us - 1) / Us);
 }
 
-#if USE_WCET_CHECKS == 1
-static void EDFWakeSuspendedTasksDueToWCET()
+static void EDFTBSCreateWorkers()
 {
-    // TODO 1: (Medium) Add feature to update sched wake up time for WCET WAKEUP based on next earliest unblock time 
-    ListItem_t * xTCBListItem = listGET_HEAD_ENTRY(xTCBSuspendedList);
-    const ListItem_t * xListEndMarker = listGET_END_MARKER(xTCBSuspendedList);
-
+    // the workers are EDF tasks without a job, created above the EDF tasks so that they suspend themselves at once
     extTCB_t * xTCB;
-    TickType_t xCurTick = xTaskGetTickCount();
+    char * pcName;
 
-    while (xTCBListItem != xListEndMarker)
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
     {
-        xTCB = listGET_LIST_ITEM_OWNER(xTCBListItem);
-        xTCBListItem = listGET_NEXT(xTCBListItem);
-
-        // Resume Task at
-        if ((xTCB->status == TASK_SUSPENDED) & (xTCB->WCETExceeded == pdTRUE))
+        for (BaseType_t i = 0; i < EDF_TBS_NUM_OF_WORKERS; i++)
         {
-            // Method used by Robin kase in his thesis
-            // find task unblocking time
-            if (((long int)xTCB->nextUnblockTime - (long int)xCurTick) <= 0)
+            xTCB = pxEDFAllocTCB();
+            configASSERT(xTCB != NULL);
+            memset(xTCB, 0, sizeof(extTCB_t));
+            pcName = pcTBSWorkerNames[xCore][i];
+            snprintf(pcName, configMAX_TASK_NAME_LEN, "TBS Worker %d", (int)(xCore * EDF_TBS_NUM_OF_WORKERS + i));
+            xTCB->taskName = pcName;
+            xTCB->stackSize = EDF_TBS_WORKER_STACK;
+            xTCB->xSwitchedInTime = edfNOT_SWITCHED_IN;
+            xTCB->xTaskNumber = APERIODIC_SERVER_NUM;
+            xTCB->xCoreID = xCore;
+            xTCB->xPriority = BLOCKED_TASK_PRIO;
+            xTCB->status = TASK_BLOCKED;
+            xTCB->isPeriodic = pdFALSE;
+            vEDFHeapInitialiseItem(&xTCB->xTCBHeapItem);
+            heapSET_ITEM_OWNER(&xTCB->xTCBHeapItem, xTCB);
+            edfINIT_DEADLINE_ITEM(xTCB);
+            edfINIT_STATS(xTCB);
+
+            if (xEDFCreateTask(xTCB, EDFTBSWorker, pcName, EDF_TBS_WORKER_STACK, (void *) xTCB, SCHED_PRIO, &(xTCB->cTaskHandle)) != pdPASS)
             {
-                //unblock task
-                xTCB->WCETExceeded = pdFALSE;
-                xTCB->relArrivalTime = xCurTick;
-                xTCB->absDeadline = xTCB->relArrivalTime + xTCB->period;
-                printf("[INFO] Suspended Task '%s' Resumed at %ld with absDeadline: %ld, period: %ld. Task resumed......\n", xTCB->taskName, xCurTick, xTCB->absDeadline, xTCB->period);
-                vTaskResume(xTCB->cTaskHandle);
+                EDF_LOG_ERROR(EDF_LOG_TASK_CREATE_FAILED, xTCB->xTaskNumber, 0, 0, 0);
+                vEDFFreeTCB(xTCB);
             }
         }
     }
 }
-#endif
 
-static BaseType_t EDFGetNextTaskToRun(extTCB_t ** nextTaskToRun, BaseType_t preEmptionReq)
+static void EDFTBSWorker(void *pvParameters)
 {
-    // TODO 2: (Low) Optimize the function to make it more compact to reduce runtime. Reduced scheduler overhead required
-    // Make function such that the current running task needs to be removed from the ready list before calling this function
-    BaseType_t preemptionRequired = pdFALSE;
-    extTCB_t * xTCBNextInit = NULL;
-    extTCB_t * nextTaskToRunPrev = NULL;
-    ListItem_t * xTCBToRun;
-    ListItem_t * xTCBToRunInit;
+    // a worker runs one job per resumption with the deadline it was given, and suspends itself again, the scheduler of
+    // its core then returns it to the idle workers. No task is created or deleted per job
+    extTCB_t * xTCB = (extTCB_t *)pvParameters;
 
-    // check if init list is empty, get head entry of init list
-    if (!listLIST_IS_EMPTY(xTCBInitList))
+    xTCB->cTaskHandle = xTaskGetCurrentTaskHandle();
+    vTaskSetThreadLocalStoragePointer(NULL, LOCAL_STORAGE_INDEX, xTCB);
+    for (;;)
     {
-        xTCBToRunInit = listGET_HEAD_ENTRY(xTCBInitList);
-        xTCBNextInit = listGET_LIST_ITEM_OWNER(xTCBToRunInit);
+        vTaskSuspend(NULL);
+
+        EDF_LOG_INFO(EDF_LOG_JOB_START, xTCB->xTaskNumber, xTCB->relArrivalTime, xTCB->absDeadline, xTCB->xPriority);
+        edfSTATS_JOB_START(xTCB);
+        xTCB->instanceFunc(xTCB->instanceParams);
+        edfUNWATCH_DEADLINE(xTCB);
+        edfSTATS_JOB_END(xTCB, (((long int)xTCB->absDeadline - (long int)xTaskGetTickCount()) < 0) ? pdTRUE : pdFALSE);
+        EDF_LOG_INFO(EDF_LOG_JOB_END, xTCB->xTaskNumber, xTCB->absDeadline, xTaskGetTickCount(), 0);
+        EDF_TRACE_EVENT(EDF_TRACE_BLOCK, xTCB->xTaskNumber);
     }
+}
 
-    // get head entry of ready list
-    if (!listLIST_IS_EMPTY(xTCBReadyList))
+static void EDFTBSReleaseDeclaredJobs()
+{
+    // declared jobs arrive like submitted ones, in the order they were created, a full queue is retried on the next tick
+    BaseType_t xReleased = pdFALSE;
+
+    while ((aperiodicJobPointer < xNoOfAperiodicTasks) &&
+           (((long int)(xTBSDeclaredJobs[aperiodicJobPointer].arrivalTime + xSysStartTime) - (long int)xTaskGetTickCountFromISR()) <= 0))
     {
-        ListItem_t * xTCBToRun = listGET_HEAD_ENTRY(xTCBReadyList);
-        *nextTaskToRun = listGET_LIST_ITEM_OWNER(xTCBToRun);
-        preemptionRequired = pdTRUE;
+        EDFAperiodicJob_t xJob = xTBSDeclaredJobs[aperiodicJobPointer];
+        xJob.arrivalTime += xSysStartTime;
+        if (xEDFArrivalSend(&xJob) == pdFALSE)
+        {
+            break;
+        }
+        aperiodicJobPointer++;
+        xReleased = pdTRUE;
     }
-    else
+
+    if (xReleased == pdTRUE)
     {
-        //printf("Ready List empty\n");
-        preemptionRequired = pdFALSE;
+        EDFWakeScheduler(0, SWITCH_ON_APERIODIC_ARRIVAL);
     }
+}
+#endif
 
-    if ((xTCBNextInit != NULL) & (preemptionRequired == pdTRUE))
+static void deleteTCBFromList(extTCB_t * xTCB)
+{
+    uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+    edfUNWATCH_DEADLINE(xTCB);
+    #if USE_CBS == 1
+    if (xTCB == &xCBSServerTCB)
     {
-        if ((xTCBNextInit->absDeadline + xSysStartTime) < (*nextTaskToRun)->absDeadline)
-        {
-            // correct arrival time and absDeadline
-            xTCBNextInit->relArrivalTime = xSysStartTime;
-            xTCBNextInit->absDeadline = xSysStartTime + xTCBNextInit->relDeadline + xTCBNextInit->phase;
-            // remove from init list
-            uxListRemove(&xTCBNextInit->xTCBListItem);
-            // insert into final ready list
-            listSET_LIST_ITEM_VALUE(&xTCBNextInit->xTCBListItem, xTCBNextInit->absDeadline);
-            vListInsert(xTCBReadyList, &xTCBNextInit->xTCBListItem);
-            *nextTaskToRun = xTCBNextInit;
-        }
-    }
-    else if ((xTCBNextInit != NULL) & (preemptionRequired == pdFALSE))
-    {
-        // empty ready list
-        // correct arrival time and absDeadline
-        xTCBNextInit->relArrivalTime = xSysStartTime;
-        xTCBNextInit->absDeadline = xSysStartTime + xTCBNextInit->relDeadline + xTCBNextInit->phase;
-        // remove from init list
-        uxListRemove(&xTCBNextInit->xTCBListItem);
-        // insert into final ready list
-        listSET_LIST_ITEM_VALUE(&xTCBNextInit->xTCBListItem, xTCBNextInit->absDeadline);
-        vListInsert(xTCBReadyList, &xTCBNextInit->xTCBListItem);
-        *nextTaskToRun = xTCBNextInit;
-        preemptionRequired = pdTRUE;
+        // the server TCB is not allocated, only its task is deleted
+        EDFAperiodicServerHandle = NULL;
+        return;
+    }
+    #endif
+    vEDFFreeTCB(xTCB);
+}
+
+#if configUSE_EDF == 0
+static void EDFSchedulerInit()
+{
+    #if USE_GLOBAL_EDF == 1
+    // the earliest tasks are created with a core each, the first scheduler pass takes over from there
+    uxNumOfGlobalRunningTasks = EDFEarliestTasks(&xTCBInitList[0], xGlobalRunningTasks, EDF_NUM_OF_CORES);
+    for (UBaseType_t i = 0; i < uxNumOfGlobalRunningTasks; i++)
+    {
+        xGlobalRunningTasks[i]->xPriority = RUNNING_TASK_PRIO;
+        xGlobalRunningTasks[i]->status = TASK_RUNNING;
     }
+    #else
+    extTCB_t * xTCB;
 
-    if (preEmptionReq == pdFALSE)
+    // get first task to run on every core that has tasks, change ready task priority
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
     {
-        return preemptionRequired;
+        firstTaskToExecute[xCore] = NULL;
+        if (!heapIS_EMPTY(&xTCBInitList[xCore]))
+        {
+            xTCB = (extTCB_t *)heapGET_HEAD_OWNER(&xTCBInitList[xCore]);
+            xTCB->xPriority = RUNNING_TASK_PRIO;
+            firstTaskToExecute[xCore] = xTCB;
+        }
     }
-    else
+    #endif
+}
+#endif
+
+#if USE_WCET_CHECKS == 1
+static void EDFWakeSuspendedTasksDueToWCET(BaseType_t xCore)
+{
+    // pop every task whose unblock time has passed, the queue is ordered on it so the first task not due ends the walk
+    EDFHeap_t * xTCBWakeListOfCore = &xTCBWCETWakeList[xCore];
+    extTCB_t * xTCB;
+    TickType_t xCurTick = xTaskGetTickCount();
+
+    for (;;)
     {
-        return preEmptionReq;
+        edfENTER_CORE_CRITICAL(xCore);
+        if (heapIS_EMPTY(xTCBWakeListOfCore) || (((long int)heapGET_HEAD_VALUE(xTCBWakeListOfCore) - (long int)xCurTick) > 0))
+        {
+            edfEXIT_CORE_CRITICAL(xCore);
+            break;
+        }
+        xTCB = heapGET_HEAD_OWNER(xTCBWakeListOfCore);
+        uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+        edfEXIT_CORE_CRITICAL(xCore);
+
+        // Resume Task at
+        if ((xTCB->status == TASK_SUSPENDED) & (xTCB->WCETExceeded == pdTRUE))
+        {
+            // Method used by Robin kase in his thesis
+            //unblock task
+            xTCB->WCETExceeded = pdFALSE;
+            xTCB->relArrivalTime = xCurTick;
+            xTCB->absDeadline = xTCB->relArrivalTime + xTCB->period;
+            EDF_LOG_INFO(EDF_LOG_WCET_RESUMED, xTCB->xTaskNumber, xCurTick, xTCB->absDeadline, xTCB->period);
+            vTaskResume(xTCB->cTaskHandle);
+        }
     }
+
+    // re-arm for the next task of the queue
+    EDFUpdateWCETWakeUp(xCore);
+}
+
+static void EDFUpdateWCETWakeUp(BaseType_t xCore)
+{
+    // a head that is already due is caught at the next tick (or event timer), the wakeup then pops it
+    edfENTER_CORE_CRITICAL(xCore);
+    EarliestSchedWakeUp[xCore] = heapIS_EMPTY(&xTCBWCETWakeList[xCore]) ? 0 : heapGET_HEAD_VALUE(&xTCBWCETWakeList[xCore]);
+    edfEXIT_CORE_CRITICAL(xCore);
 }
+#endif
 
-static BaseType_t EDFGetNextTaskToRunOpt(extTCB_t ** nextTaskToRun)
+#if (USE_GLOBAL_EDF == 0) && (configUSE_EDF == 0)
+static BaseType_t EDFGetNextTaskToRunOpt(BaseType_t xCore, extTCB_t ** nextTaskToRun)
 {
+    EDFHeap_t * xTCBInitListOfCore = &xTCBInitList[xCore];
+    EDFHeap_t * xTCBReadyListOfCore = &xTCBReadyList[xCore];
     extTCB_t * xTCBNextInit = NULL;
     extTCB_t * nextTCB = NULL;
-    ListItem_t * xTCBToRun;
-    ListItem_t * xTCBToRunInit;
     BaseType_t preemptionRequired = pdFALSE;
 
     // check if init list is empty, get head entry of init list
-    if (!listLIST_IS_EMPTY(xTCBInitList))
+    if (!heapIS_EMPTY(xTCBInitListOfCore))
     {
-        xTCBToRunInit = listGET_HEAD_ENTRY(xTCBInitList);
-        xTCBNextInit = listGET_LIST_ITEM_OWNER(xTCBToRunInit);
+        xTCBNextInit = heapGET_HEAD_OWNER(xTCBInitListOfCore);
     }
 
     // get head entry of ready list
-    if (!listLIST_IS_EMPTY(xTCBReadyList))
-    {
-        ListItem_t * xTCBToRun = listGET_HEAD_ENTRY(xTCBReadyList);
-        nextTCB = listGET_LIST_ITEM_OWNER(xTCBToRun);
-    }
-    else
+    if (!heapIS_EMPTY(xTCBReadyListOfCore))
     {
-        //printf("Ready List empty\n");
+        nextTCB = heapGET_HEAD_OWNER(xTCBReadyListOfCore);
     }
 
     // ************** //
@@ -500,16 +945,17 @@ static BaseType_t EDFGetNextTaskToRunOpt(extTCB_t ** nextTaskToRun)
         if (xTCBNextInit != NULL)
         {
             // Init list not empty so check if head entry of init list needs to be executed next
-            if ((xTCBNextInit->absDeadline + xSysStartTime) < nextTCB->absDeadline)
+            if (heapIS_BEFORE(xTCBNextInit->absDeadline + xSysStartTime, nextTCB->absDeadline) == pdTRUE)
             {
                 // correct arrival time and absDeadline
                 xTCBNextInit->relArrivalTime = xSysStartTime;
                 xTCBNextInit->absDeadline = xSysStartTime + xTCBNextInit->relDeadline + xTCBNextInit->phase;
                 // remove from init list
-                uxListRemove(&xTCBNextInit->xTCBListItem);
+                uxEDFHeapRemove(&xTCBNextInit->xTCBHeapItem);
                 // insert into final ready list
-                listSET_LIST_ITEM_VALUE(&xTCBNextInit->xTCBListItem, xTCBNextInit->absDeadline);
-                vListInsert(xTCBReadyList, &xTCBNextInit->xTCBListItem);
+                heapSET_ITEM_VALUE(&xTCBNextInit->xTCBHeapItem, xTCBNextInit->absDeadline);
+                vEDFHeapInsert(xTCBReadyListOfCore, &xTCBNextInit->xTCBHeapItem);
+                edfWATCH_DEADLINE(xTCBNextInit);
                 nextTCB = xTCBNextInit;
             }
         }
@@ -524,10 +970,11 @@ static BaseType_t EDFGetNextTaskToRunOpt(extTCB_t ** nextTaskToRun)
             xTCBNextInit->relArrivalTime = xSysStartTime;
             xTCBNextInit->absDeadline = xSysStartTime + xTCBNextInit->relDeadline + xTCBNextInit->phase;
             // remove from init list
-            uxListRemove(&xTCBNextInit->xTCBListItem);
+            uxEDFHeapRemove(&xTCBNextInit->xTCBHeapItem);
             // insert into final ready list
-            listSET_LIST_ITEM_VALUE(&xTCBNextInit->xTCBListItem, xTCBNextInit->absDeadline);
-            vListInsert(xTCBReadyList, &xTCBNextInit->xTCBListItem);
+            heapSET_ITEM_VALUE(&xTCBNextInit->xTCBHeapItem, xTCBNextInit->absDeadline);
+            vEDFHeapInsert(xTCBReadyListOfCore, &xTCBNextInit->xTCBHeapItem);
+            edfWATCH_DEADLINE(xTCBNextInit);
             nextTCB = xTCBNextInit;
         }
         else
@@ -541,7 +988,7 @@ static BaseType_t EDFGetNextTaskToRunOpt(extTCB_t ** nextTaskToRun)
     {
         if (nextTCB != NULL)
         {
-            if ((*nextTaskToRun)->absDeadline > nextTCB->absDeadline)
+            if (heapIS_BEFORE(nextTCB->absDeadline, (*nextTaskToRun)->absDeadline) == pdTRUE)
             {
                 *nextTaskToRun = nextTCB;
             }
@@ -563,186 +1010,274 @@ static BaseType_t EDFGetNextTaskToRunOpt(extTCB_t ** nextTaskToRun)
 
     return preemptionRequired;
 }
+#endif
 
-static void EDFSchedulerFunctionOpt(uint32_t schedEvents, extTCB_t ** firstTaskToRun)
+#if configUSE_EDF == 0
+static void EDFSchedulerFunctionOpt(BaseType_t xCore, uint32_t schedEvents, extTCB_t ** firstTaskToRun)
 {
     if(startEDF == pdFALSE)
     {
         return;
     }
-    if (xTaskGetTickCount() == EarliestSchedWakeUp)
-    {
-        EarliestSchedWakeUp = 0;
-    }
+    // scheduler variables of every core
+    extTCB_t * currentRunningTask = currentRunningTaskOfCore[xCore];
+    // TCBs deleted in this pass, freed once no signal of the pass can refer to them any more (see EDFQueueTCBToFree)
+    static extTCB_t * xTCBsToFreeOfCore[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
+    extTCB_t ** xTCBsToFree = xTCBsToFreeOfCore[xCore];
+    UBaseType_t uxNumOfTCBsToFree = 0;
+
+    currentRunningTask = EDFTakeFirstTask(currentRunningTask, firstTaskToRun);
+    #if USE_GLOBAL_EDF == 1
+    // taken before the signals, whatever such a task signalled before it was switched out is serviced in this pass
+    uxNumOfTCBsToFree = EDFTakeSwitchedOutTasks(xTCBsToFree, uxNumOfTCBsToFree);
+    #endif
 
-    // scheduler variables, keep static to remember state
-    static extTCB_t * currentRunningTask = NULL;
+    // signal being serviced
+    uint32_t signal;
+    extTCB_t * xTCB;
+    #if USE_WCET_CHECKS == 1 || USE_DEADLINE_CHECKS == 1
+    // action for an overrun or a deadline miss
+    EDFJobPolicy_t xPolicy;
+    #endif
 
-    if (*firstTaskToRun != NULL)
+    // Service every signal queued since the last pass, the preemption decision is then made once for the whole batch
+    while (xEDFSignalReceive(xCore, &signal, (void **)&xTCB) == pdTRUE)
     {
-        currentRunningTask = *firstTaskToRun;
-        currentRunningTask->status = TASK_RUNNING;
-        *firstTaskToRun = NULL;
-    }
+        if (xTCB->cTaskHandle == NULL)
+        {
+            // task was deleted earlier in this pass
+            continue;
+        }
 
-    // variable to decide if a preemption is required
-    BaseType_t preemptionRequired = pdFALSE;
-    // variable to collect next task to run
-    extTCB_t * nextTaskToRun = NULL;
+        if (signal == SWITCH_ON_BLOCK)
+        {
+            // delegated code from Task Blocking Macro
+            // Done to ensure the TCB lists are only changed by the scheduler while the task is still running
+            edfENTER_CORE_CRITICAL(xCore);
+            if (xTCB->status == TASK_RUNNING)
+            {
+                xTCB->status = TASK_BLOCKED;
+                uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+                heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, xTCB->absDeadline);
+                vEDFHeapInsert(&xTCBBlockedList[xCore], &xTCB->xTCBHeapItem);
+            }
+            edfEXIT_CORE_CRITICAL(xCore);
 
-    if ((schedEvents & SWITCH_ON_BLOCK) == SWITCH_ON_BLOCK)
-    {
-        //printf("Sched Block, Triggered by: %s with status: %d\n", currentRunningTask->taskName, currentRunningTask->status);
+            xTCB->xPriority = BLOCKED_TASK_PRIO;
+            vTaskPrioritySet(xTCB->cTaskHandle, BLOCKED_TASK_PRIO);
 
-        // delegated code from Task Blocking Macro
-        // Done to ensure the variable currentRunningTask is not visible to any code outside the scheduler
-        // Needed as Task Blocking Macro does not have access to the calling TCB
-        if (currentRunningTask->status == TASK_RUNNING)
+            if (xTCB == currentRunningTask)
+            {
+                currentRunningTask = NULL;
+            }
+        }
+        else if (signal == SWITCH_ON_READY)
         {
-            currentRunningTask->status = TASK_BLOCKED;
-            listSET_LIST_ITEM_VALUE(&currentRunningTask->xTCBListItem, currentRunningTask->absDeadline);
-            uxListRemove(&currentRunningTask->xTCBListItem);
-            vListInsert(xTCBBlockedList, &currentRunningTask->xTCBListItem);
+            // the task was already inserted into the ready list, the decision below takes it into account
         }
+        else if (signal == SWITCH_ON_SUSPEND)
+        {
+            if ((xTCB->status == TASK_SUSPENDED) 
+            #if USE_WCET_CHECKS == 1
+            & (xTCB->WCETExceeded == pdFALSE)
+            #endif
+            )
+            {
+                // change priorty, the suspended task was removed from the ready list by the Suspend Macro
+                xTCB->xPriority = BLOCKED_TASK_PRIO;
+                vTaskPrioritySet(xTCB->cTaskHandle, BLOCKED_TASK_PRIO);
 
-        // Change task priority and select next task to run
-        // following function only called if the currentRunningTask is removed from the ready list, which is done above
-        preemptionRequired = EDFGetNextTaskToRunOpt(&nextTaskToRun);
+                if (xTCB == currentRunningTask)
+                {
+                    currentRunningTask = NULL;
+                }
 
-        #if USE_TBS == 1
-        if ((currentRunningTask->isPeriodic == pdFALSE) & (currentRunningTask->executedTBSTask == pdTRUE))
-        {
-            // TBS Task execution completed
-            // printf("[INFO] TBS Task '%s' has completed execution, will be deleted\n", currentRunningTask->taskName);
-            if(currentRunningTask->cTaskHandle != NULL){
-                vTaskDelete(currentRunningTask->cTaskHandle);
-                currentRunningTask->cTaskHandle = NULL;
+                if (xTCB->xAddedOnline == pdTRUE)
+                {
+                    // a task added at runtime has handed itself over, the resume hook queues its first job
+                    xTCB->xAddedOnline = pdFALSE;
+                    vTaskResume(xTCB->cTaskHandle);
+                }
+
+                #if USE_TBS == 1
+                if (xTCB->isPeriodic == pdFALSE)
+                {
+                    // the worker completed its job (or just started), it takes the next job waiting
+                    edfENTER_CORE_CRITICAL(xCore);
+                    xTBSIdleWorkers[xCore][uxNumOfTBSIdleWorkers[xCore]++] = xTCB;
+                    edfEXIT_CORE_CRITICAL(xCore);
+                    if (xEDFArrivalPending() == pdTRUE)
+                    {
+                        EDFWakeScheduler(0, SWITCH_ON_APERIODIC_ARRIVAL);
+                    }
+                }
+                #endif
             }
-            deleteTCBFromList(currentRunningTask);
-            currentRunningTask = NULL;
         }
-        else
+        #if USE_WCET_CHECKS == 1
+        else if (signal == SWITCH_ON_WCET_OVERFLOW)
         {
-        #endif 
-            currentRunningTask->xPriority = BLOCKED_TASK_PRIO;
-            vTaskPrioritySet(currentRunningTask->cTaskHandle, BLOCKED_TASK_PRIO);
-            currentRunningTask = NULL;
-        
-        #if USE_TBS == 1
-        }
-        #endif
-        // request serviced
-    }
-    if ((schedEvents & SWITCH_ON_READY) == SWITCH_ON_READY)
-    {
-        // preemption is performed only when a task is moved into the ready state
+            if ((xTCB->status == TASK_SUSPENDED) & (xTCB->WCETExceeded == pdTRUE))
+            {
+                xPolicy = EDFSelectJobPolicy(xTCB, EDF_EVENT_OVERRUN);
+            }
+            else
+            {
+                continue;
+            }
 
-        if (xTCBToReady != NULL)
-        {
-            //printf("Sched Ready: nextTaskName: %s, absD: %ld\n", xTCBToReady->taskName, xTCBToReady->absDeadline);
-            if (currentRunningTask != NULL)
+            if (xPolicy != EDF_POLICY_DEFAULT)
             {
-                if (currentRunningTask->absDeadline > xTCBToReady->absDeadline)
+                if (EDFApplyJobPolicy(xCore, xTCB, xPolicy, EDF_EVENT_OVERRUN) == pdFALSE)
                 {
-                    // need preemption as task moved into ready state has earlier deadline
-                    preemptionRequired = pdTRUE;
-                    nextTaskToRun = xTCBToReady;
+                    if (xTCB == currentRunningTask)
+                    {
+                        currentRunningTask = NULL;
+                    }
                 }
             }
             else
             {
-                preemptionRequired = pdTRUE;
-                nextTaskToRun = xTCBToReady;
+                // queue the task on its unblock time and wake up the scheduler at the earliest one
+                edfENTER_CORE_CRITICAL(xCore);
+                uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+                heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, xTCB->nextUnblockTime);
+                vEDFHeapInsert(&xTCBWCETWakeList[xCore], &xTCB->xTCBHeapItem);
+                edfEXIT_CORE_CRITICAL(xCore);
+                EDFUpdateWCETWakeUp(xCore);
+                // the job is dropped, the resumed task gets a new deadline
+                edfUNWATCH_DEADLINE(xTCB);
+
+                EDF_LOG_ERROR(EDF_LOG_WCET_OVERFLOW, xTCB->xTaskNumber, edfTICKS_TO_US(xTCB->WCET), xTCB->measuredExecTime, xTCB->nextUnblockTime);
+                xTCB->measuredExecTime = 0;
+                xTCB->xPriority = BLOCKED_TASK_PRIO;
+                vTaskPrioritySet(xTCB->cTaskHandle, BLOCKED_TASK_PRIO);
+                vTaskSuspend(xTCB->cTaskHandle);
+
+                if (xTCB == currentRunningTask)
+                {
+                    currentRunningTask = NULL;
+                }
             }
-            // once preemption decision has been made, set passing variable as NULL to indicate the request as serviced
-            xTCBToReady = NULL;
         }
-    }
-    if ((schedEvents & SWITCH_ON_SUSPEND) == SWITCH_ON_SUSPEND)
-    {
-        if (xTCBToSuspend != NULL)
+        #endif
+        #if USE_DEADLINE_CHECKS == 1
+        else if (signal == SWITCH_ON_DEADLINE_OVERFLOW)
         {
-            if ((xTCBToSuspend->status == TASK_SUSPENDED) 
-            #if USE_WCET_CHECKS == 1
-            & (xTCBToSuspend->WCETExceeded == pdFALSE)
-            #endif
-            )
+            if (xTCB->deadlineExceeded == pdTRUE)
             {
-                //printf("Sched Suspend, triggered by: %s\n", xTCBToSuspend->taskName);
-                // change priorty 
-                xTCBToSuspend->xPriority = BLOCKED_TASK_PRIO;
-                vTaskPrioritySet(xTCBToSuspend->cTaskHandle, BLOCKED_TASK_PRIO);
-
-                // Function can be called as the suspended task is removed from the ready list by the Suspend Macro
-                preemptionRequired = EDFGetNextTaskToRunOpt(&nextTaskToRun);
+                xPolicy = EDFSelectJobPolicy(xTCB, EDF_EVENT_DEADLINE_MISS);
+            }
+            else
+            {
+                continue;
+            }
 
-                // request serviced
-                xTCBToSuspend = NULL;
+            if (xPolicy != EDF_POLICY_DEFAULT)
+            {
+                if (EDFApplyJobPolicy(xCore, xTCB, xPolicy, EDF_EVENT_DEADLINE_MISS) == pdFALSE)
+                {
+                    if (xTCB == currentRunningTask)
+                    {
+                        currentRunningTask = NULL;
+                    }
+                }
             }
-        }
-    }
-    #if USE_WCET_CHECKS == 1
-    if ((schedEvents & SWITCH_ON_WCET_OVERFLOW) == SWITCH_ON_WCET_OVERFLOW)
-    {
-        if (xTCBWCETOverflow != NULL)
-        {
-            if ((xTCBWCETOverflow->status == TASK_SUSPENDED) & (xTCBWCETOverflow->WCETExceeded == pdTRUE))
+            else
             {
-                // insert task to suspended list
-                uxListRemove(&xTCBWCETOverflow->xTCBListItem);
-                vListInsert(xTCBSuspendedList, &xTCBWCETOverflow->xTCBListItem);
-
-                printf("[INFO] Task '%s' crossed WCET, WCET: %ld, measured Execution Time: %ld. NextUnblockTime: %ld with period doubled.Task Suspended....\n", xTCBWCETOverflow->taskName, xTCBWCETOverflow->WCET, xTCBWCETOverflow->measuredExecTime, xTCBWCETOverflow->nextUnblockTime);
-                xTCBWCETOverflow->measuredExecTime = 0;
-                //xTCB->WCETExceeded = pdFALSE;
-                xTCBWCETOverflow->xPriority = BLOCKED_TASK_PRIO;
-                vTaskPrioritySet(xTCBWCETOverflow->cTaskHandle, BLOCKED_TASK_PRIO);
-                vTaskSuspend(xTCBWCETOverflow->cTaskHandle);
-
-                // Task removed from ready list above
-                preemptionRequired = EDFGetNextTaskToRunOpt(&nextTaskToRun);
-                if (xTCBWCETOverflow->cTaskHandle == currentRunningTask->cTaskHandle)
+                // deadline missed
+                // For now, log the miss and delete the task
+                EDF_LOG_ERROR(EDF_LOG_DEADLINE_MISS, xTCB->xTaskNumber, xTCB->absDeadline, xTaskGetTickCount(), 0);
+
+                if (xTCB == currentRunningTask)
                 {
+                    // Set to NULL as current Running Task will be removed from the system
                     currentRunningTask = NULL;
                 }
-                // request serviced
-                xTCBWCETOverflow = NULL;
+                EDFRetainUtilization(xTCB);
+                EDFDeleteTask(xCore, xTCB);
+                uxNumOfTCBsToFree = EDFQueueTCBToFree(xTCB, xTCBsToFree, uxNumOfTCBsToFree);
+            }
+        }
+        #endif
+        else if (signal == SWITCH_ON_REMOVE)
+        {
+            // the utilization was retained by EDFRemovePeriodicTask
+            if (xTCB == currentRunningTask)
+            {
+                currentRunningTask = NULL;
             }
+            EDF_LOG_INFO(EDF_LOG_TASK_REMOVED, xTCB->xTaskNumber, xTaskRecords[xTCB->xTaskNumber - TASK_NUM_START].xLastDeadline, 0, 0);
+            EDFDeleteTask(xCore, xTCB);
+            uxNumOfTCBsToFree = EDFQueueTCBToFree(xTCB, xTCBsToFree, uxNumOfTCBsToFree);
         }
     }
+
+    #if USE_GLOBAL_EDF == 1
+    EDFGlobalDropStoppedTasks();
     #endif
 
-    #if USE_DEADLINE_CHECKS == 1
-    if ((schedEvents & SWITCH_ON_DEADLINE_OVERFLOW) == SWITCH_ON_DEADLINE_OVERFLOW)
+    // the queue is empty, nothing refers to the deleted TCBs any more
+    while (uxNumOfTCBsToFree > 0)
     {
-        if (xTCBDeadlineOverflow != NULL)
-        {
-            if (xTCBDeadlineOverflow->deadlineExceeded == pdTRUE)
-            {
-                // deadline missed
-                // For now, print message and delete the task
-                printf("[INFO] Task '%s' missed its deadline of %ld with current time: %ld and TCB Address: %p and thus cannot be scheduled using EDF. Task Deleted....\n", xTCBDeadlineOverflow->taskName, xTCBDeadlineOverflow->absDeadline, xTaskGetTickCount(), xTCBDeadlineOverflow->cTaskHandle);
+        vEDFFreeTCB(xTCBsToFree[--uxNumOfTCBsToFree]);
+    }
 
-                if(xTCBDeadlineOverflow->cTaskHandle != NULL){
-                    if (currentRunningTask->cTaskHandle == xTCBDeadlineOverflow->cTaskHandle)
-                    {
-                        // Set to NULL as current Running Task will be removed from the system
-                        currentRunningTask = NULL;
-                    }
-                    vTaskDelete(xTCBDeadlineOverflow->cTaskHandle);
-                    xTCBDeadlineOverflow->cTaskHandle = NULL;
-                }
-                deleteTCBFromList(xTCBDeadlineOverflow);
+    #if USE_GLOBAL_EDF == 1
+    EDFGlobalDispatch();
+    #else
+    // Single preemption decision for the batch
+    currentRunningTask = EDFPreemptionDecision(xCore, currentRunningTask);
+    #endif
+    currentRunningTaskOfCore[xCore] = currentRunningTask;
+    traceEDF_SCHEDULER_DONE(schedEvents);
+}
 
-                // Task has been removed from the system
-                preemptionRequired = EDFGetNextTaskToRunOpt(&nextTaskToRun);
+static extTCB_t * EDFTakeFirstTask(extTCB_t * currentRunningTask, extTCB_t ** firstTaskToRun)
+{
+    // the first task of the core runs from the start, the first pass takes it over
+    if (*firstTaskToRun != NULL)
+    {
+        currentRunningTask = *firstTaskToRun;
+        currentRunningTask->status = TASK_RUNNING;
+        #if USE_SRP == 1
+        currentRunningTask->xJobStarted = pdTRUE;
+        #endif
+        *firstTaskToRun = NULL;
+    }
+    return currentRunningTask;
+}
+#endif
 
-                // request serviced
-                xTCBDeadlineOverflow = NULL;
-            }
-        }
+#if (USE_GLOBAL_EDF == 0) && (configUSE_EDF == 0)
+static extTCB_t * EDFPreemptionDecision(BaseType_t xCore, extTCB_t * currentRunningTask)
+{
+    // run the earliest deadline of the ready list (moving an initial task over if it is due earlier) unless the current
+    // running task has an earlier or equal deadline, returns the task the core is given to
+    BaseType_t preemptionRequired = pdFALSE;
+    extTCB_t * nextTaskToRun = NULL;
+
+    edfENTER_CORE_CRITICAL(xCore);
+    preemptionRequired = EDFGetNextTaskToRunOpt(xCore, &nextTaskToRun);
+    #if USE_SRP == 1
+    if ((preemptionRequired == pdTRUE) && (edfSRP_MAY_RUN(xCore, nextTaskToRun) == pdFALSE))
+    {
+        // the earliest job has not started and its preemption level is not above the system ceiling, it waits for
+        // the unlock, which wakes the scheduler again. Until then the earliest job that may run does, at the latest
+        // the one that holds the resource
+        xSRPHeldBack[xCore] = pdTRUE;
+        nextTaskToRun = EDFSRPEarliestTask(xCore);
+        preemptionRequired = (nextTaskToRun != NULL) ? pdTRUE : pdFALSE;
     }
     #endif
+    edfEXIT_CORE_CRITICAL(xCore);
+    if ((preemptionRequired == pdTRUE) & (currentRunningTask != NULL))
+    {
+        if ((nextTaskToRun == currentRunningTask) || (heapIS_BEFORE(nextTaskToRun->absDeadline, currentRunningTask->absDeadline) == pdFALSE))
+        {
+            preemptionRequired = pdFALSE;
+        }
+    }
 
     // action to perform if preemption is required
     if (preemptionRequired == pdTRUE)
@@ -754,86 +1289,1112 @@ static void EDFSchedulerFunctionOpt(uint32_t schedEvents, extTCB_t ** firstTaskT
             {
                 currentRunningTask->status = TASK_READY;
             }
-            //printf("Task to be blocked: %s with status: %d\n", currentRunningTask->taskName, currentRunningTask->status);
             currentRunningTask->xPriority = BLOCKED_TASK_PRIO;
             vTaskPrioritySet(currentRunningTask->cTaskHandle, BLOCKED_TASK_PRIO);
         }
         if (nextTaskToRun != NULL)
         {
-            //printf("selected task: %s with absDeadline: %ld and status: %d. curTime: %ld and wakeUp: %ld\n", nextTaskToRun->taskName, nextTaskToRun->absDeadline, nextTaskToRun->status, xTaskGetTickCount(), nextTaskToRun->absDeadline - nextTaskToRun->period);
             currentRunningTask = nextTaskToRun;
             currentRunningTask->xPriority = RUNNING_TASK_PRIO;
             currentRunningTask->status = TASK_RUNNING;
+            #if USE_SRP == 1
+            currentRunningTask->xJobStarted = pdTRUE;
+            #endif
             vTaskPrioritySet(currentRunningTask->cTaskHandle, RUNNING_TASK_PRIO);
         }
-        preemptionRequired = pdFALSE;
-        nextTaskToRun = NULL;
     }
+    return currentRunningTask;
+}
+#endif
+
+#if USE_EDF_INLINE_DISPATCH == 1
+static void EDFDispatchInline(extTCB_t * xTCB, uint32_t event)
+{
+    // the pass for the job end (SWITCH_ON_BLOCK) or the release (SWITCH_ON_READY) of the calling task, made by the task
+    // itself. With the scheduler suspended the priorities set here take effect together, with one context switch at
+    // most. Signals queued meanwhile are left to the deferred pass
+    BaseType_t xCore = xTCB->xCoreID;
+    extTCB_t * currentRunningTask;
+
+    traceEDF_SCHEDULER_WAKE(event);
+    vTaskSuspendAll();
+    currentRunningTask = EDFTakeFirstTask(currentRunningTaskOfCore[xCore], &firstTaskToExecute[xCore]);
+    if (event == SWITCH_ON_BLOCK)
+    {
+        // the task waits for its release above the EDF tasks, so the release preempts whatever runs and the task
+        // decides itself. Raised while it still runs, the ready hook takes the priority change of a blocked task for
+        // a release
+        xTCB->xPriority = SCHED_PRIO;
+        vTaskPrioritySet(NULL, SCHED_PRIO);
+
+        edfENTER_CORE_CRITICAL(xCore);
+        if (xTCB->status == TASK_RUNNING)
+        {
+            xTCB->status = TASK_BLOCKED;
+            uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+            heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, xTCB->absDeadline);
+            vEDFHeapInsert(&xTCBBlockedList[xCore], &xTCB->xTCBHeapItem);
+        }
+        edfEXIT_CORE_CRITICAL(xCore);
+
+        if (xTCB == currentRunningTask)
+        {
+            currentRunningTask = NULL;
+        }
+    }
+
+    currentRunningTask = EDFPreemptionDecision(xCore, currentRunningTask);
+    if ((event == SWITCH_ON_READY) && (xTCB != currentRunningTask))
+    {
+        // the running job is earlier, the released one waits in the ready list
+        xTCB->xPriority = BLOCKED_TASK_PRIO;
+        vTaskPrioritySet(NULL, BLOCKED_TASK_PRIO);
+    }
+    currentRunningTaskOfCore[xCore] = currentRunningTask;
+    traceEDF_SCHEDULER_DONE(event);
+
+    #if USE_EDF_TICKLESS == 1
+    EDFArmEventTimer(xCore);
+    #endif
+    (void) xTaskResumeAll();
+}
+#endif
+
+#if USE_GLOBAL_EDF == 1
+static UBaseType_t EDFEarliestTasks(EDFHeap_t * pxHeap, extTCB_t ** pxTasks, UBaseType_t uxMaxNumOfTasks)
+{
+    // best-first walk from the root: the next earliest item is always a child of one already taken, so only
+    // uxMaxNumOfTasks + 1 candidates are compared instead of the whole heap, items come out in heap order
+    UBaseType_t uxCandidates[EDF_NUM_OF_CORES + 1];
+    UBaseType_t uxNumOfCandidates = 0;
+    UBaseType_t uxNumOfTasks = 0;
+    UBaseType_t uxBest;
+    UBaseType_t uxIndex;
+
+    configASSERT(uxMaxNumOfTasks <= EDF_NUM_OF_CORES);
+    if (!heapIS_EMPTY(pxHeap))
+    {
+        uxCandidates[uxNumOfCandidates++] = 0;
+    }
+
+    while ((uxNumOfTasks < uxMaxNumOfTasks) && (uxNumOfCandidates > 0))
+    {
+        uxBest = 0;
+        for (UBaseType_t i = 1; i < uxNumOfCandidates; i++)
+        {
+            if (heapIS_BEFORE(heapGET_ITEM_VALUE(heapGET_ITEM_AT(pxHeap, uxCandidates[i])), heapGET_ITEM_VALUE(heapGET_ITEM_AT(pxHeap, uxCandidates[uxBest]))) == pdTRUE)
+            {
+                uxBest = i;
+            }
+        }
+        uxIndex = uxCandidates[uxBest];
+        uxCandidates[uxBest] = uxCandidates[--uxNumOfCandidates];
+        pxTasks[uxNumOfTasks++] = heapGET_ITEM_OWNER(heapGET_ITEM_AT(pxHeap, uxIndex));
+
+        for (UBaseType_t uxChild = (uxIndex << 1) + 1; (uxChild <= (uxIndex << 1) + 2) && (uxChild < heapCURRENT_LENGTH(pxHeap)); uxChild++)
+        {
+            uxCandidates[uxNumOfCandidates++] = uxChild;
+        }
+    }
+    return uxNumOfTasks;
+}
+
+static BaseType_t EDFIsInTaskSet(extTCB_t * xTCB, extTCB_t ** pxTasks, UBaseType_t uxNumOfTasks)
+{
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        if (pxTasks[i] == xTCB)
+        {
+            return pdTRUE;
+        }
+    }
+    return pdFALSE;
+}
+
+static void EDFGlobalDropStoppedTasks()
+{
+    // jobs that blocked, were suspended or were deleted in this pass no longer hold a core
+    UBaseType_t uxNumOfKept = 0;
+
+    for (UBaseType_t i = 0; i < uxNumOfGlobalRunningTasks; i++)
+    {
+        if ((xGlobalRunningTasks[i]->cTaskHandle != NULL) & (xGlobalRunningTasks[i]->xPriority >= DISPATCHED_TASK_PRIO))
+        {
+            xGlobalRunningTasks[uxNumOfKept++] = xGlobalRunningTasks[i];
+        }
+    }
+    uxNumOfGlobalRunningTasks = uxNumOfKept;
+}
+
+static UBaseType_t EDFTakeSwitchedOutTasks(extTCB_t ** xTCBsToFree, UBaseType_t uxNumOfTCBsToFree)
+{
+    // a deleted task is not switched in again, once its switch out hook is done nothing but its signals refers to it
+    UBaseType_t i = 0;
+
+    while (i < uxNumOfDeletedRunningTasks)
+    {
+        if (((volatile extTCB_t *)xDeletedRunningTasks[i])->xSwitchedInTime == edfNOT_SWITCHED_IN)
+        {
+            xTCBsToFree[uxNumOfTCBsToFree++] = xDeletedRunningTasks[i];
+            xDeletedRunningTasks[i] = xDeletedRunningTasks[--uxNumOfDeletedRunningTasks];
+        }
+        else
+        {
+            i++;
+        }
+    }
+    return uxNumOfTCBsToFree;
+}
+
+static void EDFGlobalDispatch()
+{
+    // give a core to each of the EDF_NUM_OF_CORES earliest jobs of the ready queue, FreeRTOS runs them on whichever
+    // cores are free, so a preempted job migrates if another core frees up first
+    extTCB_t * xSelectedTasks[EDF_NUM_OF_CORES];
+    UBaseType_t uxNumOfSelected;
+    extTCB_t * xTCB;
+    UBaseType_t i, j;
+
+    edfENTER_CORE_CRITICAL(0);
+    // all initial tasks are released at the system start, they join the ready queue in the first pass
+    while (!heapIS_EMPTY(&xTCBInitList[0]))
+    {
+        xTCB = heapGET_HEAD_OWNER(&xTCBInitList[0]);
+        xTCB->relArrivalTime = xSysStartTime;
+        xTCB->absDeadline = xSysStartTime + xTCB->relDeadline + xTCB->phase;
+        uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+        heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, edfREADY_KEY(xTCB));
+        vEDFHeapInsert(&xTCBReadyList[0], &xTCB->xTCBHeapItem);
+        edfWATCH_DEADLINE(xTCB);
+    }
+
+    uxNumOfSelected = EDFEarliestTasks(&xTCBReadyList[0], xSelectedTasks, EDF_NUM_OF_CORES);
+
+    // a running job that ties with the last selected one keeps its core, instead of being preempted for an equal deadline
+    for (i = 0; (i < uxNumOfGlobalRunningTasks) & (uxNumOfSelected > 0); i++)
+    {
+        xTCB = xGlobalRunningTasks[i];
+        if ((heapIS_CONTAINED_WITHIN(&xTCBReadyList[0], &xTCB->xTCBHeapItem) == pdFALSE) ||
+            (heapGET_ITEM_VALUE(&xTCB->xTCBHeapItem) != heapGET_ITEM_VALUE(&xSelectedTasks[uxNumOfSelected - 1]->xTCBHeapItem)) ||
+            (EDFIsInTaskSet(xTCB, xSelectedTasks, uxNumOfSelected) == pdTRUE))
+        {
+            continue;
+        }
+        for (j = uxNumOfSelected; (j > 0) && (heapGET_ITEM_VALUE(&xSelectedTasks[j - 1]->xTCBHeapItem) == heapGET_ITEM_VALUE(&xTCB->xTCBHeapItem)); j--)
+        {
+            if (xSelectedTasks[j - 1]->xPriority < DISPATCHED_TASK_PRIO)
+            {
+                xSelectedTasks[j - 1] = xTCB;
+                break;
+            }
+        }
+    }
+    edfEXIT_CORE_CRITICAL(0);
+
+    // jobs kept from the last pass are running by now and move up to RUNNING_TASK_PRIO, newly selected jobs only get
+    // DISPATCHED_TASK_PRIO: FreeRTOS preempts equal priorities when a priority is raised, so a new job must not be able
+    // to displace a kept one, it takes an idle core or the core of a preempted job when that one is lowered
+    for (i = 0; i < uxNumOfSelected; i++)
+    {
+        xTCB = xSelectedTasks[i];
+        if (xTCB->xPriority == DISPATCHED_TASK_PRIO)
+        {
+            xTCB->xPriority = RUNNING_TASK_PRIO;
+            vTaskPrioritySet(xTCB->cTaskHandle, RUNNING_TASK_PRIO);
+        }
+    }
+    // raise the selected jobs before lowering the preempted ones, a core that is given up then switches straight
+    // to a selected job and never runs a job that only has BLOCKED_TASK_PRIO
+    for (i = 0; i < uxNumOfSelected; i++)
+    {
+        xTCB = xSelectedTasks[i];
+        if (xTCB->xPriority < DISPATCHED_TASK_PRIO)
+        {
+            xTCB->xPriority = DISPATCHED_TASK_PRIO;
+            xTCB->status = TASK_RUNNING;
+            vTaskPrioritySet(xTCB->cTaskHandle, DISPATCHED_TASK_PRIO);
+        }
+    }
+    for (i = 0; i < uxNumOfGlobalRunningTasks; i++)
+    {
+        xTCB = xGlobalRunningTasks[i];
+        if (EDFIsInTaskSet(xTCB, xSelectedTasks, uxNumOfSelected) == pdFALSE)
+        {
+            // Change task status to TASK_READY if the job has not completed execution
+            if (xTCB->status == TASK_RUNNING)
+            {
+                xTCB->status = TASK_READY;
+            }
+            xTCB->xPriority = BLOCKED_TASK_PRIO;
+            vTaskPrioritySet(xTCB->cTaskHandle, BLOCKED_TASK_PRIO);
+        }
+    }
+
+    for (i = 0; i < uxNumOfSelected; i++)
+    {
+        xGlobalRunningTasks[i] = xSelectedTasks[i];
+    }
+    uxNumOfGlobalRunningTasks = uxNumOfSelected;
+}
+#endif
+
+static void EDFInsertTaskToReadyList(extTCB_t * xTCB)
+{
+    if (startEDF != pdTRUE)
+    {
+        return;
+    }
+
+    if ((xTCB->status != TASK_READY) & (xTCB->status != TASK_RUNNING))
+    {
+        // FreeRTOS moves tasks to ready state when there is a priority change
+        // To account for this
+        #if USE_WCET_CHECKS == 1
+        if ((xTCB->status == TASK_SUSPENDED) & (xTCB->WCETExceeded == pdTRUE))
+        {
+            return;
+        }
+        #endif
+
+        edfENTER_CORE_CRITICAL(xTCB->xCoreID);
+        #if USE_CBS == 1
+        if (xTCB == &xCBSServerTCB)
+        {
+            EDFCBSArrival(xTaskGetTickCountFromISR());
+        }
+        #endif
+        if (xTCB->status == TASK_BLOCKED)
+        {
+            // a new job is released, the task does not run so nothing is charged meanwhile
+            xTCB->measuredExecTime = 0;
+            xTCB->xReleased = pdTRUE;
+            #if USE_SRP == 1
+            xTCB->xJobStarted = pdFALSE;
+            #endif
+            EDF_TRACE_RELEASE_EVENT(xTCB->xTaskNumber, xTCB->absDeadline);
+        }
+        xTCB->status = TASK_READY;
+        uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+        // key on the deadline of the released job, it may have changed since the task was last queued
+        heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, edfREADY_KEY(xTCB));
+        vEDFHeapInsert(&xTCBReadyList[xTCB->xCoreID], &xTCB->xTCBHeapItem);
+        edfEXIT_CORE_CRITICAL(xTCB->xCoreID);
+        // keyed on the deadline of the job, which is new after a release or a WCET resume
+        edfWATCH_DEADLINE(xTCB);
+
+        #if USE_EDF_INLINE_DISPATCH == 1
+        if (xTCB->xPriority == SCHED_PRIO)
+        {
+            // released above the EDF tasks, it runs next and makes the decision itself (EDFDispatchInline)
+            traceEDF_SCHEDULER_WAKE(SWITCH_ON_READY);
+            return;
+        }
+        #endif
+        // delegate preemption decision to the scheduler, only let the scheduler know that a task has been moved into the ready state
+        EDFSignalScheduler(SWITCH_ON_READY, xTCB);
+    }
+}
+
+static BaseType_t EDFSchedulabilityCheck(BaseType_t xCore, TickType_t period, TickType_t relDeadline, TickType_t WCET, TickType_t * slack)
+{
+    // check task schedulability on a core based on FreeRTOS Ticks, pdTRUE once admitted or the result of the test
+    // Use WCET passed as task param to calculate this
+    EDFUtilization_t Up;
+    BaseType_t xAdmitted;
+
+    Up = Up_accepted[xCore] + edfUTILIZATION(WCET, period);
+    #if USE_TBS == 1
+    // TBS deadlines are computed from the bandwidth the periodic tasks leave, keep at least 1 - UP_LIMIT of it
+    if (Up > UP_LIMIT)
+    {
+        *slack = 0;
+        return pdFALSE;
+    }
+    #endif
+
+    #if USE_GLOBAL_EDF == 1
+    // GFB or BCL test for all cores, both are only sufficient and have no slack to report
+    *slack = 0;
+    xAdmitted = xEDFGlobalAdmissionAdd(WCET, period, relDeadline);
+    #else
+    // exact processor demand test, constrained deadlines included
+    xAdmitted = xEDFAdmissionAdd(xCore, WCET, period, relDeadline, slack);
+    #endif
+    if (xAdmitted != pdTRUE)
+    {
+        return xAdmitted;
+    }
+
+    Up_accepted[xCore] = Up;
+    // also called while the scheduler runs, with global EDF run queue 0 holds the utilization of all cores
+    EDF_LOG_INFO(EDF_LOG_TASK_ADMITTED, xCore, edfUTIL_TO_PERMILLE(Up_accepted[xCore]), *slack, 0);
+    return pdTRUE;
+}
+
+static void EDFReleaseUtilization(BaseType_t xCore, TickType_t period, TickType_t relDeadline, TickType_t WCET)
+{
+    // undoes the admission of a task by EDFSchedulabilityCheck
+    #if USE_GLOBAL_EDF == 1
+    xEDFGlobalAdmissionRemove(WCET, period, relDeadline);
+    #else
+    xEDFAdmissionRemove(xCore, WCET, period, relDeadline);
+    #endif
+    Up_accepted[xCore] -= edfUTILIZATION(WCET, period);
+}
+
+static BaseType_t EDFAdmitTask(TickType_t period, TickType_t relDeadline, TickType_t WCET, BaseType_t xRetire)
+{
+    // core of the fit order that admits the task, -1 if none does. With xRetire only the cores with removed tasks
+    // are tried, and the utilization of those tasks is only freed on the core that admits the task
+    #if EDF_NUM_OF_RUN_QUEUES > 1
+    BaseType_t xCores[EDF_NUM_OF_RUN_QUEUES];
+    EDFFitOrder(xCores);
+    #else
+    BaseType_t xCores[1] = {0};
+    #endif
+    TickType_t slack;
+
+    for (BaseType_t i = 0; i < EDF_NUM_OF_RUN_QUEUES; i++)
+    {
+        if (xRetire == pdTRUE)
+        {
+            if (EDFAdmitsAfterRetiring(xCores[i], period, relDeadline, WCET) == pdFALSE)
+            {
+                continue;
+            }
+            EDFRetireRemovedTasks(xCores[i], pdTRUE);
+        }
+        if (EDFSchedulabilityCheck(xCores[i], period, relDeadline, WCET, &slack) == pdTRUE)
+        {
+            return xCores[i];
+        }
+    }
+    return -1;
+}
+
+static UBaseType_t EDFRetireRemovedTasks(BaseType_t xCore, BaseType_t xForce)
+{
+    // frees the utilization of the removed tasks of a core (of every core for -1) whose last deadline has passed, with
+    // xForce of all of them, the core then releases the tasks added next only after those deadlines
+    EDFTaskRecord_t * pxRecord;
+    TickType_t xCurTick = xTaskGetTickCount();
+    UBaseType_t uxNumOfRetired = 0;
+
+    for (BaseType_t i = 0; i < MAX_NUM_OF_PERIODIC_TASKS; i++)
+    {
+        pxRecord = &xTaskRecords[i];
+        if ((__atomic_load_n(&pxRecord->xState, __ATOMIC_ACQUIRE) != EDF_RECORD_RETIRING) || ((xCore >= 0) && (pxRecord->xCoreID != xCore)))
+        {
+            continue;
+        }
+        if (((long int)pxRecord->xLastDeadline - (long int)xCurTick) > 0)
+        {
+            if (xForce == pdFALSE)
+            {
+                continue;
+            }
+            if (((long int)pxRecord->xLastDeadline - (long int)xSafeReleaseTime[pxRecord->xCoreID]) > 0)
+            {
+                xSafeReleaseTime[pxRecord->xCoreID] = pxRecord->xLastDeadline;
+            }
+        }
+
+        EDFReleaseUtilization(pxRecord->xCoreID, pxRecord->period, pxRecord->relDeadline, pxRecord->WCET);
+        xNoOfPeriodicTasks--;
+        pxRecord->xState = EDF_RECORD_FREE;
+        uxNumOfRetired++;
+    }
+    return uxNumOfRetired;
+}
+
+static BaseType_t EDFAdmitsAfterRetiring(BaseType_t xCore, TickType_t period, TickType_t relDeadline, TickType_t WCET)
+{
+    // pdTRUE if the core admits the task once all of its removed tasks are retired, tested on a copy of its task set
+    // so that nothing is freed yet. pdFALSE as well if the core has no removed task
+    EDFTaskRecord_t * pxRecord;
+    UBaseType_t uxNumOfRetiring = 0;
+    #if USE_TBS == 1
+    EDFUtilization_t Up = Up_accepted[xCore] + edfUTILIZATION(WCET, period);
+    #endif
+
+    vEDFAdmissionTrialBegin(xCore);
+    for (BaseType_t i = 0; i < MAX_NUM_OF_PERIODIC_TASKS; i++)
+    {
+        pxRecord = &xTaskRecords[i];
+        if ((__atomic_load_n(&pxRecord->xState, __ATOMIC_ACQUIRE) == EDF_RECORD_RETIRING) && (pxRecord->xCoreID == xCore))
+        {
+            (void) xEDFAdmissionTrialRemove(pxRecord->WCET, pxRecord->period, pxRecord->relDeadline);
+            #if USE_TBS == 1
+            Up -= edfUTILIZATION(pxRecord->WCET, pxRecord->period);
+            #endif
+            uxNumOfRetiring++;
+        }
+    }
+    if (uxNumOfRetiring == 0)
+    {
+        return pdFALSE;
+    }
+    #if USE_TBS == 1
+    if (Up > UP_LIMIT)
+    {
+        return pdFALSE;
+    }
+    #endif
+    return (xEDFAdmissionTrialTest(WCET, period, relDeadline) == pdTRUE) ? pdTRUE : pdFALSE;
+}
+
+static BaseType_t EDFRetainUtilization(extTCB_t * xTCB)
+{
+    // a periodic task being removed stays admitted until the deadline of its last job, pdFALSE if it is no periodic
+    // task or on its way out already. Called before the task is deleted, from its scheduler or from the API
+    EDFTaskRecord_t * pxRecord;
+    EDFRecordState_t xInUse = EDF_RECORD_IN_USE;
+    TickType_t xLastDeadline;
+
+    if ((xTCB->xTaskNumber < TASK_NUM_START) || (xTCB->xTaskNumber >= TASK_NUM_START + MAX_NUM_OF_PERIODIC_TASKS))
+    {
+        return pdFALSE;
+    }
+    pxRecord = &xTaskRecords[xTCB->xTaskNumber - TASK_NUM_START];
+    if (__atomic_compare_exchange_n(&pxRecord->xState, &xInUse, EDF_RECORD_REMOVING, pdFALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == pdFALSE)
+    {
+        return pdFALSE;
+    }
+
+    edfENTER_CORE_CRITICAL(xTCB->xCoreID);
+    if (heapIS_CONTAINED_WITHIN(&xTCBInitList[xTCB->xCoreID], &xTCB->xTCBHeapItem))
+    {
+        // the first job was released at the system start, the scheduler has not taken it over yet
+        xLastDeadline = xSysStartTime + xTCB->phase + xTCB->relDeadline;
+    }
+    else if (xTCB->status == TASK_BLOCKED)
+    {
+        // the last job has completed, absDeadline is the one of the next job already
+        xLastDeadline = xTCB->absDeadline - xTCB->period;
+    }
+    else
+    {
+        xLastDeadline = xTCB->absDeadline;
+    }
+    edfEXIT_CORE_CRITICAL(xTCB->xCoreID);
+
+    pxRecord->WCET = xTCB->WCET;
+    pxRecord->period = xTCB->period;
+    pxRecord->relDeadline = xTCB->relDeadline;
+    pxRecord->xCoreID = xTCB->xCoreID;
+    pxRecord->xLastDeadline = xLastDeadline;
+    __atomic_store_n(&pxRecord->xState, EDF_RECORD_RETIRING, __ATOMIC_RELEASE);
+    return pdTRUE;
+}
+
+static void EDFDeleteTask(BaseType_t xCore, extTCB_t * xTCB)
+{
+    // called by the scheduler of the core, the task is deleted first so that no hook can queue it again
+    (void) xCore;
+    vTaskDelete(xTCB->cTaskHandle);
+    xTCB->cTaskHandle = NULL;
+    edfENTER_CORE_CRITICAL(xCore);
+    uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+    #if USE_SRP == 1
+    // whatever it still holds is given back, the decision of this pass already sees the lower ceiling
+    EDFSRPRelease(xCore, xTCB, NULL);
+    #endif
+    edfEXIT_CORE_CRITICAL(xCore);
+    edfUNWATCH_DEADLINE(xTCB);
+}
+
+#if configUSE_EDF == 0
+static UBaseType_t EDFQueueTCBToFree(extTCB_t * xTCB, extTCB_t ** xTCBsToFree, UBaseType_t uxNumOfTCBsToFree)
+{
+    // called by the scheduler after EDFDeleteTask. Under global EDF the task can still run on another core until it is
+    // switched out there, the switch out hook then still uses its extended TCB
+    #if USE_GLOBAL_EDF == 1
+    if (((volatile extTCB_t *)xTCB)->xSwitchedInTime != edfNOT_SWITCHED_IN)
+    {
+        xDeletedRunningTasks[uxNumOfDeletedRunningTasks++] = xTCB;
+        return uxNumOfTCBsToFree;
+    }
+    #endif
+    xTCBsToFree[uxNumOfTCBsToFree] = xTCB;
+    return uxNumOfTCBsToFree + 1;
+}
+
+static void EDFReleaseDueJob(extTCB_t * xTCB)
+{
+    // called by the task itself, which runs on, so its execution time starts over now. The scheduler is told that its
+    // deadline has moved, like on any other release
+    edfENTER_CORE_CRITICAL(xTCB->xCoreID);
+    #if USE_EDF_INLINE_DISPATCH == 1
+    // the task was blocked by its own pass already and decides about the new job in the next one
+    xTCB->status = TASK_READY;
+    #if USE_SRP == 1
+    xTCB->xJobStarted = pdFALSE;
+    #endif
+    #endif
+    xTCB->measuredExecTime = 0;
+    if (xTCB->xSwitchedInTime != edfNOT_SWITCHED_IN)
+    {
+        xTCB->xSwitchedInTime = edfCLOCK_US();
+    }
+    uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+    heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, edfREADY_KEY(xTCB));
+    vEDFHeapInsert(&xTCBReadyList[xTCB->xCoreID], &xTCB->xTCBHeapItem);
+    edfEXIT_CORE_CRITICAL(xTCB->xCoreID);
+    edfWATCH_DEADLINE(xTCB);
+    EDF_TRACE_RELEASE_EVENT(xTCB->xTaskNumber, xTCB->absDeadline);
+
+    #if USE_EDF_INLINE_DISPATCH == 0
+    EDFSignalScheduler(SWITCH_ON_READY, xTCB);
+    #endif
+}
+#endif
+
+#if USE_WCET_CHECKS == 1 || USE_DEADLINE_CHECKS == 1
+// ************************* Job Policies ***************************** //
+static EDFJobPolicy_t EDFSelectJobPolicy(extTCB_t * xTCB, EDFJobEvent_t xEvent)
+{
+    // the action for this job, TBS workers and tasks created without a policy take the default
+    EDFJobPolicy_t xPolicy = (xEvent == EDF_EVENT_OVERRUN) ? xTCB->xPolicy.xOverrunPolicy : xTCB->xPolicy.xMissPolicy;
+    UBaseType_t uxMet = 0;
+
+    if ((xPolicy == EDF_POLICY_CALLBACK) && (xTCB->xPolicy.pxCallback != NULL))
+    {
+        xPolicy = xTCB->xPolicy.pxCallback(xTCB->cTaskHandle, xEvent, xTCB->instanceParams);
+    }
+
+    if ((xPolicy == EDF_POLICY_MK_FIRM) && (edfPOLICY_SUPPORTED(EDF_POLICY_ABORT_JOB) == pdTRUE))
+    {
+        // the job counts as missed, it is dropped as long as m of the last k jobs, itself included, still met theirs
+        for (UBaseType_t i = 1; i < xTCB->xPolicy.uxK; i++)
+        {
+            uxMet += (xTCB->ulJobHistory >> (i - 1)) & 1;
+        }
+        xPolicy = (uxMet >= xTCB->xPolicy.uxM) ? EDF_POLICY_ABORT_JOB : EDF_POLICY_FINISH_LATE;
+    }
+    #if (USE_GLOBAL_EDF == 1) && (USE_STATIC_ALLOCATION == 1)
+    if ((xPolicy == EDF_POLICY_ABORT_JOB) && (xTCB->status == TASK_RUNNING))
+    {
+        // it may run on another core, which only deletes it once it switches, so its buffer cannot be used again now
+        xPolicy = EDF_POLICY_FINISH_LATE;
+    }
+    #elif USE_STATIC_ALLOCATION == 0
+    if ((xPolicy == EDF_POLICY_ABORT_JOB) && (xTCB->status == TASK_BLOCKED))
+    {
+        // suspending it would end the wait it is in within its job
+        xPolicy = EDF_POLICY_FINISH_LATE;
+    }
+    #endif
+    if ((xPolicy == EDF_POLICY_CALLBACK) || (xPolicy == EDF_POLICY_MK_FIRM) || (edfPOLICY_SUPPORTED(xPolicy) == pdFALSE))
+    {
+        // no callback, or one that returned a policy this build cannot apply: the job still goes on
+        xPolicy = EDF_POLICY_FINISH_LATE;
+    }
+    return xPolicy;
+}
+
+static BaseType_t EDFApplyJobPolicy(BaseType_t xCore, extTCB_t * xTCB, EDFJobPolicy_t xPolicy, EDFJobEvent_t xEvent)
+{
+    // every policy but the default, pdTRUE if the job goes on
+    TickType_t xCurTick = xTaskGetTickCount();
+    TickType_t xRelease;
+
+    if (xPolicy == EDF_POLICY_ABORT_JOB)
+    {
+        // the first release of the task that has not passed yet
+        xRelease = xTCB->relArrivalTime + xTCB->period;
+        if (((long int)xRelease - (long int)xCurTick) < 0)
+        {
+            xRelease += ((xCurTick - xRelease + xTCB->period - 1) / xTCB->period) * xTCB->period;
+        }
+        xTCB->ulJobHistory <<= 1;
+        EDF_LOG_INFO(EDF_LOG_JOB_ABORTED, xTCB->xTaskNumber, xCurTick, xRelease, 0);
+        #if USE_STATIC_ALLOCATION == 1
+        EDFRestartTask(xCore, xTCB, xRelease);
+        #elif USE_WCET_CHECKS == 1
+        EDFSuspendAbortedJob(xCore, xTCB, xRelease);
+        #endif
+        return pdFALSE;
+    }
+
+    // EDF_POLICY_SKIP_NEXT and EDF_POLICY_FINISH_LATE, the job gets the deadline of one more period. When skipping, the
+    // wrapper releases the job after next. The arrival is left alone, vTaskDelayUntil takes it for a past time
+    xTCB->absDeadline += xTCB->period;
+    if (xPolicy == EDF_POLICY_SKIP_NEXT)
+    {
+        xTCB->xSkipRelease = pdTRUE;
+    }
+
+    #if USE_WCET_CHECKS == 1
+    if (xEvent == EDF_EVENT_OVERRUN)
+    {
+        // and another WCET, the check suspended it but it is still on its core
+        xTCB->measuredExecTime -= edfTICKS_TO_US(xTCB->WCET);
+        xTCB->WCETExceeded = pdFALSE;
+        xTCB->status = TASK_RUNNING;
+    }
+    #endif
+    #if USE_DEADLINE_CHECKS == 1
+    xTCB->deadlineExceeded = pdFALSE;
+    #endif
+    (void)xEvent;
+
+    edfENTER_CORE_CRITICAL(xCore);
+    if (heapIS_CONTAINED_WITHIN(&xTCBReadyList[xCore], &xTCB->xTCBHeapItem))
+    {
+        vEDFHeapUpdateValue(&xTCB->xTCBHeapItem, edfREADY_KEY(xTCB));
+    }
+    else if (heapIS_CONTAINED_WITHIN(&xTCBBlockedList[xCore], &xTCB->xTCBHeapItem))
+    {
+        vEDFHeapUpdateValue(&xTCB->xTCBHeapItem, xTCB->absDeadline);
+    }
+    edfEXIT_CORE_CRITICAL(xCore);
+    edfWATCH_DEADLINE(xTCB);
+
+    EDF_LOG_INFO(EDF_LOG_JOB_EXTENDED, xTCB->xTaskNumber, xCurTick, xTCB->absDeadline, 0);
+    return pdTRUE;
+}
+
+#if USE_STATIC_ALLOCATION == 1
+static void EDFRestartTask(BaseType_t xCore, extTCB_t * xTCB, TickType_t xRelease)
+{
+    // a job cannot be unwound, so the task starts over in the task buffer and stack it had and keeps its handle. It
+    // hands itself to the scheduler like a task added at runtime, which releases it at xRelease. No other task of the
+    // core runs before it is back
+    BaseType_t xCreated;
+
+    vTaskSuspendAll();
+    EDFDeleteTask(xCore, xTCB);
+
+    xTCB->phase = xRelease - xSysStartTime;
+    xTCB->relArrivalTime = xRelease;
+    xTCB->absDeadline = xRelease + xTCB->relDeadline;
+    xTCB->measuredExecTime = 0;
+    xTCB->xSwitchedInTime = edfNOT_SWITCHED_IN;
+    #if USE_WCET_CHECKS == 1
+    xTCB->WCETExceeded = pdFALSE;
+    #endif
+    #if USE_DEADLINE_CHECKS == 1
+    xTCB->deadlineExceeded = pdFALSE;
+    #endif
+    xTCB->xPriority = BLOCKED_TASK_PRIO;
+    xTCB->status = TASK_BLOCKED;
+    xTCB->xSkipRelease = pdFALSE;
+    #if USE_SRP == 1
+    xTCB->xJobStarted = pdFALSE;
+    #endif
+    #if USE_EDF_TASK_STATS == 1
+    // the statistics go on, the aborted job is not counted as completed
+    xTCB->xJobRunning = pdFALSE;
+    xTCB->xSwitchedOutCore = -1;
+    #endif
+    xTCB->xAddedOnline = pdTRUE;
+
+    // the buffers are given, so the creation cannot fail
+    xCreated = xEDFCreateTask(xTCB, EDFPeriodicWrapper, xTCB->taskName, xTCB->stackSize, (void *) xTCB, SCHED_PRIO, &(xTCB->cTaskHandle));
+    configASSERT(xCreated == pdPASS);
+    (void)xCreated;
+    vTaskSetTaskNumber(xTCB->cTaskHandle, xTCB->xTaskNumber);
+    (void) xTaskResumeAll();
+}
+#elif USE_WCET_CHECKS == 1
+static void EDFSuspendAbortedJob(BaseType_t xCore, extTCB_t * xTCB, TickType_t xRelease)
+{
+    // without the pools the task cannot start over, it gives up its core and is suspended until xRelease like after a
+    // WCET overrun. The rest of the job then runs as the job of that release, whose own job is dropped
+    xTCB->WCETExceeded = pdTRUE;
+    xTCB->status = TASK_SUSPENDED;
+    xTCB->nextUnblockTime = xRelease;
+    #if USE_DEADLINE_CHECKS == 1
+    xTCB->deadlineExceeded = pdFALSE;
+    #endif
+    edfENTER_CORE_CRITICAL(xCore);
+    uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+    heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, xTCB->nextUnblockTime);
+    vEDFHeapInsert(&xTCBWCETWakeList[xCore], &xTCB->xTCBHeapItem);
+    edfEXIT_CORE_CRITICAL(xCore);
+    EDFUpdateWCETWakeUp(xCore);
+    edfUNWATCH_DEADLINE(xTCB);
+
+    xTCB->measuredExecTime = 0;
+    xTCB->xPriority = BLOCKED_TASK_PRIO;
+    vTaskPrioritySet(xTCB->cTaskHandle, BLOCKED_TASK_PRIO);
+    vTaskSuspend(xTCB->cTaskHandle);
+}
+#endif
+// ******************************************************************* //
+#endif
+
+#if USE_SRP == 1
+// ********************* Stack Resource Policy *********************** //
+static extTCB_t * EDFSRPEarliestTask(BaseType_t xCore)
+{
+    // earliest deadline job of the ready queue that may run under the system ceiling, walked best-first from the root
+    // like EDFEarliestTasks. Jobs that have started always may, so the holders of the locked resources are found.
+    // Called with the lock of the core held, NULL if no job may run
+    static UBaseType_t uxCandidatesOfCore[EDF_NUM_OF_RUN_QUEUES][TOTAL_NUM_OF_TASKS];
+    UBaseType_t * uxCandidates = uxCandidatesOfCore[xCore];
+    EDFHeap_t * pxHeap = &xTCBReadyList[xCore];
+    UBaseType_t uxNumOfCandidates = 0;
+    UBaseType_t uxBest;
+    UBaseType_t uxIndex;
+    extTCB_t * xTCB;
+
+    if (!heapIS_EMPTY(pxHeap))
+    {
+        uxCandidates[uxNumOfCandidates++] = 0;
+    }
+
+    while (uxNumOfCandidates > 0)
+    {
+        uxBest = 0;
+        for (UBaseType_t i = 1; i < uxNumOfCandidates; i++)
+        {
+            if (heapIS_BEFORE(heapGET_ITEM_VALUE(heapGET_ITEM_AT(pxHeap, uxCandidates[i])), heapGET_ITEM_VALUE(heapGET_ITEM_AT(pxHeap, uxCandidates[uxBest]))) == pdTRUE)
+            {
+                uxBest = i;
+            }
+        }
+        uxIndex = uxCandidates[uxBest];
+        uxCandidates[uxBest] = uxCandidates[--uxNumOfCandidates];
+        xTCB = heapGET_ITEM_OWNER(heapGET_ITEM_AT(pxHeap, uxIndex));
+        if (edfSRP_MAY_RUN(xCore, xTCB))
+        {
+            return xTCB;
+        }
+
+        for (UBaseType_t uxChild = (uxIndex << 1) + 1; (uxChild <= (uxIndex << 1) + 2) && (uxChild < heapCURRENT_LENGTH(pxHeap)); uxChild++)
+        {
+            uxCandidates[uxNumOfCandidates++] = uxChild;
+        }
+    }
+    return NULL;
+}
+
+static void EDFSRPRelease(BaseType_t xCore, extTCB_t * xTCB, EDFResource_t * pxResource)
+{
+    // gives back pxResource, or every resource of xTCB for NULL, and sets the system ceiling to the shortest ceiling
+    // still locked. Called with the lock of the core held, an unlock in LIFO order finds its resource at the head
+    EDFResource_t ** ppxLocked = &pxSRPLocked[xCore];
+
+    xSystemCeiling[xCore] = portMAX_DELAY;
+    while (*ppxLocked != NULL)
+    {
+        if (((*ppxLocked)->pxHolder == xTCB) && ((pxResource == NULL) || (*ppxLocked == pxResource)))
+        {
+            (*ppxLocked)->pxHolder = NULL;
+            *ppxLocked = (*ppxLocked)->pxNext;
+            continue;
+        }
+        if ((*ppxLocked)->xCeiling < xSystemCeiling[xCore])
+        {
+            xSystemCeiling[xCore] = (*ppxLocked)->xCeiling;
+        }
+        ppxLocked = &(*ppxLocked)->pxNext;
+    }
+}
+// ******************************************************************* //
+#endif
+
+static extTCB_t * EDFNewPeriodicTCB(const char* taskName, int stackSize, void (*instanceFunc)(void*), TickType_t period, TickType_t relDeadline, TickType_t phase, void *instanceParams, TickType_t WCET, BaseType_t xTaskNumber, const EDFTaskPolicy_t * pxPolicy)
+{
+    extTCB_t * taskNode = pxEDFAllocTCB();
+
+    if (taskNode == NULL)
+    {
+        printf("Could not allocate Memory......\n");
+        return NULL;
+    }
+
+    taskNode->taskName = taskName;
+    taskNode->instanceFunc = instanceFunc;
+    taskNode->instanceParams = instanceParams;
+    taskNode->measuredExecTime = 0;
+    taskNode->xSwitchedInTime = edfNOT_SWITCHED_IN;
+    taskNode->WCET = WCET;
+    taskNode->period = period;
+    taskNode->phase = phase;
+    taskNode->relDeadline = relDeadline;
+    taskNode->absDeadline = taskNode->phase + taskNode->relDeadline;// temporary abs deadline to sort tasks
+    taskNode->xTaskNumber = xTaskNumber;
+    #if USE_TBS == 1
+    taskNode->isPeriodic = pdTRUE;
+    #endif
+    taskNode->cTaskHandle = NULL;
+    taskNode->pxHandle = NULL;
+    taskNode->stackSize = stackSize;
+    #if USE_WCET_CHECKS == 1
+    taskNode->WCETExceeded = pdFALSE;
+    #endif
+
+    #if USE_DEADLINE_CHECKS == 1
+    taskNode->deadlineExceeded = pdFALSE;
+    #endif
+
+    taskNode->xPriority = BLOCKED_TASK_PRIO;
+    taskNode->status = TASK_BLOCKED;
+    taskNode->xAddedOnline = pdFALSE;
+    taskNode->xReleased = pdFALSE;
+    taskNode->xSkipRelease = pdFALSE;
+    #if USE_SRP == 1
+    taskNode->xJobStarted = pdFALSE;
+    #endif
+    if (pxPolicy != NULL)
+    {
+        configASSERT((pxPolicy->uxK <= 32) & (pxPolicy->uxM <= pxPolicy->uxK));
+        taskNode->xPolicy = *pxPolicy;
+    }
+    else
+    {
+        memset(&taskNode->xPolicy, 0, sizeof(EDFTaskPolicy_t));
+    }
+    // the jobs before the first one count as met
+    taskNode->ulJobHistory = UINT32_MAX;
+    edfINIT_STATS(taskNode);
+    taskNode->xCoreID = 0;
+    #if USE_GLOBAL_EDF_US == 1
+    taskNode->xTopPriority = xEDFGlobalIsTopPriority(taskNode->WCET, taskNode->relDeadline);
+    #endif
+    return taskNode;
+}
+
+#if EDF_NUM_OF_RUN_QUEUES > 1
+static void EDFFitOrder(BaseType_t * xCores)
+{
+    // cores in the order a task is tried on, insertion sort that keeps equally utilized cores in numeric order
+    BaseType_t j;
+
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+    {
+        for (j = xCore; (j > 0) && edfFIT_BEFORE(xCore, xCores[j - 1]); j--)
+        {
+            xCores[j] = xCores[j - 1];
+        }
+        xCores[j] = xCore;
+    }
+}
+
+static EDFUtilization_t EDFPlacementUtilization(extTCB_t * xTCB)
+{
+    return edfUTILIZATION(xTCB->WCET, xTCB->period);
+}
+
+static void EDFPartitionTasks()
+{
+    // bin-packing in decreasing utilization: every periodic task goes to the first core of the fit order whose
+    // exact admission test accepts it
+    extTCB_t * xTCB;
+    BaseType_t xCore;
+    UBaseType_t j;
+
+    // insertion sort, stable so that tasks of equal utilization keep their creation order
+    for (UBaseType_t uxTCBIndex = 1; uxTCBIndex < uxNumOfTCBsToPlace; uxTCBIndex++)
+    {
+        xTCB = xTCBsToPlace[uxTCBIndex];
+        for (j = uxTCBIndex; (j > 0) && (EDFPlacementUtilization(xTCBsToPlace[j - 1]) < EDFPlacementUtilization(xTCB)); j--)
+        {
+            xTCBsToPlace[j] = xTCBsToPlace[j - 1];
+        }
+        xTCBsToPlace[j] = xTCB;
+    }
+
+    for (UBaseType_t uxTCBIndex = 0; uxTCBIndex < uxNumOfTCBsToPlace; uxTCBIndex++)
+    {
+        xTCB = xTCBsToPlace[uxTCBIndex];
+
+        xCore = EDFAdmitTask(xTCB->period, xTCB->relDeadline, xTCB->WCET, pdFALSE);
+        if (xCore < 0)
+        {
+            printf("Task \"%s\" Failed schedulability check on every core!!\n", xTCB->taskName);
+            xTaskRecords[xTCB->xTaskNumber - TASK_NUM_START].xState = EDF_RECORD_FREE;
+            xNoOfPeriodicTasks--;
+            vEDFFreeTCB(xTCB);
+            continue;
+        }
+        xTCB->xCoreID = xCore;
+        printf("Task \"%s\" placed on core %d\n", xTCB->taskName, (int) xTCB->xCoreID);
+        addTCBToList(xTCB);
+    }
+    uxNumOfTCBsToPlace = 0;
 }
+#endif
 
-static void EDFInsertTaskToReadyList(extTCB_t * xTCB)
+#if USE_TBS == 0
+static void EDFWakeAperiodicServer(BaseType_t * pxHigherPriorityTaskWoken)
 {
-    if (startEDF != pdTRUE)
+    if ((startEDF == pdTRUE) & (EDFAperiodicServerHandle != NULL))
     {
+        if (xTaskResumeFromISR(EDFAperiodicServerHandle) == pdTRUE)
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
         return;
     }
+}
 
-    if ((xTCB->status != TASK_READY) & (xTCB->status != TASK_RUNNING))
+static BaseType_t EDFAperiodicJobDue()
+{
+    // the declared jobs are served in the order they were created, as their arrival times are expected to be
+    if (aperiodicJobPointer >= xNoOfAperiodicTasks)
     {
-        // FreeRTOS moves tasks to ready state when there is a priority change
-        // To account for this
-        #if USE_WCET_CHECKS == 1
-        if ((xTCB->status == TASK_SUSPENDED) & (xTCB->WCETExceeded == pdTRUE))
-        {
-            return;
-        }
-        #endif
-
-        xTCB->status = TASK_READY;
-        uxListRemove(&xTCB->xTCBListItem);
-        vListInsert(xTCBReadyList, &xTCB->xTCBListItem);
+        return pdFALSE;
+    }
+    if (((long int)(aperiodicTCBQueue[aperiodicJobPointer]->phase + xSysStartTime) - (long int)xTaskGetTickCountFromISR()) > 0)
+    {
+        return pdFALSE;
+    }
+    return pdTRUE;
+}
+#else
+static void EDFTBSAdmitArrivals()
+{
+    // every job is handed to an idle worker with its TBS deadline from the arrival on, on the core whose server has
+    // the most bandwidth among the cores with an idle worker. Jobs stay queued while every worker is busy
+    EDFAperiodicJob_t xJob;
+    extTCB_t * xTCB;
+    BaseType_t xCore;
 
-        // delegate preemption decision to the scheduler, only let the scheduler know that a task has been moved into the ready state
-        if (xTCBToReady == NULL)
-        {
-            xTCBToReady = xTCB;
-            EDFWakeScheduler(SWITCH_ON_READY);
-        }
-        else
+    for (;;)
+    {
+        xCore = -1;
+        for (BaseType_t i = 0; i < EDF_NUM_OF_RUN_QUEUES; i++)
         {
-            if (xTCBToReady->absDeadline > xTCB->absDeadline)
+            if ((__atomic_load_n(&uxNumOfTBSIdleWorkers[i], __ATOMIC_RELAXED) > 0) && ((xCore < 0) || (Up_accepted[i] < Up_accepted[xCore])))
             {
-                xTCBToReady = xTCB;
-                EDFWakeScheduler(SWITCH_ON_READY);
+                xCore = i;
             }
         }
+        if ((xCore < 0) || (xEDFArrivalReceive(&xJob) == pdFALSE))
+        {
+            return;
+        }
+
+        edfENTER_CORE_CRITICAL(xCore);
+        xTCB = xTBSIdleWorkers[xCore][--uxNumOfTBSIdleWorkers[xCore]];
+        edfEXIT_CORE_CRITICAL(xCore);
+
+        // deadlines of the server are counted from the system start
+        d_k[xCore] = EDFTBSDeadline(xCore, xJob.arrivalTime - xSysStartTime, xJob.WCET);
+
+        xTCB->taskName = xJob.taskName;
+        xTCB->instanceFunc = xJob.instanceFunc;
+        xTCB->instanceParams = xJob.instanceParams;
+        xTCB->WCET = xJob.WCET;
+        xTCB->measuredExecTime = 0;
+        xTCB->xTaskNumber = xJob.xTaskNumber;
+        xTCB->relArrivalTime = xJob.arrivalTime;
+        xTCB->absDeadline = xSysStartTime + d_k[xCore];
+        xTCB->relDeadline = xTCB->absDeadline - xJob.arrivalTime;
+        xTCB->period = xTCB->relDeadline;
+        #if USE_WCET_CHECKS == 1
+        xTCB->WCETExceeded = pdFALSE;
+        #endif
+        #if USE_DEADLINE_CHECKS == 1
+        xTCB->deadlineExceeded = pdFALSE;
+        #endif
+        vTaskSetTaskNumber(xTCB->cTaskHandle, xTCB->xTaskNumber);
+        // the resume hook queues the worker as ready with the new deadline
+        vTaskResume(xTCB->cTaskHandle);
     }
 }
+#endif
 
-static float EDFSchedulabilityCheck(TickType_t period, TickType_t WCET)
+static BaseType_t EDFSubmitJob(const EDFAperiodicJob_t * pxJob, BaseType_t * pxHigherPriorityTaskWoken)
 {
-    // check task schedulability based on FreeRTOS Ticks
-    // Use WCET passed as task param to calculate this
-    float Up;
+    if (xEDFArrivalSend(pxJob) == pdFALSE)
+    {
+        // backpressure: nothing waits in here, the submitter keeps the job and retries later or drops it
+        EDF_LOG_ERROR(EDF_LOG_APERIODIC_REJECTED, pxJob->arrivalTime, 0, 0, 0);
+        return pdFALSE;
+    }
+
+    #if USE_TBS == 1
+    EDFNotifyScheduler(0, SWITCH_ON_APERIODIC_ARRIVAL, pxHigherPriorityTaskWoken);
+    #else
+    // a server that is just about to suspend itself misses this, the tick hook resumes it on the next tick. Without
+    // the tick hook the scheduler of run queue 0 arms its event timer for the job instead
+    EDFWakeAperiodicServer(pxHigherPriorityTaskWoken);
+    #if USE_EDF_TICKLESS == 1
+    EDFNotifyScheduler(0, SWITCH_ON_EVENT_TIMER, pxHigherPriorityTaskWoken);
+    #endif
+    #endif
+    return pdTRUE;
+}
+
+#if USE_CBS == 1
+static void EDFCBSInit()
+{
+    // the server bandwidth Qs / Ts is admitted on run queue 0 before any periodic task, the server is placed there
+    extTCB_t * xTCB = &xCBSServerTCB;
+    TickType_t slack;
+    BaseType_t xAdmitted;
+
+    memset(xTCB, 0, sizeof(extTCB_t));
+    xTCB->taskName = "Aperiodic Server";
+    xTCB->xSwitchedInTime = edfNOT_SWITCHED_IN;
+    xTCB->WCET = CBS_BUDGET;
+    xTCB->period = CBS_PERIOD;
+    xTCB->relDeadline = CBS_PERIOD;
+    xTCB->xTaskNumber = APERIODIC_SERVER_NUM;
+    xTCB->xPriority = BLOCKED_TASK_PRIO;
+    xTCB->status = TASK_BLOCKED;
+    xTCB->xCoreID = 0;
+    vEDFHeapInitialiseItem(&xTCB->xTCBHeapItem);
+    heapSET_ITEM_OWNER(&xTCB->xTCBHeapItem, xTCB);
+    edfINIT_DEADLINE_ITEM(xTCB);
+    edfINIT_STATS(xTCB);
+    xCBSBudget = 0;
+
+    xAdmitted = EDFSchedulabilityCheck(0, CBS_PERIOD, CBS_PERIOD, CBS_BUDGET, &slack);
+    configASSERT(xAdmitted == pdTRUE);
+}
 
-    Up = Up_accepted + (float) WCET / (float) period;
-    if (Up <= UP_LIMIT)
+static void EDFCBSArrival(TickType_t xArrivalTime)
+{
+    // a job arrives at an idle server: keep the current deadline if the budget left can be served by it at the
+    // server bandwidth, c_s < (d_s - r) * Qs / Ts, otherwise start a new server period, d_s = r + Ts and c_s = Qs.
+    // The server is idle, so what it used of the budget is final
+    extTCB_t * xTCB = &xCBSServerTCB;
+
+    xCBSBudget -= xTCB->measuredExecTime;
+    xTCB->measuredExecTime = 0;
+    if ((((long int)xTCB->absDeadline - (long int)xArrivalTime) <= 0) ||
+        ((xCBSBudget > 0) && (((uint64_t)xCBSBudget * CBS_PERIOD) >= ((uint64_t)edfTICKS_TO_US(xTCB->absDeadline - xArrivalTime) * CBS_BUDGET))))
     {
-        Up_accepted = Up;
-        printf("Current Periodic utilization: %0.2f\n", Up_accepted);
-        
+        xTCB->relArrivalTime = xArrivalTime;
+        xTCB->absDeadline = xArrivalTime + CBS_PERIOD;
+        xCBSBudget = edfTICKS_TO_US(CBS_BUDGET);
     }
-    return Up;
 }
 
-#if USE_TBS == 0
-static void EDFWakeAperiodicServer()
+static void EDFCBSConsumeBudget()
 {
-    if (startEDF == pdTRUE)
+    // checked every tick while the server holds the processor, once the budget is used up it is recharged and the
+    // deadline postponed by one server period, the scheduler then decides whether the server keeps the processor.
+    // What the server ran past the budget before this tick is charged to the new budget
+    extTCB_t * xTCB = &xCBSServerTCB;
+    BaseType_t xCore = xTCB->xCoreID;
+
+    if (xTCB->status != TASK_RUNNING)
+    {
+        return;
+    }
+
+    edfENTER_CORE_CRITICAL(xCore);
+    if (EDFExecTime(xTCB, edfCLOCK_US()) < xCBSBudget)
     {
-        xTaskResumeFromISR(EDFAperiodicServerHandle);
+        edfEXIT_CORE_CRITICAL(xCore);
         return;
     }
+    xCBSBudget += edfTICKS_TO_US(CBS_BUDGET);
+    xTCB->absDeadline += CBS_PERIOD;
+    uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+    heapSET_ITEM_VALUE(&xTCB->xTCBHeapItem, edfREADY_KEY(xTCB));
+    vEDFHeapInsert(&xTCBReadyList[xCore], &xTCB->xTCBHeapItem);
+    edfEXIT_CORE_CRITICAL(xCore);
+
+    EDF_LOG_INFO(EDF_LOG_CBS_POSTPONED, xTCB->absDeadline, xTaskGetTickCountFromISR(), 0, 0);
+    // the server is still in the ready list, the scheduler compares its new deadline with the other ready tasks
+    EDFSignalScheduler(SWITCH_ON_READY, xTCB);
 }
 #endif
 
@@ -851,54 +2412,237 @@ void EDFCreatePeriodicTask(const char* taskName,
                             void *instanceParams, 
                             TickType_t WCETinTicks)
 {
-    configASSERT(xNoOfPeriodicTasks <= MAX_NUM_OF_PERIODIC_TASKS);
+    EDFCreatePeriodicTaskWithPolicy(taskName, stackSize, instanceFunc, timePeriod, relDeadline, phase, handle, instanceParams, WCETinTicks, NULL);
+}
+
+void EDFCreatePeriodicTaskWithPolicy(const char* taskName, 
+                            int stackSize, 
+                            void (*instanceFunc)(void*), 
+                            int timePeriod,
+                            int relDeadline, 
+                            int phase, 
+                            TaskHandle_t *handle, 
+                            void *instanceParams, 
+                            TickType_t WCETinTicks,
+                            const EDFTaskPolicy_t * pxPolicy)
+{
+    configASSERT(xNoOfPeriodicTasks < MAX_NUM_OF_PERIODIC_TASKS);
     configASSERT(relDeadline <= timePeriod);
+    // the task is only created by EDFStartScheduling(), which sets the handle
+    if (handle != NULL)
+    {
+        *handle = NULL;
+    }
+
+    if (!edfTASK_POLICY_SUPPORTED(pxPolicy))
+    {
+        printf("Task \"%s\" not created, EDF_POLICY_ABORT_JOB needs USE_STATIC_ALLOCATION or USE_WCET_CHECKS!!\n", taskName);
+        return;
+    }
 
-    float periodicUtilization = EDFSchedulabilityCheck(timePeriod / portTICK_PERIOD_MS, WCETinTicks);
-    if (periodicUtilization > 1.0f)
+    #if EDF_NUM_OF_RUN_QUEUES == 1
+    TickType_t slack;
+    BaseType_t xAdmitted = EDFSchedulabilityCheck(0, timePeriod / portTICK_PERIOD_MS, relDeadline / portTICK_PERIOD_MS, WCETinTicks, &slack);
+    if (xAdmitted != pdTRUE)
     {
-        printf("Task \"%s\" Failed schedulability check. Predicted CPU Utilization: %.2f!!\n", taskName, periodicUtilization);
+        #if USE_GLOBAL_EDF == 1
+        printf("Task \"%s\" Failed global schedulability check!!\n", taskName);
+        #else
+        if (xAdmitted == EDF_ADMISSION_UNDECIDED)
+        {
+            printf("Task \"%s\" Failed schedulability check. The demand could not be checked within EDF_ADMISSION_HORIZON!!\n", taskName);
+        }
+        else
+        {
+            printf("Task \"%s\" Failed schedulability check. Demand exceeds the processor by %ld ticks!!\n", taskName, (long) slack);
+        }
+        #endif
         return;
     }
+    #endif
 
-    extTCB_t * taskNode = (extTCB_t *)malloc(sizeof(extTCB_t));
+    extTCB_t * taskNode = EDFNewPeriodicTCB(taskName, stackSize, instanceFunc, timePeriod / portTICK_PERIOD_MS, relDeadline / portTICK_PERIOD_MS,
+                                            phase / portTICK_PERIOD_MS, instanceParams, WCETinTicks, xNoOfPeriodicTasks + TASK_NUM_START, pxPolicy);
 
     if (taskNode == NULL)
     {
-        printf("Could not allocate Memory......\n");
+        #if EDF_NUM_OF_RUN_QUEUES == 1
+        EDFReleaseUtilization(0, timePeriod / portTICK_PERIOD_MS, relDeadline / portTICK_PERIOD_MS, WCETinTicks);
+        #endif
         return;
     }
+    taskNode->pxHandle = handle;
+    xTaskRecords[xNoOfPeriodicTasks].xState = EDF_RECORD_IN_USE;
+    xNoOfPeriodicTasks++;
 
-    taskNode->taskName = taskName;
-    taskNode->instanceFunc = instanceFunc;
-    taskNode->instanceParams = instanceParams;
-    taskNode->measuredExecTime = 0;
-    taskNode->WCET = WCETinTicks;
-    taskNode->period = timePeriod / portTICK_PERIOD_MS;
-    taskNode->phase = phase / portTICK_PERIOD_MS;
-    taskNode->relDeadline = relDeadline / portTICK_PERIOD_MS;
-    taskNode->absDeadline = taskNode->phase + taskNode->relDeadline;// temporary abs deadline to sort tasks
-    taskNode->xTaskNumber = xNoOfPeriodicTasks + TASK_NUM_START;
-    #if USE_TBS == 1
-    taskNode->executedTBSTask = pdFALSE;
-    taskNode->isPeriodic = pdTRUE;
+    #if EDF_NUM_OF_RUN_QUEUES > 1
+    // admitted and pinned to a core by EDFStartScheduling()
+    xTCBsToPlace[uxNumOfTCBsToPlace++] = taskNode;
+    #else
+    addTCBToList(taskNode);
     #endif
-    taskNode->cTaskHandle = NULL;
-    taskNode->stackSize = stackSize;
-    #if USE_WCET_CHECKS == 1
-    taskNode->WCETExceeded = pdFALSE;
+}
+
+BaseType_t EDFAddPeriodicTask(const char* taskName, 
+                            int stackSize, 
+                            void (*instanceFunc)(void*), 
+                            int timePeriod,
+                            int relDeadline, 
+                            TaskHandle_t *handle, 
+                            void *instanceParams, 
+                            TickType_t WCETinTicks)
+{
+    return EDFAddPeriodicTaskWithPolicy(taskName, stackSize, instanceFunc, timePeriod, relDeadline, handle, instanceParams, WCETinTicks, NULL);
+}
+
+BaseType_t EDFAddPeriodicTaskWithPolicy(const char* taskName, 
+                            int stackSize, 
+                            void (*instanceFunc)(void*), 
+                            int timePeriod,
+                            int relDeadline, 
+                            TaskHandle_t *handle, 
+                            void *instanceParams, 
+                            TickType_t WCETinTicks,
+                            const EDFTaskPolicy_t * pxPolicy)
+{
+    // incremental admission against the tasks admitted now, the running tasks are not stopped. A removed task still
+    // counts until its last deadline, if the new task only fits without the removed tasks of a core it is released
+    // on that core once their last jobs are over (mode change), otherwise at once
+    TickType_t period = timePeriod / portTICK_PERIOD_MS;
+    TickType_t xRelDeadline = relDeadline / portTICK_PERIOD_MS;
+    TickType_t xRelease;
+    BaseType_t xTaskIndex;
+    BaseType_t xCore;
+    extTCB_t * xTCB;
+
+    configASSERT(startEDF == pdTRUE);
+    configASSERT(relDeadline <= timePeriod);
+
+    if (!edfTASK_POLICY_SUPPORTED(pxPolicy))
+    {
+        EDF_LOG_ERROR(EDF_LOG_POLICY_REJECTED, period, xRelDeadline, WCETinTicks, 0);
+        return pdFALSE;
+    }
+
+    EDFRetireRemovedTasks(-1, pdFALSE);
+    for (xTaskIndex = 0; (xTaskIndex < MAX_NUM_OF_PERIODIC_TASKS) && (xTaskRecords[xTaskIndex].xState != EDF_RECORD_FREE); xTaskIndex++);
+    if (xTaskIndex == MAX_NUM_OF_PERIODIC_TASKS)
+    {
+        EDF_LOG_ERROR(EDF_LOG_TASK_LIMIT, period, xRelDeadline, WCETinTicks, 0);
+        return pdFALSE;
+    }
+
+    xCore = EDFAdmitTask(period, xRelDeadline, WCETinTicks, pdFALSE);
+    if (xCore < 0)
+    {
+        xCore = EDFAdmitTask(period, xRelDeadline, WCETinTicks, pdTRUE);
+    }
+    if (xCore < 0)
+    {
+        EDF_LOG_ERROR(EDF_LOG_TASK_REJECTED, period, xRelDeadline, WCETinTicks, 0);
+        return pdFALSE;
+    }
+
+    xTCB = EDFNewPeriodicTCB(taskName, stackSize, instanceFunc, period, xRelDeadline, 0, instanceParams, WCETinTicks, xTaskIndex + TASK_NUM_START, pxPolicy);
+    if (xTCB == NULL)
+    {
+        EDFReleaseUtilization(xCore, period, xRelDeadline, WCETinTicks);
+        return pdFALSE;
+    }
+
+    xRelease = xTaskGetTickCount();
+    if (((long int)xSafeReleaseTime[xCore] - (long int)xRelease) > 0)
+    {
+        xRelease = xSafeReleaseTime[xCore];
+    }
+    xTCB->xCoreID = xCore;
+    xTCB->phase = xRelease - xSysStartTime;
+    xTCB->relArrivalTime = xRelease;
+    xTCB->absDeadline = xRelease + xTCB->relDeadline;
+    xTCB->xAddedOnline = pdTRUE;
+    vEDFHeapInitialiseItem(&xTCB->xTCBHeapItem);
+    heapSET_ITEM_OWNER(&xTCB->xTCBHeapItem, xTCB);
+    edfINIT_DEADLINE_ITEM(xTCB);
+
+    #if configUSE_EDF == 1
+    // ordered by the kernel on the deadline of its first job, it delays itself until the release if that is later
+    if (EDFCreateKernelOrderedTask(xTCB) != pdPASS)
+    #else
+    // created above the EDF tasks, it hands itself to the scheduler at once (see EDFPeriodicWrapper)
+    if (xEDFCreateTask(xTCB, EDFPeriodicWrapper, xTCB->taskName, xTCB->stackSize, (void *) xTCB, SCHED_PRIO, &(xTCB->cTaskHandle)) != pdPASS)
+    #endif
+    {
+        EDF_LOG_ERROR(EDF_LOG_TASK_CREATE_FAILED, xTCB->xTaskNumber, 0, 0, 0);
+        EDFReleaseUtilization(xCore, period, xRelDeadline, WCETinTicks);
+        vEDFFreeTCB(xTCB);
+        return pdFALSE;
+    }
+    #if configUSE_EDF == 1
+    edfENTER_CORE_CRITICAL(xCore);
+    vEDFHeapInsert(&xTCBBlockedList[xCore], &xTCB->xTCBHeapItem);
+    edfEXIT_CORE_CRITICAL(xCore);
     #endif
+    xTaskRecords[xTaskIndex].xState = EDF_RECORD_IN_USE;
+    xNoOfPeriodicTasks++;
+    vTaskSetTaskNumber(xTCB->cTaskHandle, xTCB->xTaskNumber);
+    EDF_LOG_INFO(EDF_LOG_TASK_CREATED, xTCB->xTaskNumber, xTCB->xPriority, xTCB->period, xRelease);
+    if (handle != NULL)
+    {
+        *handle = xTCB->cTaskHandle;
+    }
+    return pdTRUE;
+}
 
-    #if USE_DEADLINE_CHECKS == 1
-    taskNode->deadlineExceeded = pdFALSE;
+BaseType_t EDFRemovePeriodicTask(TaskHandle_t xTask)
+{
+    // the last deadline is taken now, the scheduler of the core deletes the task in its next pass, before it decides
+    // which job runs, so a job released in between never runs. The utilization is freed by a later call once the last
+    // deadline has passed, or by EDFAddPeriodicTask when a new task needs it
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTask, LOCAL_STORAGE_INDEX);
+
+    configASSERT(startEDF == pdTRUE);
+    EDFRetireRemovedTasks(-1, pdFALSE);
+
+    // fails if the task was removed already or deleted on a deadline miss
+    if ((xTCB == NULL) || (EDFRetainUtilization(xTCB) == pdFALSE))
+    {
+        return pdFALSE;
+    }
+    #if configUSE_EDF == 1
+    // no scheduler task to delete it, a task cannot remove itself as its TCB would be freed while it still runs
+    configASSERT(xTask != xTaskGetCurrentTaskHandle());
+    EDF_LOG_INFO(EDF_LOG_TASK_REMOVED, xTCB->xTaskNumber, xTaskRecords[xTCB->xTaskNumber - TASK_NUM_START].xLastDeadline, 0, 0);
+    EDFDeleteTask(xTCB->xCoreID, xTCB);
+    vEDFFreeTCB(xTCB);
+    #else
+    EDFSignalScheduler(SWITCH_ON_REMOVE, xTCB);
     #endif
+    return pdTRUE;
+}
 
-    taskNode->xPriority = BLOCKED_TASK_PRIO;
-    taskNode->status = TASK_BLOCKED;
-    xNoOfPeriodicTasks++;
+#if USE_EDF_TASK_STATS == 1
+BaseType_t EDFGetTaskStats(TaskHandle_t xTask, EDFTaskStats_t * pxStats)
+{
+    // every counter is read on its own while the task may go on, nothing is locked
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTask, LOCAL_STORAGE_INDEX);
 
-    addTCBToList(taskNode);
+    if (xTCB == NULL)
+    {
+        return pdFALSE;
+    }
+    pxStats->ulJobs = __atomic_load_n(&xTCB->xStats.ulJobs, __ATOMIC_RELAXED);
+    pxStats->ulPreemptions = __atomic_load_n(&xTCB->xStats.ulPreemptions, __ATOMIC_RELAXED);
+    pxStats->ulWCETOverruns = __atomic_load_n(&xTCB->xStats.ulWCETOverruns, __ATOMIC_RELAXED);
+    pxStats->ulDeadlineMisses = __atomic_load_n(&xTCB->xStats.ulDeadlineMisses, __ATOMIC_RELAXED);
+    pxStats->ulMaxExecTime = __atomic_load_n(&xTCB->xStats.ulMaxExecTime, __ATOMIC_RELAXED);
+    for (UBaseType_t i = 0; i < EDF_STATS_NUM_OF_BUCKETS; i++)
+    {
+        pxStats->ulResponseTime[i] = __atomic_load_n(&xTCB->xStats.ulResponseTime[i], __ATOMIC_RELAXED);
+        pxStats->ulExecTime[i] = __atomic_load_n(&xTCB->xStats.ulExecTime[i], __ATOMIC_RELAXED);
+    }
+    return pdTRUE;
 }
+#endif
 
 void EDFCreateAperiodicTask(const char* taskName, 
                             void (*instanceFunc)(void*), 
@@ -907,13 +2651,15 @@ void EDFCreateAperiodicTask(const char* taskName,
                             TickType_t WCETinTicks,
                             TickType_t arrivalTime)
 {
-    configASSERT(xNoOfAperiodicTasks <= MAX_NUM_OF_APERIODIC_TASKS);
+    configASSERT(xNoOfAperiodicTasks < MAX_NUM_OF_APERIODIC_TASKS);
 
     #if USE_TBS == 1
-    extTCB_t * taskNode = (extTCB_t *)malloc(sizeof(extTCB_t));
+    // only the job is kept, it is queued at its arrival and runs on a TBS worker (see EDFTBSReleaseDeclaredJobs)
+    EDFAperiodicJob_t xJob = {taskName, instanceFunc, instanceParams, stackSize, WCETinTicks, arrivalTime / portTICK_PERIOD_MS,
+                              MAX_NUM_OF_PERIODIC_TASKS + TASK_NUM_START + xNoOfAperiodicTasks};
+    xTBSDeclaredJobs[xNoOfAperiodicTasks] = xJob;
     #else
-    extTCBA_t * taskNode = (extTCBA_t *)malloc(sizeof(extTCBA_t));
-    #endif
+    extTCBA_t * taskNode = pxEDFAllocTCBA();
 
     if (taskNode == NULL)
     {
@@ -921,7 +2667,8 @@ void EDFCreateAperiodicTask(const char* taskName,
         return;
     }
 
-    taskNode->status = TASK_BLOCKED;
+    // waits for its arrival time like a blocked periodic task
+    taskNode->status = TASK_NOT_ARRIVED;
     taskNode->stackSize = stackSize;
     taskNode->instanceFunc = instanceFunc;
     taskNode->instanceParams = instanceParams;
@@ -930,167 +2677,279 @@ void EDFCreateAperiodicTask(const char* taskName,
     taskNode->WCET = WCETinTicks;
     taskNode->xTaskNumber = MAX_NUM_OF_PERIODIC_TASKS + TASK_NUM_START + xNoOfAperiodicTasks;
     taskNode->phase = arrivalTime / portTICK_PERIOD_MS;
+    aperiodicTCBQueue[xNoOfAperiodicTasks] = taskNode;
+    #endif
+    xNoOfAperiodicTasks++;
+}
 
-    #if USE_TBS == 1
-    // TBS Additions
-    d_k = max(taskNode->phase, d_k) + (TickType_t)(((float) pdTICKS_TO_MS(WCETinTicks)) / (float) (1 - Up_accepted));
+BaseType_t EDFSubmitAperiodicJob(const char* taskName, 
+                                void (*instanceFunc)(void*), 
+                                void *instanceParams,
+                                int stackSize, 
+                                TickType_t WCETinTicks)
+{
+    EDFAperiodicJob_t xJob = {taskName, instanceFunc, instanceParams, stackSize, WCETinTicks, xTaskGetTickCount(), APERIODIC_SERVER_NUM};
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t xSubmitted = EDFSubmitJob(&xJob, &xHigherPriorityTaskWoken);
 
-    printf("%s with release time: %ld, deadline: %ld, Up_acc: %0.2f\n", taskName, arrivalTime, d_k, Up_accepted);
+    if (xHigherPriorityTaskWoken == pdTRUE)
+    {
+        taskYIELD();
+    }
+    return xSubmitted;
+}
 
-    taskNode->period = d_k;
-    taskNode->relDeadline = d_k;
-    taskNode->absDeadline = taskNode->phase + taskNode->relDeadline;// temporary abs deadline to sort tasks
-    taskNode->cTaskHandle = NULL;
-    
-    #if USE_WCET_CHECKS == 1 & USE_WCET_CHECKS_TBS == 1
-    taskNode->WCETExceeded = pdFALSE;
-    #endif
+BaseType_t EDFSubmitAperiodicJobFromISR(const char* taskName, 
+                                        void (*instanceFunc)(void*), 
+                                        void *instanceParams,
+                                        int stackSize, 
+                                        TickType_t WCETinTicks,
+                                        BaseType_t * pxHigherPriorityTaskWoken)
+{
+    EDFAperiodicJob_t xJob = {taskName, instanceFunc, instanceParams, stackSize, WCETinTicks, xTaskGetTickCountFromISR(), APERIODIC_SERVER_NUM};
 
-    #if USE_DEADLINE_CHECKS == 1 & USE_DEADLINE_CHECKS_TBS == 1
-    taskNode->deadlineExceeded = pdFALSE;
-    #endif
-    taskNode->xPriority = BLOCKED_TASK_PRIO;
-    taskNode->isPeriodic = pdFALSE;
-    taskNode->executedTBSTask = pdFALSE;
+    return EDFSubmitJob(&xJob, pxHigherPriorityTaskWoken);
+}
 
-    addTBSTCBToList(taskNode);
-    #else
-    aperiodicTCBQueue[xNoOfAperiodicTasks] = taskNode;
-    #endif
-    xNoOfAperiodicTasks++;
+#if USE_SRP == 1
+void EDFInitResource(EDFResource_t * pxResource, int relDeadline)
+{
+    // the ceiling is the highest preemption level of the tasks that lock the resource
+    pxResource->xCeiling = relDeadline / portTICK_PERIOD_MS;
+    pxResource->xCoreID = -1;
+    pxResource->pxHolder = NULL;
+    pxResource->pxNext = NULL;
+}
+
+void EDFLockResource(EDFResource_t * pxResource)
+{
+    // the scheduler only started the job while its preemption level was above the system ceiling, so no job that
+    // locks this resource had started and none of them holds it now. The ceiling rises to that of the resource
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(NULL, LOCAL_STORAGE_INDEX);
+    BaseType_t xCore;
+
+    configASSERT(xTCB != NULL);
+    configASSERT(xTCB->relDeadline >= pxResource->xCeiling);
+    configASSERT((pxResource->xCoreID < 0) || (pxResource->xCoreID == xTCB->xCoreID));
+    xCore = xTCB->xCoreID;
+
+    edfENTER_CORE_CRITICAL(xCore);
+    configASSERT(pxResource->pxHolder == NULL);
+    pxResource->xCoreID = xCore;
+    pxResource->pxHolder = xTCB;
+    pxResource->pxNext = pxSRPLocked[xCore];
+    pxSRPLocked[xCore] = pxResource;
+    if (pxResource->xCeiling < xSystemCeiling[xCore])
+    {
+        xSystemCeiling[xCore] = pxResource->xCeiling;
+    }
+    edfEXIT_CORE_CRITICAL(xCore);
+}
+
+void EDFUnlockResource(EDFResource_t * pxResource)
+{
+    // the scheduler is only woken if it held a job back for the ceiling, otherwise the unlock costs no context switch
+    BaseType_t xCore = pxResource->xCoreID;
+    BaseType_t xHeldBack;
+
+    configASSERT((pxResource->pxHolder != NULL) && (pxResource->pxHolder->cTaskHandle == xTaskGetCurrentTaskHandle()));
+
+    edfENTER_CORE_CRITICAL(xCore);
+    EDFSRPRelease(xCore, pxResource->pxHolder, pxResource);
+    xHeldBack = xSRPHeldBack[xCore];
+    xSRPHeldBack[xCore] = pdFALSE;
+    edfEXIT_CORE_CRITICAL(xCore);
+
+    if (xHeldBack == pdTRUE)
+    {
+        EDFWakeScheduler(xCore, SWITCH_ON_RESOURCE);
+    }
 }
+#endif
 
 // First function to be called from the module
 void EDFInit()
 {
-    #ifdef TRACE_CONFIG
-    memset(task_nums, 0, sizeof(task_nums));
+    #if USE_EDF_TRACE == 1
+    vEDFTraceInit();
     #endif
 
-    #ifdef ESP_TRACE_CONFIG
-    memset(eventArray, 0, sizeof(eventArray));
-    const esp_timer_create_args_t timer_args = {
-            .callback = &espTimerCallback,
-            .name = "traceTimer"
-    };
-    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &traceTimer));
-    ESP_ERROR_CHECK(esp_timer_start_once(traceTimer, TRACE_TIMER_TIMEOUT));
+    #if EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE
+    vEDFLogInit();
     #endif
+    vEDFSignalQueueInit();
+    vEDFArrivalQueueInit();
+    vEDFPoolInit();
+    vEDFAdmissionInit();
 
     vTaskPrioritySet(NULL, MAX_SYS_PRIO + 2);
     vTaskDelay(50 / portTICK_PERIOD_MS);
 
-    vListInitialise(xTCBBlockedList);
-    vListInitialise(xTCBReadyList);
-    vListInitialise(xTCBSuspendedList);
-    vListInitialise(xTCBAperiodicList);
-    vListInitialise(xTCBInitList);
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+    {
+        vEDFHeapInitialise(&xTCBBlockedList[xCore], xTCBBlockedListStorage[xCore], TOTAL_NUM_OF_TASKS);
+        vEDFHeapInitialise(&xTCBReadyList[xCore], xTCBReadyListStorage[xCore], TOTAL_NUM_OF_TASKS);
+        #if USE_WCET_CHECKS == 1
+        vEDFHeapInitialise(&xTCBWCETWakeList[xCore], xTCBWCETWakeListStorage[xCore], TOTAL_NUM_OF_TASKS);
+        #endif
+        #if USE_DEADLINE_CHECKS == 1
+        vEDFHeapInitialise(&xTCBDeadlineList[xCore], xTCBDeadlineListStorage[xCore], TOTAL_NUM_OF_TASKS);
+        #endif
+        vEDFHeapInitialise(&xTCBInitList[xCore], xTCBInitListStorage[xCore], TOTAL_NUM_OF_TASKS);
+    }
+
+    #if USE_CBS == 1
+    EDFCBSInit();
+    #endif
 }
 
 void EDFStartScheduling()
 {
     configASSERT((xNoOfAperiodicTasks > 0) || (xNoOfPeriodicTasks > 0));
 
-    #if USE_TBS == 1
-    if ((xNoOfPeriodicTasks > 0) | (xNoOfAperiodicTasks > 0))
-    #else
-    if (xNoOfPeriodicTasks > 0)
+    #if EDF_NUM_OF_RUN_QUEUES > 1
+    EDFPartitionTasks();
     #endif
+
+    #if configUSE_EDF == 0
+    if (xNoOfPeriodicTasks > 0)
     {
         EDFSchedulerInit();
     }
+    #endif
+
+    #if USE_EDF_TICKLESS == 1
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+    {
+        const esp_timer_create_args_t xTimerArgs = {
+                .callback = &EDFEventTimerCallback,
+                .arg = (void *)(intptr_t) xCore,
+                .name = "EDF Event Timer"
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&xTimerArgs, &xEventTimer[xCore]));
+        #if USE_EDF_INLINE_DISPATCH == 1
+        // armed by the scheduler task when it starts otherwise
+        EDFArmEventTimer(xCore);
+        #endif
+    }
+    #endif
 
     // create Generator Task
-    xTaskCreate(generatorTaskEDF, "EDF Gen Task", 2000, NULL, SCHED_PRIO, &EDFGenHandle);
-    xTaskCreate(EDFSchedulerTask, "EDF Scheduler", 2000, NULL, SCHED_PRIO, &EDFSchedulerHandle);
-    vTaskSetTaskNumber(EDFSchedulerHandle, SCHED_TASK_NUM);
+    xEDFCreateSystemTask(EDF_SYSTEM_TASK_GENERATOR, generatorTaskEDF, "EDF Gen Task", 2000, NULL, SCHED_PRIO, &EDFGenHandle, tskNO_AFFINITY);
+    #if (USE_EDF_INLINE_DISPATCH == 0) && (configUSE_EDF == 0)
+    // create the scheduler of every core, pinned to it, the one scheduler of global EDF stays on core 0 so a
+    // time slice on another core cannot pull it away from the core it was woken for and displace that job
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
+    {
+        char pcName[configMAX_TASK_NAME_LEN] = "EDF Scheduler";
+        if (xCore > 0)
+        {
+            snprintf(pcName, sizeof(pcName), "EDF Scheduler %d", (int) xCore);
+        }
+        xEDFCreateSystemTask((EDFSystemTask_t)(EDF_SYSTEM_TASK_SCHEDULER + xCore), EDFSchedulerTask, pcName, 2000, (void *)(intptr_t) xCore, SCHED_PRIO, &EDFSchedulerHandle[xCore], xCore);
+        vTaskSetTaskNumber(EDFSchedulerHandle[xCore], SCHED_TASK_NUM);
+    }
+    #endif
+
+    #if (EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE) && (USE_LOG_DRAIN_TASK == 1)
+    vEDFLogStartDrainTask();
+    #endif
+    #if (USE_EDF_TRACE == 1) && (USE_TRACE_DRAIN_TASK == 1)
+    vEDFTraceStartDrainTask();
+    #endif
 }
 
 void EDFDeleteAllTasks()
 {
     extTCB_t * xTCB;
     TaskHandle_t xHandle;
-    ListItem_t * xTCBListItem = listGET_HEAD_ENTRY(xTCBReadyList);
-    const ListItem_t * xTCBListEndMarker = listGET_END_MARKER(xTCBReadyList);
 
     printf("[INFO] Deleting all Tasks............\n");
-    while (xTCBListItem != xTCBListEndMarker)
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
     {
-        xTCB = listGET_LIST_ITEM_OWNER(xTCBListItem);
-        xTCBListItem = listGET_NEXT(xTCBListItem);
-        xHandle = xTCB->cTaskHandle;
-        deleteTCBFromList(xTCB);
-        if (xHandle != NULL)
-        {
-            vTaskDelete(xHandle);
-        }
-    }
+        EDFHeap_t * xTCBLists[] = {&xTCBReadyList[xCore], &xTCBBlockedList[xCore]
+        #if USE_WCET_CHECKS == 1
+            , &xTCBWCETWakeList[xCore]
+        #endif
+        };
 
-    xTCBListItem = listGET_HEAD_ENTRY(xTCBBlockedList);
-    xTCBListEndMarker = listGET_END_MARKER(xTCBBlockedList);
-    while (xTCBListItem != xTCBListEndMarker)
-    {
-        xTCB = listGET_LIST_ITEM_OWNER(xTCBListItem);
-        xTCBListItem = listGET_NEXT(xTCBListItem);
-        xHandle = xTCB->cTaskHandle;
-        deleteTCBFromList(xTCB);
-        if (xHandle != NULL)
+        for (BaseType_t i = 0; i < (BaseType_t)(sizeof(xTCBLists) / sizeof(xTCBLists[0])); i++)
         {
-            vTaskDelete(xHandle);
+            while (!heapIS_EMPTY(xTCBLists[i]))
+            {
+                xTCB = heapGET_HEAD_OWNER(xTCBLists[i]);
+                xHandle = xTCB->cTaskHandle;
+                deleteTCBFromList(xTCB);
+                if (xHandle != NULL)
+                {
+                    vTaskDelete(xHandle);
+                }
+            }
         }
     }
 
-    xTCBListItem = listGET_HEAD_ENTRY(xTCBSuspendedList);
-    xTCBListEndMarker = listGET_END_MARKER(xTCBSuspendedList);
-    while (xTCBListItem != xTCBListEndMarker)
+    for (BaseType_t xCore = 0; xCore < EDF_NUM_OF_RUN_QUEUES; xCore++)
     {
-        xTCB = listGET_LIST_ITEM_OWNER(xTCBListItem);
-        xTCBListItem = listGET_NEXT(xTCBListItem);
-        xHandle = xTCB->cTaskHandle;
-        deleteTCBFromList(xTCB);
-        if (xHandle != NULL)
-        {
-            vTaskDelete(xHandle);
-        }
+        #if (USE_EDF_INLINE_DISPATCH == 0) && (configUSE_EDF == 0)
+        vTaskDelete(EDFSchedulerHandle[xCore]);
+        EDFSchedulerHandle[xCore] = NULL;
+        #endif
+        #if USE_EDF_TICKLESS == 1
+        (void)esp_timer_stop(xEventTimer[xCore]);
+        ESP_ERROR_CHECK(esp_timer_delete(xEventTimer[xCore]));
+        #endif
     }
-
-    vTaskDelete(EDFSchedulerHandle);
-    EDFSchedulerHandle = NULL;
     startEDF = pdFALSE;
 
-    #ifdef TRACE_CONFIG
-    printf("[INFO] Overhead and CPU Utilization Information.........\n");
-    printf("[INFO] Periodic Utilization: %f, %d\n", ((float) periodicCount) / ((float) totalCount), periodicCount);
-    printf("[INFO] Aperiodic Utilization: %f, %d\n", ((float) aperiodicCount) / ((float) totalCount), aperiodicCount);
-    printf("[INFO] Idle Utilization: %f, %d\n", ((float) idleCount) / ((float) totalCount), idleCount);
-    printf("[INFO] Scheduler INFO: %f, %d\n", ((float) (totalCount - idleCount - aperiodicCount - periodicCount)) / ((float) totalCount), schedulerCount);
-    printf("[INFO] Stats END\n");
+    #if (EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE) && (USE_LOG_DRAIN_TASK == 1)
+    vEDFLogStopDrainTask();
     #endif
+    #if (USE_EDF_TRACE == 1) && (USE_TRACE_DRAIN_TASK == 1)
+    // the records so far reach the sink, later ones with vEDFTraceFlush()
+    vEDFTraceStopDrainTask();
+    #endif
+}
+// ******************************************************************** //
+// **************** EDF Functions called from Trace Macros ************ //
+static void EDFSignalScheduler(uint32_t event, extTCB_t * xTCB)
+{
+    // the queue holds a few signals per task, running out means the scheduler task is starved
+    BaseType_t xQueued = xEDFSignalSend(xTCB->xCoreID, event, xTCB);
+    configASSERT(xQueued == pdTRUE);
+    EDFWakeScheduler(xTCB->xCoreID, event);
+}
 
-    #ifdef ESP_TRACE_CONFIG
-    ESP_ERROR_CHECK(esp_timer_stop(traceTimer));
-    ESP_ERROR_CHECK(esp_timer_delete(traceTimer));
-    #endif
+void EDFWakeScheduler(BaseType_t xCore, uint32_t event)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    EDFNotifyScheduler(xCore, event, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
-// ******************************************************************** //
-// **************** EDF Functions called from Trace Macros ************ //
-void EDFWakeScheduler(uint32_t event)
+
+static void EDFNotifyScheduler(BaseType_t xCore, uint32_t event, BaseType_t * pxHigherPriorityTaskWoken)
 {
-    if ((startEDF == pdTRUE) & (EDFSchedulerHandle != NULL))
+    if ((startEDF == pdTRUE) & edfSCHEDULER_CREATED(xCore))
     {
-        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        xTaskNotifyFromISR(EDFSchedulerHandle, event, eSetBits, &xHigherPriorityTaskWoken);
-        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-        return;
+        traceEDF_SCHEDULER_WAKE(event);
+        #if USE_EDF_INLINE_DISPATCH == 1
+        // the hooks run inside the kernel or an interrupt, where no priority can be changed. The events are collected
+        // until the pass runs on the timer service task, only the first one pends it
+        if (__atomic_fetch_or(&ulDeferredEvents[xCore], event, __ATOMIC_ACQ_REL) == 0)
+        {
+            BaseType_t xPended = xTimerPendFunctionCallFromISR(EDFDeferredPass, NULL, (uint32_t) xCore, pxHigherPriorityTaskWoken);
+            configASSERT(xPended == pdPASS);
+        }
+        #else
+        xTaskNotifyFromISR(EDFSchedulerHandle[xCore], event, eSetBits, pxHigherPriorityTaskWoken);
+        #endif
     }
-    return;
 }
 
 void EDFMovedTaskToReadyState(TaskHandle_t xTaskToReadyState)
 {
     // get pointer to task that was moved to ready state
     extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTaskToReadyState, LOCAL_STORAGE_INDEX);
-    if ((startEDF == pdTRUE) & (EDFSchedulerHandle != NULL))
+    if ((startEDF == pdTRUE) & edfSCHEDULER_CREATED(0))
     {
         if (xTCB != NULL)
         {
@@ -1103,11 +2962,11 @@ void EDFMovedTaskToReadyState(TaskHandle_t xTaskToReadyState)
 
 void EDFTaskSuspended(TaskHandle_t xTaskToSuspend)
 {
-    if ((startEDF == pdTRUE) & (EDFSchedulerHandle != NULL))
+    if ((startEDF == pdTRUE) & edfSCHEDULER_CREATED(0))
     {
 
-        #if USE_TBS == 0
-        // if vTaskSuspend called from the aperiodic server, do nothing
+        #if (USE_TBS == 0) & (USE_CBS == 0)
+        // if vTaskSuspend called from the aperiodic server, do nothing, the CBS gives up the processor like any EDF task
         if (xTaskGetCurrentTaskHandle() == EDFAperiodicServerHandle)
         {
             return;
@@ -1128,11 +2987,12 @@ void EDFTaskSuspended(TaskHandle_t xTaskToSuspend)
 
             if (xTCB->status != TASK_SUSPENDED)
             {
+                edfENTER_CORE_CRITICAL(xTCB->xCoreID);
                 xTCB->status = TASK_SUSPENDED;
-                uxListRemove(&xTCB->xTCBListItem);
-                vListInsert(xTCBSuspendedList, &xTCB->xTCBListItem);
-                xTCBToSuspend = xTCB;
-                EDFWakeScheduler(SWITCH_ON_SUSPEND);
+                uxEDFHeapRemove(&xTCB->xTCBHeapItem);
+                vEDFHeapInsert(&xTCBBlockedList[xTCB->xCoreID], &xTCB->xTCBHeapItem);
+                edfEXIT_CORE_CRITICAL(xTCB->xCoreID);
+                EDFSignalScheduler(SWITCH_ON_SUSPEND, xTCB);
             }
         }
         return;
@@ -1142,10 +3002,23 @@ void EDFTaskSuspended(TaskHandle_t xTaskToSuspend)
 
 void EDFTaskBlocked()
 {
-    if ((startEDF == pdTRUE) & (EDFSchedulerHandle != NULL))
+    if ((startEDF == pdTRUE) & edfSCHEDULER_CREATED(0))
     {
-        // as task TCB not availabe to macro, call scheduler and ask to block current running task
-        EDFWakeScheduler(SWITCH_ON_BLOCK);
+        // only EDF tasks are blocked by the scheduler, the aperiodic server also delays itself with vTaskDelayUntil
+        extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(NULL, LOCAL_STORAGE_INDEX);
+        if (xTCB == NULL)
+        {
+            return;
+        }
+        #if USE_EDF_INLINE_DISPATCH == 1
+        if (xTCB->xPriority == SCHED_PRIO)
+        {
+            // the job end was dispatched by the task itself (EDFDispatchInline)
+            return;
+        }
+        #endif
+        // ask the scheduler to block the calling task
+        EDFSignalScheduler(SWITCH_ON_BLOCK, xTCB);
         return;
     }
     return;
@@ -1154,7 +3027,7 @@ void EDFTaskBlocked()
 // assuming task goes to ready queue after resumption
 void EDFTaskResumed(TaskHandle_t xTaskToResume)
 {
-    if ((startEDF == pdTRUE) & (EDFSchedulerHandle != NULL))
+    if ((startEDF == pdTRUE) & edfSCHEDULER_CREATED(0))
     {
         // get pointer to task that was resumed
         extTCB_t * xTCBToResume = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTaskToResume, LOCAL_STORAGE_INDEX);
@@ -1168,221 +3041,511 @@ void EDFTaskResumed(TaskHandle_t xTaskToResume)
     return;
 }
 
-// ******************************************************************* //
-// ********************* Tick hook Function ************************** //
-void vApplicationTickHook(void)
+// called by the kernel on the core that switches, with the task that leaves or gets the processor, tasks without an
+// extended TCB are not measured. A task that set its extended TCB while running is measured from its next switch in
+void EDFTaskSwitchedOut(TaskHandle_t xTask)
 {
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTask, LOCAL_STORAGE_INDEX);
 
-    TaskHandle_t curTaskHandle = xTaskGetCurrentTaskHandle();
+    #if USE_EDF_TASK_STATS == 1
+    if (xTCB != NULL)
+    {
+        EDFStatsSwitchedOut(xTCB);
+    }
+    #endif
+    if ((xTCB != NULL) && (xTCB->xSwitchedInTime != edfNOT_SWITCHED_IN))
+    {
+        int64_t xRunTime = edfCLOCK_US() - xTCB->xSwitchedInTime;
+        xTCB->measuredExecTime += xRunTime;
+        #if USE_EDF_TASK_STATS == 1
+        xTCB->xJobExecTime += xRunTime;
+        #endif
+        // written last, the TCB of a task deleted under global EDF is freed once the scheduler sees it switched out
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        ((volatile extTCB_t *)xTCB)->xSwitchedInTime = edfNOT_SWITCHED_IN;
+    }
+}
 
-    if (startEDF == pdFALSE || curTaskHandle == EDFGenHandle)
+void EDFTaskSwitchedIn(TaskHandle_t xTask)
+{
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTask, LOCAL_STORAGE_INDEX);
+
+    if (xTCB != NULL)
     {
-        return;
+        xTCB->xSwitchedInTime = edfCLOCK_US();
+        #if USE_EDF_TASK_STATS == 1
+        EDFStatsSwitchedIn(xTCB);
+        #endif
     }
+}
 
-    #if USE_WCET_CHECKS == 1
-    if (EarliestSchedWakeUp == xTaskGetTickCountFromISR())
+#if (USE_WCET_CHECKS == 1) || (USE_CBS == 1)
+static int64_t EDFExecTime(extTCB_t * xTCB, int64_t xNow)
+{
+    // execution time of the current job including the time since the task was switched in. A task that runs on another
+    // core can be switched meanwhile, the fields are read again until its switch in time has not changed
+    volatile extTCB_t * pxTCB = xTCB;
+    int64_t xSwitchedInTime;
+    int64_t xMeasured;
+
+    do
     {
-        EDFWakeScheduler(SWITCH_ON_WCET_WAKEUP);
+        xSwitchedInTime = pxTCB->xSwitchedInTime;
+        xMeasured = pxTCB->measuredExecTime;
+    } while (xSwitchedInTime != pxTCB->xSwitchedInTime);
+
+    if (xSwitchedInTime == edfNOT_SWITCHED_IN)
+    {
+        return xMeasured;
     }
-    #endif
+    return xMeasured + (xNow - xSwitchedInTime);
+}
+#endif
+
+#if USE_EDF_TASK_STATS == 1
+static void EDFStatsSwitchedOut(extTCB_t * xTCB)
+{
+    // a started job that leaves its core, unless suspended on a WCET overrun, waits to see whether another job gets it
+    if ((xTCB->xJobRunning == pdTRUE) && (xTCB->status != TASK_SUSPENDED))
+    {
+        xTCB->xSwitchedOutCore = edfCURRENT_CORE();
+        xTCB->ulSwitchedOutCount = __atomic_load_n(&ulStatsSwitchIns[xTCB->xSwitchedOutCore], __ATOMIC_RELAXED);
+    }
+}
 
-    /*#if USE_TBS == 0
-    if (xNoOfAperiodicTasks > 0)
+static void EDFStatsSwitchedIn(extTCB_t * xTCB)
+{
+    // as counted by the simulator, a job is preempted when another job got its core before it continued, here or on
+    // another core. The preemptions of a task are only written by its own switch in
+    #if USE_EDF_INLINE_DISPATCH == 1
+    if (xTCB->xPriority == SCHED_PRIO)
+    {
+        // a released task makes its own decision first, its job gets the core at its start only if it wins
+        return;
+    }
+    #endif
+    if (xTCB->xSwitchedOutCore >= 0)
     {
-        if (xTaskGetTickCountFromISR() >= (aperiodicTCBQueue[aperiodicJobPointer]->phase + xSysStartTime))
+        if (__atomic_load_n(&ulStatsSwitchIns[xTCB->xSwitchedOutCore], __ATOMIC_RELAXED) != xTCB->ulSwitchedOutCount)
         {
-            vTaskSetTaskNumber(EDFAperiodicServerHandle, aperiodicTCBQueue[aperiodicJobPointer]->xTaskNumber);
-            EDFWakeAperiodicServer();
+            __atomic_store_n(&xTCB->xStats.ulPreemptions, xTCB->xStats.ulPreemptions + 1, __ATOMIC_RELAXED);
         }
+        xTCB->xSwitchedOutCore = -1;
     }
-    #endif*/
+    (void)__atomic_fetch_add(&ulStatsSwitchIns[edfCURRENT_CORE()], 1, __ATOMIC_RELAXED);
+}
 
-    TaskHandle_t idleTaskHandle = xTaskGetIdleTaskHandle();
-    extTCB_t * curTaskTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(curTaskHandle, LOCAL_STORAGE_INDEX);
+static void EDFStatsJobStart(extTCB_t * xTCB)
+{
+    // called by the task, the switch hooks of its core are held off while the job takes over the core
+    UBaseType_t uxSavedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    (void)__atomic_fetch_add(&ulStatsSwitchIns[edfCURRENT_CORE()], 1, __ATOMIC_RELAXED);
+    // the time the task ran since its switch in is not part of the job
+    xTCB->xJobExecTime = (xTCB->xSwitchedInTime != edfNOT_SWITCHED_IN) ? (xTCB->xSwitchedInTime - edfCLOCK_US()) : 0;
+    xTCB->xJobRunning = pdTRUE;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedMask);
+}
 
-    if ((curTaskHandle != NULL) & (curTaskHandle != idleTaskHandle) & (curTaskHandle != EDFSchedulerHandle) & (curTaskHandle != EDFAperiodicServerHandle))
+static void EDFStatsJobEnd(extTCB_t * xTCB, BaseType_t xMissed)
+{
+    // called by the task at the completion of its job, the only writer of the job counts, the histograms and the
+    // high-water mark. Unlike measuredExecTime, the execution time is not changed by the WCET overrun handling
+    EDFTaskStats_t * pxStats = &xTCB->xStats;
+    UBaseType_t uxSavedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    int64_t xExecTime = xTCB->xJobExecTime;
+    int64_t xResponseTime = edfTICKS_TO_US(xTaskGetTickCount() - xTCB->relArrivalTime);
+    UBaseType_t uxBucket;
+
+    if (xTCB->xSwitchedInTime != edfNOT_SWITCHED_IN)
     {
-        curTaskTCB->measuredExecTime++;
+        xExecTime += edfCLOCK_US() - xTCB->xSwitchedInTime;
+    }
+    xTCB->xJobRunning = pdFALSE;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedMask);
 
-        #if USE_WCET_CHECKS == 1
-        if ((curTaskTCB->measuredExecTime > curTaskTCB->WCET) & (curTaskTCB->status == TASK_RUNNING) & (curTaskTCB->WCETExceeded == pdFALSE)
-        #if USE_TBS == 1 & USE_WCET_CHECKS_TBS == 1
-        & (curTaskTCB->isPeriodic == pdTRUE)
-        #endif
-        )
-        {
-            curTaskTCB->WCETExceeded = pdTRUE;
-            // Calculate next unblock time here and wake up scheduler
-            curTaskTCB->status = TASK_SUSPENDED;
+    #if USE_DEADLINE_CHECKS == 1
+    if (xTCB->deadlineExceeded == pdTRUE)
+    {
+        // counted by the deadline check already
+        xMissed = pdFALSE;
+    }
+    #endif
+    if (xMissed == pdTRUE)
+    {
+        edfSTATS_COUNT(xTCB, ulDeadlineMisses);
+    }
+    if (xExecTime > (int64_t)pxStats->ulMaxExecTime)
+    {
+        __atomic_store_n(&pxStats->ulMaxExecTime, (xExecTime < (int64_t)UINT32_MAX) ? (uint32_t)xExecTime : UINT32_MAX, __ATOMIC_RELAXED);
+    }
+    uxBucket = EDFStatsBucket(xResponseTime);
+    __atomic_store_n(&pxStats->ulResponseTime[uxBucket], pxStats->ulResponseTime[uxBucket] + 1, __ATOMIC_RELAXED);
+    uxBucket = EDFStatsBucket(xExecTime);
+    __atomic_store_n(&pxStats->ulExecTime[uxBucket], pxStats->ulExecTime[uxBucket] + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&pxStats->ulJobs, pxStats->ulJobs + 1, __ATOMIC_RELAXED);
+}
 
-            curTaskTCB->nextUnblockTime = curTaskTCB->relArrivalTime + curTaskTCB->period;
+static UBaseType_t EDFStatsBucket(int64_t xTime)
+{
+    // the number of bits of the time in us, a single count leading zeros instruction on most cores
+    UBaseType_t uxBucket = (xTime > 0) ? (UBaseType_t)(64 - __builtin_clzll((uint64_t)xTime)) : 0;
 
-            xTCBWCETOverflow = curTaskTCB;
+    return (uxBucket < EDF_STATS_NUM_OF_BUCKETS) ? uxBucket : (EDF_STATS_NUM_OF_BUCKETS - 1);
+}
+#endif
 
-            // wake up scheduler at unblock time
-            if (curTaskTCB->nextUnblockTime < EarliestSchedWakeUp || EarliestSchedWakeUp == 0)
-            {
-                EarliestSchedWakeUp = curTaskTCB->nextUnblockTime;
-            }
-            EDFWakeScheduler(SWITCH_ON_WCET_OVERFLOW);
-        }
-        #endif
+static void EDFCheckRunningTask(BaseType_t xCore, extTCB_t * xTCB, int64_t xNow)
+{
+    // WCET check of a job that holds a core of the run queue, from the tick hook or the event timer
+    (void)xCore;
+    (void)xTCB;
+    (void)xNow;
 
-        #if USE_DEADLINE_CHECKS == 1
-        if ((curTaskTCB->status == TASK_RUNNING)
-        #if USE_TBS == 1 & USE_DEADLINE_CHECKS_TBS == 1
-        & (curTaskTCB->isPeriodic == pdTRUE)
-        #endif
-        )
-        {
-            if (((long int)curTaskTCB->absDeadline - (long int)xTaskGetTickCountFromISR()) < 0)
-            {
-                curTaskTCB->deadlineExceeded = pdTRUE;
-                xTCBDeadlineOverflow = curTaskTCB;
-                EDFWakeScheduler(SWITCH_ON_DEADLINE_OVERFLOW);
-            }
-        }
-        #endif
+    #if USE_WCET_CHECKS == 1
+    // the job is measured in us, an overrun is detected at the first check after it
+    if (edfWCET_CHECKED(xTCB) & (EDFExecTime(xTCB, xNow) > edfTICKS_TO_US(xTCB->WCET)))
+    {
+        xTCB->WCETExceeded = pdTRUE;
+        EDF_TRACE_EVENT(EDF_TRACE_WCET_OVERFLOW, xTCB->xTaskNumber);
+        edfSTATS_COUNT(xTCB, ulWCETOverruns);
+        // Calculate next unblock time here and wake up scheduler
+        xTCB->status = TASK_SUSPENDED;
+
+        // the scheduler queues the task on its unblock time
+        xTCB->nextUnblockTime = xTCB->relArrivalTime + xTCB->period;
+        EDFSignalScheduler(SWITCH_ON_WCET_OVERFLOW, xTCB);
     }
+    #endif
+
 }
-// ******************************************************************* //
 
-#ifdef TRACE_CONFIG
-// ********************* Idle Hook Definition ************************ //
-void vApplicationIdleHook(void)
+#if USE_DEADLINE_CHECKS == 1
+static void EDFWatchDeadline(extTCB_t * xTCB)
 {
-    if (trcIndex < TRACE_ARRAY_SIZE)
+    // (re)queue the pending job of the task on its deadline
+    if (edfDEADLINE_CHECKED(xTCB))
     {
-        task_nums[trcIndex][SCHED_TASK_NUM - 4] = IDLE_TASK_NUM;
+        portENTER_CRITICAL_SAFE(&xDeadlineLocks[xTCB->xCoreID]);
+        uxEDFHeapRemove(&xTCB->xDeadlineHeapItem);
+        heapSET_ITEM_VALUE(&xTCB->xDeadlineHeapItem, xTCB->absDeadline);
+        vEDFHeapInsert(&xTCBDeadlineList[xTCB->xCoreID], &xTCB->xDeadlineHeapItem);
+        portEXIT_CRITICAL_SAFE(&xDeadlineLocks[xTCB->xCoreID]);
     }
 }
 
-// ******************** Tracing Functions  *****************************//
+static void EDFUnwatchDeadline(extTCB_t * xTCB)
+{
+    portENTER_CRITICAL_SAFE(&xDeadlineLocks[xTCB->xCoreID]);
+    uxEDFHeapRemove(&xTCB->xDeadlineHeapItem);
+    portEXIT_CRITICAL_SAFE(&xDeadlineLocks[xTCB->xCoreID]);
+}
 
-void tickTrace(BaseType_t xTickCount, BaseType_t xTaskNumber, BaseType_t xTCBNumber)
+static void EDFCheckDeadlines(BaseType_t xCore, TickType_t xCurTick)
 {
-    trcIndex = xTickCount;
-    if (trcIndex < TRACE_ARRAY_SIZE)
+    // flag every pending job whose deadline has passed, whether it runs, is ready or is blocked. A flagged job leaves
+    // the index so that its miss is signalled once, and the scheduler deletes the task. Only the head is read while no
+    // deadline has passed
+    EDFHeap_t * xTCBDeadlineListOfCore = &xTCBDeadlineList[xCore];
+    extTCB_t * xTCB;
+
+    for (;;)
     {
-        // Periodic, Aperiodic Tasks and the Scheduler
-        if (xTaskNumber != 0)
-        {
-            if (xTaskNumber < SCHED_TASK_NUM)
-            {
-                task_nums[trcIndex][xTaskNumber - TASK_NUM_START] = xTaskNumber;
-            }
-            else
-            {
-                task_nums[trcIndex][SCHED_TASK_NUM - 3] = xTaskNumber;
-            }
-        }
-        // Idle Task
-        else
+        portENTER_CRITICAL_SAFE(&xDeadlineLocks[xCore]);
+        if (heapIS_EMPTY(xTCBDeadlineListOfCore) || (((long int)heapGET_HEAD_VALUE(xTCBDeadlineListOfCore) - (long int)xCurTick) >= 0))
         {
-            if (xTCBNumber == IDLE_TASK_NUM)
-            {
-                task_nums[trcIndex][SCHED_TASK_NUM - 4] = IDLE_TASK_NUM;
-            }
+            portEXIT_CRITICAL_SAFE(&xDeadlineLocks[xCore]);
+            break;
         }
+        xTCB = heapGET_HEAD_OWNER(xTCBDeadlineListOfCore);
+        uxEDFHeapRemove(&xTCB->xDeadlineHeapItem);
+        xTCB->deadlineExceeded = pdTRUE;
+        portEXIT_CRITICAL_SAFE(&xDeadlineLocks[xCore]);
+
+        EDF_TRACE_EVENT(EDF_TRACE_DEADLINE_MISS, xTCB->xTaskNumber);
+        edfSTATS_COUNT(xTCB, ulDeadlineMisses);
+        EDFSignalScheduler(SWITCH_ON_DEADLINE_OVERFLOW, xTCB);
     }
 }
+#endif
 
-void switchedOutTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
+static void EDFReleaseAperiodicJobs(BaseType_t * pxHigherPriorityTaskWoken)
 {
-    if (trcIndex < TRACE_ARRAY_SIZE)
+    // aperiodic arrivals, handled for run queue 0 only
+    #if USE_TBS == 0
+    // the server suspends itself while no job has arrived, resume it once a declared job is due or a job is submitted
+    if (EDFAperiodicServerHandle != NULL)
     {
-        // Periodic, Aperiodic Tasks and the Scheduler
-        if (xTaskNumber != 0)
+        if ((xEDFArrivalPending() == pdTRUE) || (EDFAperiodicJobDue() == pdTRUE))
         {
-            if (xTaskNumber < SCHED_TASK_NUM)
-            {
-                task_nums[trcIndex][xTaskNumber - TASK_NUM_START] = xTaskNumber;
-            }
-            else
-            {
-                task_nums[trcIndex][SCHED_TASK_NUM - 3] = xTaskNumber;
-            }
+            EDFWakeAperiodicServer(pxHigherPriorityTaskWoken);
         }
-        // Idle Task
-        else
+    }
+    #else
+    (void)pxHigherPriorityTaskWoken;
+    EDFTBSReleaseDeclaredJobs();
+    #endif
+}
+
+// ******************************************************************* //
+// ********************* Tick hook Function ************************** //
+#if USE_EDF_TICKLESS == 1
+void vApplicationTickHook(void)
+{
+    // the schedulers arm their event timers for everything polled here in tick mode
+    return;
+}
+#else
+void vApplicationTickHook(void)
+{
+    // runs on every core, checks the execution time of the task of this core and wakes the scheduler of its run queue
+    BaseType_t xCore = edfCURRENT_CORE();
+    BaseType_t xQueue = edfRUN_QUEUE_OF_CORE(xCore);
+    TaskHandle_t curTaskHandle = xTaskGetCurrentTaskHandle();
+
+    if (startEDF == pdFALSE || curTaskHandle == EDFGenHandle)
+    {
+        return;
+    }
+
+    #if USE_WCET_CHECKS == 1
+    if ((EarliestSchedWakeUp[xQueue] != 0) && (((long int)EarliestSchedWakeUp[xQueue] - (long int)xTaskGetTickCountFromISR()) <= 0))
+    {
+        EarliestSchedWakeUp[xQueue] = 0;
+        EDFWakeScheduler(xQueue, SWITCH_ON_WCET_WAKEUP);
+    }
+    #endif
+
+    if (xCore == 0)
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        EDFReleaseAperiodicJobs(&xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+
+    #if EDF_NUM_OF_CORES > 1
+    TaskHandle_t idleTaskHandle = xTaskGetIdleTaskHandleForCPU(xCore);
+    #else
+    TaskHandle_t idleTaskHandle = xTaskGetIdleTaskHandle();
+    #endif
+    extTCB_t * curTaskTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(curTaskHandle, LOCAL_STORAGE_INDEX);
+
+    #if USE_CBS == 1
+    if ((curTaskHandle == EDFAperiodicServerHandle) & (curTaskHandle != NULL))
+    {
+        EDFCBSConsumeBudget();
+    }
+    #endif
+
+    // only EDF tasks have an extended TCB, other tasks (e.g. the log drain task) are not checked
+    if ((curTaskHandle != NULL) & (curTaskHandle != idleTaskHandle) & (curTaskHandle != EDFSchedulerHandle[xQueue]) & (curTaskHandle != EDFAperiodicServerHandle) & (curTaskTCB != NULL))
+    {
+        EDFCheckRunningTask(xQueue, curTaskTCB, edfCLOCK_US());
+    }
+
+    #if USE_DEADLINE_CHECKS == 1
+    // O(1) while no deadline has passed. The tick of the core the run queue is named after watches it, with global EDF
+    // that is core 0 for all the jobs
+    if (xCore == xQueue)
+    {
+        EDFCheckDeadlines(xQueue, xTaskGetTickCountFromISR());
+    }
+    #endif
+}
+#endif
+// ******************************************************************* //
+
+#if USE_EDF_TICKLESS == 1
+// ********************* Event Timer Functions *********************** //
+static int64_t EDFEarlier(int64_t xDelay, int64_t xOtherDelay)
+{
+    return (xOtherDelay < xDelay) ? xOtherDelay : xDelay;
+}
+
+static int64_t EDFTicksUntil(TickType_t xTick, TickType_t xCurTick)
+{
+    // delay in us of an event counted in ticks. The clock has moved on within the current tick, so the timer expires
+    // within the tick of the event, as late as the tick hook would find it. An event that is due already but could not
+    // be handled is retried a tick later
+    long int lTicks = (long int)xTick - (long int)xCurTick;
+
+    return edfTICKS_TO_US((lTicks > 0) ? lTicks : 1);
+}
+
+static void EDFEventTimerCallback(void * arg)
+{
+    EDFWakeScheduler((BaseType_t)(intptr_t)arg, SWITCH_ON_EVENT_TIMER);
+}
+
+static UBaseType_t EDFRunningTasks(BaseType_t xCore, extTCB_t ** pxTasks)
+{
+    // the jobs the scheduler of the run queue has given a core to in its last pass
+    #if USE_GLOBAL_EDF == 1
+    (void)xCore;
+    memcpy(pxTasks, xGlobalRunningTasks, uxNumOfGlobalRunningTasks * sizeof(extTCB_t *));
+    return uxNumOfGlobalRunningTasks;
+    #else
+    pxTasks[0] = currentRunningTaskOfCore[xCore];
+    return (pxTasks[0] != NULL) ? 1 : 0;
+    #endif
+}
+
+static uint32_t EDFEventTimerExpired(BaseType_t xCore)
+{
+    // runs in the scheduler of the run queue and does what the tick hook does in tick mode, returns the events the
+    // following pass has to handle as well
+    extTCB_t * pxTasks[EDF_NUM_OF_CORES];
+    UBaseType_t uxNumOfTasks = EDFRunningTasks(xCore, pxTasks);
+    int64_t xNow = edfCLOCK_US();
+    #if (USE_DEADLINE_CHECKS == 1) || (USE_WCET_CHECKS == 1)
+    TickType_t xCurTick = xTaskGetTickCount();
+    #endif
+    uint32_t ulEvents = 0;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
+    {
+        #if USE_CBS == 1
+        if (pxTasks[i] == &xCBSServerTCB)
         {
-            if (xTCBNumber == IDLE_TASK_NUM)
-            {
-                task_nums[trcIndex][SCHED_TASK_NUM - 4] = IDLE_TASK_NUM;
-            }
+            EDFCBSConsumeBudget();
+            continue;
         }
+        #endif
+        EDFCheckRunningTask(xCore, pxTasks[i], xNow);
+    }
+
+    #if USE_DEADLINE_CHECKS == 1
+    EDFCheckDeadlines(xCore, xCurTick);
+    #endif
+
+    #if USE_WCET_CHECKS == 1
+    if ((EarliestSchedWakeUp[xCore] != 0) && (((long int)EarliestSchedWakeUp[xCore] - (long int)xCurTick) <= 0))
+    {
+        EarliestSchedWakeUp[xCore] = 0;
+        ulEvents |= SWITCH_ON_WCET_WAKEUP;
     }
+    #endif
+
+    if (xCore == 0)
+    {
+        // the scheduler has the highest priority, resuming the server cannot require a yield
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        EDFReleaseAperiodicJobs(&xHigherPriorityTaskWoken);
+    }
+    return ulEvents;
 }
 
-void switchedInTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
+static void EDFArmEventTimer(BaseType_t xCore)
 {
-    if (trcIndex < TRACE_ARRAY_SIZE)
+    // the earliest of: the WCET (or CBS budget) of a job holding a core running out, a deadline being missed, the resume
+    // of the WCET suspended tasks and, for run queue 0, the next aperiodic arrival. Job releases are left to the
+    // delayed list of the kernel, which also accounts for them in tickless idle
+    esp_timer_handle_t xTimer = xEventTimer[xCore];
+    TickType_t xCurTick = xTaskGetTickCount();
+    int64_t xDelay = INT64_MAX;
+
+    #if (USE_WCET_CHECKS == 1) || (USE_CBS == 1)
+    extTCB_t * pxTasks[EDF_NUM_OF_CORES];
+    UBaseType_t uxNumOfTasks = EDFRunningTasks(xCore, pxTasks);
+    int64_t xNow = edfCLOCK_US();
+    extTCB_t * xTCB;
+
+    for (UBaseType_t i = 0; i < uxNumOfTasks; i++)
     {
-        // Periodic, Aperiodic Tasks and the Scheduler
-        if (xTaskNumber != 0)
+        xTCB = pxTasks[i];
+        #if USE_CBS == 1
+        if (xTCB == &xCBSServerTCB)
         {
-            if (xTaskNumber < SCHED_TASK_NUM)
-            {
-                task_nums[trcIndex][xTaskNumber - TASK_NUM_START] = xTaskNumber;
-            }
-            else
+            if (xTCB->status == TASK_RUNNING)
             {
-                task_nums[trcIndex][SCHED_TASK_NUM - 3] = xTaskNumber;
+                xDelay = EDFEarlier(xDelay, xCBSBudget - EDFExecTime(xTCB, xNow));
             }
+            continue;
         }
-        // Idle Task
-        else
+        #endif
+        #if USE_WCET_CHECKS == 1
+        if (edfWCET_CHECKED(xTCB))
         {
-            if (xTCBNumber == IDLE_TASK_NUM)
-            {
-                task_nums[trcIndex][SCHED_TASK_NUM - 4] = IDLE_TASK_NUM;
-            }
+            xDelay = EDFEarlier(xDelay, edfTICKS_TO_US(xTCB->WCET) - EDFExecTime(xTCB, xNow) + 1);
         }
+        #endif
     }
-}
-#endif
-// ********************************************************************* //
-// ******************* ESP TRACE Funtions ****************************** //
-#ifdef ESP_TRACE_CONFIG
+    #endif
 
-void ESPSwitchedOutTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
-{
-    if (eventIndex < MAX_NUM_OF_EVENTS)
+    #if USE_DEADLINE_CHECKS == 1
+    // a deadline is missed once the tick after it has started, the earliest one of the pending jobs comes first
+    portENTER_CRITICAL_SAFE(&xDeadlineLocks[xCore]);
+    if (!heapIS_EMPTY(&xTCBDeadlineList[xCore]))
+    {
+        xDelay = EDFEarlier(xDelay, EDFTicksUntil(heapGET_HEAD_VALUE(&xTCBDeadlineList[xCore]) + 1, xCurTick));
+    }
+    portEXIT_CRITICAL_SAFE(&xDeadlineLocks[xCore]);
+    #endif
+
+    #if USE_WCET_CHECKS == 1
+    if (EarliestSchedWakeUp[xCore] != 0)
+    {
+        xDelay = EDFEarlier(xDelay, EDFTicksUntil(EarliestSchedWakeUp[xCore], xCurTick));
+    }
+    #endif
+
+    if (xCore == 0)
     {
-        // Periodic, Aperiodic Tasks and the Scheduler
-        if (xTaskNumber != 0)
+        #if USE_TBS == 0
+        // a submitted job is retried every tick until the server has taken it
+        if ((EDFAperiodicServerHandle != NULL) && (xEDFArrivalPending() == pdTRUE))
+        {
+            xDelay = EDFEarlier(xDelay, EDFTicksUntil(xCurTick, xCurTick));
+        }
+        if ((EDFAperiodicServerHandle != NULL) && (aperiodicJobPointer < xNoOfAperiodicTasks))
         {
-            eventArray[eventIndex][2] = esp_timer_get_time();
-            eventIndex++;
+            xDelay = EDFEarlier(xDelay, EDFTicksUntil(aperiodicTCBQueue[aperiodicJobPointer]->phase + xSysStartTime, xCurTick));
         }
-        // Idle Task
-        else if ((xTCBNumber == IDLE_TASK_NUM) && (xTaskNumber == 0))
+        #else
+        if (aperiodicJobPointer < xNoOfAperiodicTasks)
         {
-            eventArray[eventIndex][2] = esp_timer_get_time();
-            eventIndex++;
+            xDelay = EDFEarlier(xDelay, EDFTicksUntil(xTBSDeclaredJobs[aperiodicJobPointer].arrivalTime + xSysStartTime, xCurTick));
         }
+        #endif
+    }
+
+    // stopping a timer that has expired already fails, which is fine
+    (void)esp_timer_stop(xTimer);
+    if (xDelay != INT64_MAX)
+    {
+        ESP_ERROR_CHECK(esp_timer_start_once(xTimer, (uint64_t)((xDelay > 0) ? xDelay : 1)));
     }
 }
+// ******************************************************************* //
+#endif
 
-void ESPSwitchedInTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
+// ********************* Idle Hook Definition ************************ //
+// the application enables the idle hook (CONFIG_FREERTOS_USE_IDLE_HOOK), the library has nothing to do in it
+void vApplicationIdleHook(void)
+{
+    return;
+}
+// ******************************************************************* //
+// ************************ Trace Functions ************************** //
+#if USE_EDF_TRACE == 1
+static uint32_t EDFTraceTaskNumber(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
 {
-    if (eventIndex < MAX_NUM_OF_EVENTS)
+    // the library numbers its own tasks, of all others only the idle task is told apart
+    if (xTaskNumber != 0)
     {
-        // Periodic, Aperiodic Tasks and the Scheduler
-        if (xTaskNumber != 0)
-        {
-            eventArray[eventIndex][0] = xTaskNumber;
-            eventArray[eventIndex][1] = esp_timer_get_time();
-        }
-        // Idle Task
-        else if ((xTCBNumber == IDLE_TASK_NUM) && (xTaskNumber == 0))
-        {
-            eventArray[eventIndex][0] = IDLE_TASK_NUM;
-            eventArray[eventIndex][1] = esp_timer_get_time();
-        }
+        return (uint32_t)xTaskNumber;
     }
+    return (xTCBNumber == IDLE_TASK_NUM) ? EDF_TRACE_TASK_IDLE : EDF_TRACE_TASK_OTHER;
+}
+
+void EDFTraceSwitchedOut(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
+{
+    EDF_TRACE_EVENT(EDF_TRACE_SWITCH_OUT, EDFTraceTaskNumber(xTaskNumber, xTCBNumber));
 }
 
+void EDFTraceSwitchedIn(BaseType_t xTaskNumber, BaseType_t xTCBNumber)
+{
+    EDF_TRACE_EVENT(EDF_TRACE_SWITCH_IN, EDFTraceTaskNumber(xTaskNumber, xTCBNumber));
+}
 #endif
 // ******************************************************************** //
\ No newline at end of file
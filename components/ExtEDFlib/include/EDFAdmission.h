@@ -0,0 +1,54 @@
+/*
+    File Description:
+        Admission tests for periodic tasks with constrained deadlines (relative deadline <= period). Every core
+        admits its own task set with the processor-demand criterion h(t) <= t, walking the deadlines backwards as in
+        QPA (Zhang and Burns). The result is exact and also gives the tightest slack min(t - h(t)). The walk ends at
+        the deadline after which t - h(t) >= (1 - U) * t - sum(C * (T - D) / T) rules out a tighter slack, or at the
+        end of the busy period when U is too close to 1 for that bound. The walk stops at EDF_ADMISSION_HORIZON, a
+        busy period beyond it gives EDF_ADMISSION_UNDECIDED and a bound beyond it the tightest slack up to it.
+
+        Global EDF (USE_GLOBAL_EDF) admits one task set for all cores if it passes the sufficient GFB density bound
+        or the BCL interference test. With EDF-US (USE_GLOBAL_EDF_US) every task denser than m / (2m - 1) takes a
+        core of its own. All arithmetic is on integer ticks, and the tests are called from task context only.
+*/
+
+#ifndef _EDF_ADMISSION_H_
+#define _EDF_ADMISSION_H_
+
+#include "commonDefines.h"
+#include "freertos/FreeRTOS.h"
+
+// ************************* Admission Defines **************************** //
+// result of a test whose walk would pass EDF_ADMISSION_HORIZON, nothing is admitted (pdTRUE and pdFALSE are exact)
+#define EDF_ADMISSION_UNDECIDED             ((BaseType_t)2)
+// ************************************************************************ //
+
+// ********************** Function Declarations *************************** //
+void vEDFAdmissionInit(void);
+// pdTRUE if the admitted tasks together with the candidate are schedulable, nothing is admitted. pxSlack (may be
+// NULL) is set to the tightest slack on acceptance, to the first overload found on rejection and to 0 otherwise
+BaseType_t xEDFAdmissionTest(BaseType_t xCore, TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline, TickType_t * pxSlack);
+// same as xEDFAdmissionTest, the candidate is admitted if it passes
+BaseType_t xEDFAdmissionAdd(BaseType_t xCore, TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline, TickType_t * pxSlack);
+// removes an admitted task with these parameters, pdFALSE if there is none
+BaseType_t xEDFAdmissionRemove(BaseType_t xCore, TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline);
+// a trial tests a candidate against a copy of the admitted tasks of a core (run queue 0 with global EDF) from which
+// some of them were removed, the admitted tasks are left as they are. One trial at a time, from task context
+void vEDFAdmissionTrialBegin(BaseType_t xCore);
+// removes a task with these parameters from the copy, pdFALSE if there is none
+BaseType_t xEDFAdmissionTrialRemove(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline);
+// result of xEDFAdmissionTest (xEDFGlobalAdmissionTest with global EDF) for the copy, nothing is admitted
+BaseType_t xEDFAdmissionTrialTest(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline);
+#if USE_GLOBAL_EDF == 1
+// pdTRUE if the admitted tasks together with the candidate pass a global EDF test on EDF_NUM_OF_CORES cores
+BaseType_t xEDFGlobalAdmissionTest(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline);
+// same as xEDFGlobalAdmissionTest, the candidate is admitted if it passes
+BaseType_t xEDFGlobalAdmissionAdd(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline);
+// removes an admitted task with these parameters from the global task set, pdFALSE if there is none
+BaseType_t xEDFGlobalAdmissionRemove(TickType_t xWCET, TickType_t xPeriod, TickType_t xRelDeadline);
+// pdTRUE if EDF-US runs the jobs of the task ahead of every deadline, always pdFALSE without USE_GLOBAL_EDF_US
+BaseType_t xEDFGlobalIsTopPriority(TickType_t xWCET, TickType_t xRelDeadline);
+#endif
+// ************************************************************************ //
+
+#endif // _EDF_ADMISSION_H_
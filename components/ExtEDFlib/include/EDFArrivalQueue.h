@@ -0,0 +1,46 @@
+/*
+    File Description:
+        Bounded multi-producer, single-consumer queue of aperiodic jobs submitted at runtime with
+        EDFSubmitAperiodicJob() or EDFSubmitAperiodicJobFromISR(). Every record is a copy of the job (function,
+        parameters, WCET) stamped with the tick it arrived in, so the submitter keeps no memory alive.
+
+        It is an EDFRing_t (EDFRing.h), so jobs can be submitted from tasks and ISRs on any core. A full queue
+        rejects the job instead of waiting (backpressure), the submitter decides whether to retry or drop it. Only the consumer of the active
+        aperiodic policy receives: the aperiodic server (background or CBS), or with USE_TBS the scheduler task
+        of run queue 0, which hands every job with its TBS deadline to an idle worker task.
+*/
+
+#ifndef _EDF_ARRIVAL_QUEUE_H_
+#define _EDF_ARRIVAL_QUEUE_H_
+
+#include "commonDefines.h"
+#include "freertos/FreeRTOS.h"
+
+#if (EDF_ARRIVAL_QUEUE_SIZE & (EDF_ARRIVAL_QUEUE_SIZE - 1)) != 0
+#error "EDF_ARRIVAL_QUEUE_SIZE must be a power of 2"
+#endif
+
+// ************************* Data Structures ***************************** //
+typedef struct EDFAperiodicJob
+{
+    const char * taskName;
+    void (*instanceFunc)(void*);
+    void * instanceParams;
+    uint32_t stackSize;                     // not used, the jobs run on the stack of the server or of a TBS worker
+    TickType_t WCET;
+    TickType_t arrivalTime;                 // tick the job was submitted in
+    BaseType_t xTaskNumber;                 // traced as this task, APERIODIC_SERVER_NUM for submitted jobs
+} EDFAperiodicJob_t;
+// *********************************************************************** //
+
+// ********************** Function Declarations *************************** //
+void vEDFArrivalQueueInit(void);
+// returns pdFALSE if the queue is full, callable from tasks and ISRs
+BaseType_t xEDFArrivalSend(const EDFAperiodicJob_t * pxJob);
+// returns pdFALSE if no published job is pending, consumer only
+BaseType_t xEDFArrivalReceive(EDFAperiodicJob_t * pxJob);
+// pdTRUE if a job was submitted and not yet received, callable from tasks and ISRs
+BaseType_t xEDFArrivalPending(void);
+// ************************************************************************ //
+
+#endif // _EDF_ARRIVAL_QUEUE_H_
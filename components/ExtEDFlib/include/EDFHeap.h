@@ -0,0 +1,59 @@
+/*
+    File Description:
+        Intrusive binary min-heap used by the EDF library in place of the sorted FreeRTOS lists for the
+        ready, blocked and initial task sets. Items are embedded in the owning structure (like a
+        FreeRTOS ListItem_t) and remember their position in the heap, so that insertion and removal of an
+        arbitrary item are O(log n) and the item with the smallest value can be read in O(1).
+
+        The heap array is provided by the caller so that no memory is allocated at runtime. Values are ticks and
+        compared across a tick overflow, so the values in one heap must be less than half the tick range apart.
+        Items with equal values come out in no particular order.
+*/
+
+#ifndef _EDF_HEAP_H_
+#define _EDF_HEAP_H_
+
+#include "freertos/FreeRTOS.h"
+
+struct EDFHeap;
+
+typedef struct EDFHeapItem
+{
+    TickType_t xItemValue;              // value the heap is ordered on (e.g. absolute deadline)
+    UBaseType_t uxIndex;                // current position of the item inside the heap array
+    void * pvOwner;                     // structure that contains the item
+    struct EDFHeap * pxContainer;       // heap the item is in, NULL if not in any heap
+} EDFHeapItem_t;
+
+typedef struct EDFHeap
+{
+    EDFHeapItem_t ** pxItems;
+    UBaseType_t uxNumberOfItems;
+    UBaseType_t uxCapacity;
+} EDFHeap_t;
+
+// ************************* Access Macros ******************************* //
+#define heapSET_ITEM_OWNER(pxItem, pxOwner)         ((pxItem)->pvOwner = (void *)(pxOwner))
+#define heapGET_ITEM_OWNER(pxItem)                  ((pxItem)->pvOwner)
+#define heapSET_ITEM_VALUE(pxItem, xValue)          ((pxItem)->xItemValue = (xValue))
+#define heapGET_ITEM_VALUE(pxItem)                  ((pxItem)->xItemValue)
+#define heapIS_EMPTY(pxHeap)                        ((pxHeap)->uxNumberOfItems == (UBaseType_t)0)
+#define heapCURRENT_LENGTH(pxHeap)                  ((pxHeap)->uxNumberOfItems)
+#define heapGET_HEAD_ITEM(pxHeap)                   ((pxHeap)->pxItems[0])
+#define heapGET_HEAD_OWNER(pxHeap)                  (heapGET_HEAD_ITEM(pxHeap)->pvOwner)
+#define heapGET_HEAD_VALUE(pxHeap)                  (heapGET_HEAD_ITEM(pxHeap)->xItemValue)
+#define heapGET_ITEM_AT(pxHeap, uxIndex)            ((pxHeap)->pxItems[(uxIndex)])
+#define heapIS_CONTAINED_WITHIN(pxHeap, pxItem)     ((pxItem)->pxContainer == (pxHeap))
+// values are ticks less than half the tick range apart, the earlier of two sorts first across a tick overflow. The
+// difference wraps in TickType_t, which need not be as wide as long int (32-bit ticks on a 64-bit host)
+#define heapIS_BEFORE(xValue, xOtherValue)          (((TickType_t)((TickType_t)(xValue) - (TickType_t)(xOtherValue)) > (portMAX_DELAY >> 1)) ? pdTRUE : pdFALSE)
+// *********************************************************************** //
+
+// ********************** Function Declarations *************************** //
+void vEDFHeapInitialise(EDFHeap_t * pxHeap, EDFHeapItem_t ** pxStorage, UBaseType_t uxCapacity);
+void vEDFHeapInitialiseItem(EDFHeapItem_t * pxItem);
+void vEDFHeapInsert(EDFHeap_t * pxHeap, EDFHeapItem_t * pxItem);
+UBaseType_t uxEDFHeapRemove(EDFHeapItem_t * pxItem);
+void vEDFHeapUpdateValue(EDFHeapItem_t * pxItem, TickType_t xNewValue);
+
+#endif // _EDF_HEAP_H_
@@ -0,0 +1,33 @@
+/*
+    File Description:
+        Kernel-native EDF (configUSE_EDF): the EDF tasks all run at configEDF_PRIORITY and the kernel keeps the
+        ready list of that priority ordered by the absolute deadline of their jobs, so that vTaskSwitchContext()
+        selects the earliest deadline itself. There is no scheduler task and no priority is ever changed.
+
+        The kernel is not patched, the trace hooks of traceMacros.h call in here from tasks.c, where the ready lists
+        are. traceMOVED_TASK_TO_READY_STATE runs right before the kernel appends the task in front of the index of
+        the ready list (listINSERT_END), so the index is moved to the first task with a later deadline first. Before
+        every selection (traceTASK_SWITCHED_OUT) the index is put back to the end of the list, and the round robin
+        walk of taskSELECT_HIGHEST_PRIORITY_TASK() then starts at the head. Equal deadlines keep their order.
+
+        The list item value of a ready task, unused by the kernel, holds its deadline. configEDF_PRIORITY belongs
+        to the EDF tasks, other tasks at that priority are appended at the end. Single core kernels only.
+*/
+
+#ifndef _EDF_KERNEL_H_
+#define _EDF_KERNEL_H_
+
+#include "commonDefines.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/list.h"
+
+// ********************** Function Declarations *************************** //
+// traceMOVED_TASK_TO_READY_STATE, places the index of pxReadyList so that the kernel inserts pxItem in deadline
+// order, returns pdTRUE if the task preempts xCurrentTask (the kernel does not preempt at the same priority)
+BaseType_t xEDFKernelPlaceReadyTask(List_t * pxReadyList, ListItem_t * pxItem, TaskHandle_t xCurrentTask);
+// traceTASK_SWITCHED_OUT, orders the task that leaves the processor again and starts the selection at the head
+void vEDFKernelSelectEarliest(List_t * pxReadyList, ListItem_t * pxCurrentItem);
+// ************************************************************************ //
+
+#endif // _EDF_KERNEL_H_
@@ -0,0 +1,109 @@
+/*
+    File Description:
+        Binary log of the EDF library. Records of fixed size (event id, timestamp and up to four arguments) are
+        written in constant time into a lock-free ring per core, formatting is deferred to a low priority drain
+        task (USE_LOG_DRAIN_TASK) or to the application / host reading the raw records with xEDFLogRead().
+
+        The ring of a core is an EDFRing_t (EDFRing.h), so writers may be tasks or ISRs on any core and a single
+        reader takes the records. When the ring is full the record is dropped and counted, writers never wait for
+        the reader.
+
+        EDF_LOG_LEVEL in commonDefines.h selects which records are compiled in, 0 removes logging entirely.
+*/
+
+#ifndef _EDF_LOG_H_
+#define _EDF_LOG_H_
+
+#include "commonDefines.h"
+#include "freertos/FreeRTOS.h"
+
+// ************************** Log Defines ******************************** //
+#define EDF_LOG_LEVEL_NONE                  0
+#define EDF_LOG_LEVEL_ERROR                 1
+#define EDF_LOG_LEVEL_INFO                  2
+
+#define EDF_LOG_NUM_OF_ARGS                 4
+
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS                  1
+#endif
+
+#if portNUM_PROCESSORS > 1
+#define edfLOG_CORE_ID()                    xPortGetCoreID()
+#else
+#define edfLOG_CORE_ID()                    0
+#endif
+
+#if (EDF_LOG_RING_SIZE & (EDF_LOG_RING_SIZE - 1)) != 0
+#error "EDF_LOG_RING_SIZE must be a power of 2"
+#endif
+// *********************************************************************** //
+
+// ************************* Data Structures ***************************** //
+// Arguments of every event are listed next to it, task numbers are the xTaskNumber of the EDF TCBs
+typedef enum EDFLogEvent
+{
+    EDF_LOG_JOB_START = 0,                  // task, arrival time, absDeadline, priority
+    EDF_LOG_JOB_END,                        // task, next absDeadline, completion tick
+    EDF_LOG_APERIODIC_START,                // task
+    EDF_LOG_APERIODIC_END,                  // task
+    EDF_LOG_TASK_CREATED,                   // task, priority, period, release time
+    EDF_LOG_TASK_CREATE_FAILED,             // task
+    EDF_LOG_SERVER_CREATED,                 // number of aperiodic tasks
+    EDF_LOG_SERVER_CREATE_FAILED,           // -
+    EDF_LOG_SYSTEM_START,                   // start tick
+    EDF_LOG_WCET_RESUMED,                   // task, resume tick, absDeadline, period
+    EDF_LOG_WCET_OVERFLOW,                  // task, WCET and measured execution time in us, next unblock time
+    EDF_LOG_DEADLINE_MISS,                  // task, absDeadline, current tick
+    EDF_LOG_CBS_POSTPONED,                  // new server deadline, current tick
+    EDF_LOG_APERIODIC_REJECTED,             // arrival tick
+    EDF_LOG_TASK_REMOVED,                   // task, deadline of its last job
+    EDF_LOG_JOB_ABORTED,                    // task, current tick, next release
+    EDF_LOG_JOB_EXTENDED,                   // task, current tick, new absDeadline
+    EDF_LOG_TASK_ADMITTED,                  // run queue, periodic utilization in permille, slack
+    EDF_LOG_TASK_REJECTED,                  // period, relDeadline, WCET
+    EDF_LOG_TASK_LIMIT,                     // period, relDeadline, WCET
+    EDF_LOG_POLICY_REJECTED,                // period, relDeadline, WCET
+    EDF_LOG_NUM_OF_EVENTS
+} EDFLogEvent_t;
+
+typedef struct EDFLogRecord
+{
+    uint32_t ulSequence;                    // of the ring, written last to publish the record
+    uint32_t ulTimestamp;                   // esp_timer_get_time() in us, wraps after ~71 minutes
+    uint32_t ulEvent;                       // EDFLogEvent_t
+    uint32_t ulArgs[EDF_LOG_NUM_OF_ARGS];
+} EDFLogRecord_t;
+// *********************************************************************** //
+
+// ************************** Log Macros ********************************* //
+#if EDF_LOG_LEVEL >= EDF_LOG_LEVEL_ERROR
+#define EDF_LOG_ERROR(event, a0, a1, a2, a3)    vEDFLogWrite((event), (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3))
+#else
+#define EDF_LOG_ERROR(event, a0, a1, a2, a3)
+#endif
+
+#if EDF_LOG_LEVEL >= EDF_LOG_LEVEL_INFO
+#define EDF_LOG_INFO(event, a0, a1, a2, a3)     vEDFLogWrite((event), (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3))
+#else
+#define EDF_LOG_INFO(event, a0, a1, a2, a3)
+#endif
+// *********************************************************************** //
+
+// ********************** Function Declarations *************************** //
+#if EDF_LOG_LEVEL > EDF_LOG_LEVEL_NONE
+void vEDFLogInit(void);
+void vEDFLogWrite(uint32_t ulEvent, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2, uint32_t ulArg3);
+BaseType_t xEDFLogRead(BaseType_t xCore, EDFLogRecord_t * pxRecord);
+uint32_t ulEDFLogGetDropped(BaseType_t xCore);
+void vEDFLogPrintRecord(BaseType_t xCore, const EDFLogRecord_t * pxRecord);
+void vEDFLogDrain(void);
+
+#if USE_LOG_DRAIN_TASK == 1
+void vEDFLogStartDrainTask(void);
+void vEDFLogStopDrainTask(void);
+#endif
+#endif
+// ************************************************************************ //
+
+#endif // _EDF_LOG_H_
@@ -0,0 +1,50 @@
+/*
+    File Description:
+        Allocation of the extended TCBs and creation of the FreeRTOS tasks of the EDF library.
+
+        With USE_STATIC_ALLOCATION the extended TCBs, the FreeRTOS task control blocks (StaticTask_t) and the
+        stacks of all EDF tasks live in arenas sized at compile time and tasks are created with xTaskCreateStatic,
+        so creating and deleting tasks (e.g. TBS jobs) never touches the heap. Otherwise the FreeRTOS heap
+        (pvPortMalloc / vPortFree) and xTaskCreate are used.
+        With EDF_NUM_OF_CORES > 1 tasks are created pinned to a core, EDF tasks to the core they were placed on,
+        with global EDF (USE_GLOBAL_EDF) EDF tasks are not pinned.
+
+        Pool functions are called from task context only.
+*/
+
+#ifndef _EDF_POOL_H_
+#define _EDF_POOL_H_
+
+#include "ExtEDFlib.h"
+
+// ************************* Data Structures ***************************** //
+// Tasks of the library itself, each has its own static task buffer and stack
+typedef enum EDFSystemTask
+{
+    EDF_SYSTEM_TASK_GENERATOR = 0,
+    EDF_SYSTEM_TASK_APERIODIC_SERVER,
+    EDF_SYSTEM_TASK_LOG_DRAIN,
+    EDF_SYSTEM_TASK_TRACE_DRAIN,
+    EDF_SYSTEM_TASK_SCHEDULER,              // one per core, EDF_SYSTEM_TASK_SCHEDULER + core, none with inline dispatch or configUSE_EDF
+#if (USE_EDF_INLINE_DISPATCH == 1) || (configUSE_EDF == 1)
+    EDF_NUM_OF_SYSTEM_TASKS = EDF_SYSTEM_TASK_SCHEDULER
+#else
+    EDF_NUM_OF_SYSTEM_TASKS = EDF_SYSTEM_TASK_SCHEDULER + EDF_NUM_OF_RUN_QUEUES
+#endif
+} EDFSystemTask_t;
+// *********************************************************************** //
+
+// ********************** Function Declarations *************************** //
+void vEDFPoolInit(void);
+extTCB_t * pxEDFAllocTCB(void);
+void vEDFFreeTCB(extTCB_t * xTCB);
+#if USE_TBS == 0
+extTCBA_t * pxEDFAllocTCBA(void);
+#endif
+// task of an extended TCB, the stack buffer is the one belonging to the TCB, pinned to xTCB->xCoreID
+BaseType_t xEDFCreateTask(extTCB_t * xTCB, TaskFunction_t pxTaskCode, const char * const pcName, uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask);
+// xCoreID is only used with EDF_NUM_OF_CORES > 1 and may be tskNO_AFFINITY
+BaseType_t xEDFCreateSystemTask(EDFSystemTask_t xSystemTask, TaskFunction_t pxTaskCode, const char * const pcName, uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, BaseType_t xCoreID);
+// ************************************************************************ //
+
+#endif // _EDF_POOL_H_
@@ -0,0 +1,40 @@
+/*
+    File Description:
+        Bounded multi-producer, single-consumer ring of fixed size slots, the scheduler signals (EDFSignalQueue.h),
+        the aperiodic arrivals (EDFArrivalQueue.h) and the binary log (EDFLog.h) are built on it. The slot array is
+        provided by the caller, a slot is a structure of any size that starts with the uint32_t sequence of the ring.
+
+        Producers reserve a slot with a compare and swap on the head, write it in place and publish it by writing
+        its sequence number (its position + 1), which is safe from tasks and ISRs on any core. A full ring rejects
+        the slot instead of waiting. The single consumer reads the published slot in place and only then gives it
+        back to the producers by advancing the tail.
+*/
+
+#ifndef _EDF_RING_H_
+#define _EDF_RING_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct EDFRing
+{
+    uint8_t * pucSlots;
+    uint32_t ulSlotSize;                    // bytes, the slot starts with its sequence number
+    uint32_t ulMask;                        // number of slots - 1, the number of slots is a power of 2
+    uint32_t ulHead;                        // next slot to reserve, advanced by the producers
+    uint32_t ulTail;                        // next slot to receive, advanced by the consumer only
+} EDFRing_t;
+
+// ********************** Function Declarations *************************** //
+void vEDFRingInitialise(EDFRing_t * pxRing, void * pvSlots, uint32_t ulNumOfSlots, uint32_t ulSlotSize);
+// a slot to write, NULL if the ring is full. *pulPosition is handed to vEDFRingPublish, callable from tasks and ISRs
+void * pvEDFRingReserve(EDFRing_t * pxRing, uint32_t * pulPosition);
+void vEDFRingPublish(EDFRing_t * pxRing, uint32_t ulPosition);
+// the next slot to read, NULL if the ring is empty or that slot is reserved but not yet published, consumer only
+void * pvEDFRingPeek(EDFRing_t * pxRing);
+// gives the slot returned by pvEDFRingPeek back to the producers, consumer only
+void vEDFRingRelease(EDFRing_t * pxRing);
+// pdTRUE if a slot was reserved and not yet released, callable from tasks and ISRs
+BaseType_t xEDFRingPending(EDFRing_t * pxRing);
+// ************************************************************************ //
+
+#endif // _EDF_RING_H_
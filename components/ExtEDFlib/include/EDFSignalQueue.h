@@ -0,0 +1,31 @@
+/*
+    File Description:
+        Bounded multi-producer, single-consumer queue of scheduler signals. Every record carries one scheduler
+        event (SWITCH_ON_*) and the TCB it concerns, so that requests raised in the same tick by several tasks,
+        the tick hook or ISRs are all delivered to the EDF scheduler task instead of overwriting each other.
+
+        It is an EDFRing_t (EDFRing.h), so signals can be sent from tasks and ISRs, and only the scheduler task
+        receives them.
+        With EDF_NUM_OF_CORES > 1 every core has a queue of its own, consumed by the scheduler task of that core,
+        global EDF (USE_GLOBAL_EDF) has a single queue for its single scheduler task.
+*/
+
+#ifndef _EDF_SIGNAL_QUEUE_H_
+#define _EDF_SIGNAL_QUEUE_H_
+
+#include "commonDefines.h"
+#include "freertos/FreeRTOS.h"
+
+#if (EDF_SIGNAL_QUEUE_SIZE & (EDF_SIGNAL_QUEUE_SIZE - 1)) != 0
+#error "EDF_SIGNAL_QUEUE_SIZE must be a power of 2"
+#endif
+
+// ********************** Function Declarations *************************** //
+void vEDFSignalQueueInit(void);
+// returns pdFALSE if the queue is full, callable from tasks and ISRs
+BaseType_t xEDFSignalSend(BaseType_t xCore, uint32_t ulEvent, void * pvTCB);
+// returns pdFALSE if no published signal is pending, scheduler task of the core only
+BaseType_t xEDFSignalReceive(BaseType_t xCore, uint32_t * pulEvent, void ** ppvTCB);
+// ************************************************************************ //
+
+#endif // _EDF_SIGNAL_QUEUE_H_
@@ -0,0 +1,119 @@
+/*
+    File Description:
+        Compact binary trace of the scheduling events, streamed while the system runs. Every core writes its records
+        into one of two buffers, once that buffer is full (or the drain asks for it) the core continues in the other
+        one and the full buffer is handed to the drain, which passes it to a sink set with vEDFTraceSetSink(), e.g. a
+        file on the POSIX port or the UART on the device. A record is dropped and counted when both buffers of its
+        core are waiting for the drain, writers never wait.
+
+        Writers are the switch hooks, tasks and ISRs of one core, which mask the interrupts of that core for the few
+        bytes of a record. The drain runs in a low priority task (USE_TRACE_DRAIN_TASK) or wherever vEDFTraceDrain()
+        is called.
+
+        Stream format, little endian: a block is an EDFTraceBlockHeader_t followed by usLength bytes of records.
+        A record is the unsigned LEB128 varint of (delta << 3 | event), delta being the microseconds since the
+        previous record of the block (the first one since xBaseTime), followed by the varint of the task number
+        (EDFTraceTask_t below, xTaskNumber for the EDF tasks). A release record adds the varint of the microseconds
+        from the record to the deadline of the released job, 0 if that has passed already. Readers resynchronise on
+        EDF_TRACE_MAGIC, so the blocks may be interleaved with console text.
+
+        USE_EDF_TRACE in commonDefines.h compiles the trace in, 0 removes it entirely.
+*/
+
+#ifndef _EDF_TRACE_H_
+#define _EDF_TRACE_H_
+
+#include "commonDefines.h"
+#include "freertos/FreeRTOS.h"
+
+// ************************** Trace Defines ****************************** //
+#define EDF_TRACE_MAGIC                     0x54464445UL // "EDFT"
+#define EDF_TRACE_VERSION                   2
+#define EDF_TRACE_EVENT_BITS                3
+#define EDF_TRACE_MAX_RECORD                20 // bytes, varints of 64, 32 and 32 bits
+
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS                  1
+#endif
+
+#if portNUM_PROCESSORS > 1
+#define edfTRACE_CORE_ID()                  xPortGetCoreID()
+#else
+#define edfTRACE_CORE_ID()                  0
+#endif
+
+#if EDF_TRACE_BUFFER_SIZE > 0xFFFF
+#error "EDF_TRACE_BUFFER_SIZE must fit the 16 bit length of a block"
+#endif
+// *********************************************************************** //
+
+// ************************* Data Structures ***************************** //
+// Argument of every event is the task it happened to
+typedef enum EDFTraceEvent
+{
+    EDF_TRACE_SWITCH_IN = 0,                // the task got the processor
+    EDF_TRACE_SWITCH_OUT,                   // the task left the processor
+    EDF_TRACE_RELEASE,                      // a job of the task was released
+    EDF_TRACE_BLOCK,                        // the job completed, the task waits for its next release
+    EDF_TRACE_WCET_OVERFLOW,                // the job ran past its WCET
+    EDF_TRACE_DEADLINE_MISS,                // the job missed its deadline
+    EDF_TRACE_NUM_OF_EVENTS
+} EDFTraceEvent_t;
+
+// Task numbers of the tasks that are not EDF tasks, below TASK_NUM_START
+typedef enum EDFTraceTask
+{
+    EDF_TRACE_TASK_OTHER = 0,               // tasks outside the library, e.g. the timer service task
+    EDF_TRACE_TASK_SCHEDULER,               // the scheduler task of any core
+    EDF_TRACE_TASK_SERVER,                  // the aperiodic server and the jobs submitted at runtime
+    EDF_TRACE_TASK_IDLE                     // IDLE_TASK_NUM
+} EDFTraceTask_t;
+
+typedef struct EDFTraceBlockHeader
+{
+    uint32_t ulMagic;                       // EDF_TRACE_MAGIC
+    uint8_t ucVersion;                      // EDF_TRACE_VERSION
+    uint8_t ucCore;
+    uint16_t usLength;                      // bytes of records following the header
+    uint32_t ulSequence;                    // blocks of the core before this one, a gap means lost blocks
+    uint32_t ulDropped;                     // records dropped on the core before the end of this block
+    int64_t xBaseTime;                      // edfCLOCK_US() the first delta of the block counts from
+} EDFTraceBlockHeader_t;
+
+// Called by the drain with one block (header and records) at a time, from task context
+typedef void (*EDFTraceSink_t)(const void * pvData, size_t xLength);
+// *********************************************************************** //
+
+// ************************** Trace Macros ******************************* //
+#if USE_EDF_TRACE == 1
+#define EDF_TRACE_EVENT(event, xTaskNumber)     vEDFTraceWrite((event), (uint32_t)(xTaskNumber))
+#define EDF_TRACE_RELEASE_EVENT(xTaskNumber, xDeadline)\
+vEDFTraceWriteRelease((uint32_t)(xTaskNumber), (xDeadline))
+#else
+#define EDF_TRACE_EVENT(event, xTaskNumber)
+#define EDF_TRACE_RELEASE_EVENT(xTaskNumber, xDeadline)
+#endif
+// *********************************************************************** //
+
+// ********************** Function Declarations *************************** //
+#if USE_EDF_TRACE == 1
+void vEDFTraceInit(void);
+void vEDFTraceWrite(uint32_t ulEvent, uint32_t ulTaskNumber);
+// release of a job with the absolute deadline xDeadline (ticks)
+void vEDFTraceWriteRelease(uint32_t ulTaskNumber, TickType_t xDeadline);
+// NULL discards the blocks
+void vEDFTraceSetSink(EDFTraceSink_t xSink);
+uint32_t ulEDFTraceGetDropped(BaseType_t xCore);
+// passes the full buffers to the sink and asks every core to hand over the buffer it writes
+void vEDFTraceDrain(void);
+// as above, the buffer of the calling core is handed over at once
+void vEDFTraceFlush(void);
+
+#if USE_TRACE_DRAIN_TASK == 1
+void vEDFTraceStartDrainTask(void);
+void vEDFTraceStopDrainTask(void);
+#endif
+#endif
+// ************************************************************************ //
+
+#endif // _EDF_TRACE_H_
@@ -53,8 +53,12 @@
 #define TASK_NUM_START                      4 // 2 for MAIN TASK and 3 for IDLE TASK as TCB Numbers
 #define IDLE_TASK_NUM                       TASK_NUM_START - 1
 #define MAIN_TASK_NUM                       IDLE_TASK_NUM - 1
+#ifndef MAX_NUM_OF_PERIODIC_TASKS
 #define MAX_NUM_OF_PERIODIC_TASKS           10
+#endif
+#ifndef MAX_NUM_OF_APERIODIC_TASKS
 #define MAX_NUM_OF_APERIODIC_TASKS          4
+#endif
 #define TOTAL_NUM_OF_TASKS                  MAX_NUM_OF_APERIODIC_TASKS + MAX_NUM_OF_PERIODIC_TASKS
 #define SCHED_TASK_NUM                      TOTAL_NUM_OF_TASKS + TASK_NUM_START
 #define APERIODIC_SERVER_NUM                SCHED_TASK_NUM + 1
@@ -62,6 +66,7 @@
 #define MAX_SYS_PRIO                        configMAX_PRIORITIES - 5
 #define SCHED_PRIO                          MAX_SYS_PRIO + 1
 #define RUNNING_TASK_PRIO                   MAX_SYS_PRIO
+#define DISPATCHED_TASK_PRIO                RUNNING_TASK_PRIO - 1 // global EDF: given a core, not yet running on it
 #define LOWEST_SYS_PRIO                     tskIDLE_PRIORITY
 #define APERIODIC_PRIO                      LOWEST_SYS_PRIO + 1
 #define BLOCKED_TASK_PRIO                   APERIODIC_PRIO + 1
@@ -69,8 +74,11 @@
 #define LOCAL_STORAGE_INDEX                 0
 // Aperiodic Server Stack Size
 #define APERIODIC_SERVER_STACK              3000
-// Periodic Utilization Limit
-#define UP_LIMIT                            0.9f
+// Utilizations are Q16.16 fractions of the CPU (EDFUtilization_t), no FPU is needed and results are the same on every target
+#define EDF_UTIL_FRAC_BITS                  16
+#define EDF_UTIL_ONE                        (1UL << EDF_UTIL_FRAC_BITS)
+// Periodic Utilization Limit with TBS, the rest is left to the server, without TBS admission is only by EDFAdmission.h
+#define UP_LIMIT                            ((EDF_UTIL_ONE * 9) / 10)
 
 // *********************************************************************** //
 // *********************** Common Defines Include ************************ //
@@ -87,6 +95,102 @@
 #include "freertos/task.h"
 #include "freertos/list.h"
 #include "freertos/event_groups.h"
+#if USE_EDF_INLINE_DISPATCH == 1
+#include "freertos/timers.h"
+#endif
+// *********************************************************************** //
+// *********************** EDF Includes ********************************** //
+#include "EDFHeap.h"
+#include "EDFLog.h"
+#include "EDFTrace.h"
+#include "EDFSignalQueue.h"
+#include "EDFArrivalQueue.h"
+#include "EDFAdmission.h"
+
+// ************************* Multi-core ********************************** //
+#if EDF_NUM_OF_CORES > portNUM_PROCESSORS
+#error "EDF_NUM_OF_CORES must not exceed portNUM_PROCESSORS"
+#endif
+#if EDF_NUM_OF_CORES > 1
+#define edfCURRENT_CORE()                   ((BaseType_t)xPortGetCoreID())
+#else
+#define edfCURRENT_CORE()                   ((BaseType_t)0)
+#endif
+#if (USE_GLOBAL_EDF_US == 1) && (USE_GLOBAL_EDF == 0)
+#error "USE_GLOBAL_EDF_US needs USE_GLOBAL_EDF"
+#endif
+#if USE_GLOBAL_EDF == 1
+#if EDF_NUM_OF_CORES < 2
+#error "USE_GLOBAL_EDF needs EDF_NUM_OF_CORES > 1"
+#endif
+#if USE_TBS == 1
+#error "USE_TBS is not supported with USE_GLOBAL_EDF, use the aperiodic server"
+#endif
+#if USE_SRP == 1
+#error "USE_SRP needs a run queue per core, it is not supported with USE_GLOBAL_EDF"
+#endif
+// every core is served from the one ready queue, tasks are not pinned and migrate
+#define edfRUN_QUEUE_OF_CORE(xCore)         ((BaseType_t)0)
+#define edfTASK_AFFINITY(xTCB)              (tskNO_AFFINITY)
+#else
+#define edfRUN_QUEUE_OF_CORE(xCore)         (xCore)
+#define edfTASK_AFFINITY(xTCB)              ((xTCB)->xCoreID)
+#endif
+#if (USE_TBS == 1) && ((EDF_TBS_NUM_OF_WORKERS * EDF_NUM_OF_RUN_QUEUES) > MAX_NUM_OF_APERIODIC_TASKS)
+#error "The TBS workers of all cores take the place of the aperiodic tasks, at most MAX_NUM_OF_APERIODIC_TASKS"
+#endif
+#if (USE_CBS == 1) && (USE_TBS == 1)
+#error "USE_CBS replaces the aperiodic server, it cannot be used together with USE_TBS"
+#endif
+#if USE_EDF_INLINE_DISPATCH == 1
+#if EDF_NUM_OF_CORES > 1
+#error "USE_EDF_INLINE_DISPATCH serializes the passes by suspending the scheduler of one core, it needs EDF_NUM_OF_CORES 1"
+#endif
+#if configUSE_TIMERS != 1
+#error "USE_EDF_INLINE_DISPATCH defers the passes it cannot run inline to the timer service task, set configUSE_TIMERS"
+#endif
+#if configTIMER_TASK_PRIORITY <= SCHED_PRIO
+#error "USE_EDF_INLINE_DISPATCH needs configTIMER_TASK_PRIORITY above SCHED_PRIO, where tasks wait for their release"
+#endif
+#endif
+#if configUSE_EDF == 1
+#if EDF_NUM_OF_CORES > 1
+#error "configUSE_EDF orders the ready list a single core kernel selects from, it needs EDF_NUM_OF_CORES 1"
+#endif
+#if (USE_WCET_CHECKS == 1) || (USE_DEADLINE_CHECKS == 1) || (USE_EDF_TICKLESS == 1)
+#error "configUSE_EDF has no scheduler task to handle overruns and deadline misses, set USE_WCET_CHECKS, USE_DEADLINE_CHECKS and USE_EDF_TICKLESS to 0"
+#endif
+#if (USE_CBS == 1) || (USE_TBS == 1) || (USE_SRP == 1) || (USE_EDF_INLINE_DISPATCH == 1)
+#error "configUSE_EDF serves the aperiodic tasks in the background, USE_CBS, USE_TBS, USE_SRP and USE_EDF_INLINE_DISPATCH need the library scheduler"
+#endif
+#if RUNNING_TASK_PRIO != configEDF_PRIORITY
+#error "configUSE_EDF runs the EDF tasks at RUNNING_TASK_PRIO, configEDF_PRIORITY must be the same"
+#endif
+#endif
+#if (USE_CBS == 1) && (CBS_BUDGET > CBS_PERIOD)
+#error "CBS_BUDGET must not exceed CBS_PERIOD"
+#endif
+
+// ********************* Execution Time Clock **************************** //
+// Monotonic microsecond clock the execution time is measured with between the context switch hooks: esp_timer_get_time()
+// on the ESP32, implemented with clock_gettime(CLOCK_MONOTONIC) by the POSIX port (tools/EDFPosix/espShim.c) and in
+// virtual time by the simulator. Other ports define edfCLOCK_US() in FreeRTOSConfig.h
+#ifndef edfCLOCK_US
+#define edfCLOCK_US()                       esp_timer_get_time()
+#endif
+#define edfTICKS_TO_US(xTicks)              ((int64_t)(xTicks) * (1000000 / configTICK_RATE_HZ))
+#define edfNOT_SWITCHED_IN                  ((int64_t)-1)
+// *********************************************************************** //
+
+// ******************** Scheduler Overhead Hooks ************************** //
+// Expand to nothing unless defined in FreeRTOSConfig.h, used by the benchmark in tools/EDFPosix
+// WAKE is called when the scheduler is notified, DONE when the scheduler has applied the new priorities
+#ifndef traceEDF_SCHEDULER_WAKE
+#define traceEDF_SCHEDULER_WAKE(event)
+#endif
+#ifndef traceEDF_SCHEDULER_DONE
+#define traceEDF_SCHEDULER_DONE(events)
+#endif
 // *********************************************************************** //
 
 // ************************* Data Structures ***************************** //
@@ -112,8 +216,39 @@
 #define SWITCH_ON_WCET_WAKEUP           0x00
 #endif
 
-#define ALL_SWITCHES                    SWITCH_ON_BLOCK | SWITCH_ON_READY | SWITCH_ON_SUSPEND | SWITCH_ON_WCET_OVERFLOW | SWITCH_ON_DEADLINE_OVERFLOW | SWITCH_ON_WCET_WAKEUP
+// jobs submitted at runtime are waiting, only sent to the scheduler of run queue 0 with TBS
+#if USE_TBS == 1
+#define SWITCH_ON_APERIODIC_ARRIVAL     (1 << 6)
+#else
+#define SWITCH_ON_APERIODIC_ARRIVAL     0x00
+#endif
+
+// a periodic task is removed at runtime (EDFRemovePeriodicTask), sent to the scheduler of its core
+#define SWITCH_ON_REMOVE                (1 << 7)
+
+// the event timer of the run queue expired, only with USE_EDF_TICKLESS
+#if USE_EDF_TICKLESS == 1
+#define SWITCH_ON_EVENT_TIMER           (1 << 8)
+#else
+#define SWITCH_ON_EVENT_TIMER           0x00
+#endif
+
+// a resource was unlocked while the scheduler held a job back for the system ceiling, only with USE_SRP
+#if USE_SRP == 1
+#define SWITCH_ON_RESOURCE              (1 << 9)
+#else
+#define SWITCH_ON_RESOURCE              0x00
+#endif
+
+#define ALL_SWITCHES                    SWITCH_ON_BLOCK | SWITCH_ON_READY | SWITCH_ON_SUSPEND | SWITCH_ON_WCET_OVERFLOW | SWITCH_ON_DEADLINE_OVERFLOW | SWITCH_ON_WCET_WAKEUP | SWITCH_ON_APERIODIC_ARRIVAL | SWITCH_ON_REMOVE | SWITCH_ON_EVENT_TIMER | SWITCH_ON_RESOURCE
+
 
+// Q16.16 utilization, see EDF_UTIL_FRAC_BITS
+typedef uint32_t EDFUtilization_t;
+// C / T rounded up, so that a sum of task utilizations never underestimates the load
+#define edfUTILIZATION(C, T)                ((EDFUtilization_t)((((uint64_t)(C) << EDF_UTIL_FRAC_BITS) + (T) - 1) / (T)))
+// for printing
+#define edfUTIL_TO_PERMILLE(U)              ((unsigned long)(((uint64_t)(U) * 1000) >> EDF_UTIL_FRAC_BITS))
 
 // Task states periodic
 typedef enum taskStatus
@@ -124,6 +259,51 @@ typedef enum taskStatus
     TASK_RUNNING
 } taskStatus;
 
+// What the scheduler does with a job of a periodic task that overruns its WCET (USE_WCET_CHECKS) or misses its
+// deadline (USE_DEADLINE_CHECKS), chosen per task and event at creation
+typedef enum EDFJobPolicy
+{
+    EDF_POLICY_DEFAULT = 0,                 // overrun: suspend until relArrivalTime + period, miss: delete the task
+    EDF_POLICY_ABORT_JOB,                   // drop the rest of the job (USE_STATIC_ALLOCATION), or suspend it until the next release
+    EDF_POLICY_SKIP_NEXT,                   // the job goes on with the deadline of the next period, which is not released
+    EDF_POLICY_FINISH_LATE,                 // the job goes on with its deadline a period later, later jobs catch up
+    EDF_POLICY_MK_FIRM,                     // abort the job while (m,k) holds after the miss, otherwise finish late
+    EDF_POLICY_CALLBACK                     // pxCallback returns one of the policies above, finish late without one
+} EDFJobPolicy_t;
+
+typedef enum EDFJobEvent
+{
+    EDF_EVENT_OVERRUN = 0,
+    EDF_EVENT_DEADLINE_MISS
+} EDFJobEvent_t;
+
+// runs in the scheduler task, must not block. pvParameters are the instanceParams of the task
+typedef EDFJobPolicy_t (*EDFPolicyCallback_t)(TaskHandle_t xTask, EDFJobEvent_t xEvent, void * pvParameters);
+
+typedef struct EDFTaskPolicy
+{
+    EDFJobPolicy_t xOverrunPolicy;
+    EDFJobPolicy_t xMissPolicy;
+    UBaseType_t uxM;                        // (m,k)-firm: at least uxM of any uxK consecutive jobs meet their deadline
+    UBaseType_t uxK;                        // at most 32
+    EDFPolicyCallback_t pxCallback;
+} EDFTaskPolicy_t;
+
+#if USE_EDF_TASK_STATS == 1
+// Jobs of one task since its creation, the counters are updated on their own so a copy is not a consistent snapshot.
+// Histogram bucket 0 counts times of 0 us, bucket i times of 2^(i-1) to 2^i - 1 us and the last one all longer times
+typedef struct EDFTaskStats
+{
+    uint32_t ulJobs;                        // completed jobs
+    uint32_t ulPreemptions;                 // another EDF job got the core of a started job before it completed
+    uint32_t ulWCETOverruns;
+    uint32_t ulDeadlineMisses;              // flagged by the deadline check, or completed after the deadline
+    uint32_t ulMaxExecTime;                 // us, the longest job
+    uint32_t ulResponseTime[EDF_STATS_NUM_OF_BUCKETS]; // jobs by release to completion, counted in ticks
+    uint32_t ulExecTime[EDF_STATS_NUM_OF_BUCKETS];     // jobs by execution time
+} EDFTaskStats_t;
+#endif
+
 #if USE_TBS == 0
 // task states aperiodic
 typedef enum taskStatusA
@@ -139,25 +319,32 @@ Structures to hold extended TCB
 typedef struct extTCB
 {
     TaskHandle_t cTaskHandle;
+    TaskHandle_t * pxHandle; // handle of the caller of EDFCreatePeriodicTask, set once the task is created, or NULL
     const char * taskName;
     uint32_t stackSize;
     void (*instanceFunc)(void*);
     void *instanceParams;
     TickType_t WCET;
-    TickType_t measuredExecTime;
+    int64_t measuredExecTime; // us of the current job, charged when the task is switched out
+    int64_t xSwitchedInTime; // edfCLOCK_US() at the last switch in, edfNOT_SWITCHED_IN while the task does not run
     TickType_t period;
     TickType_t phase;
     TickType_t relDeadline;
     TickType_t relArrivalTime;
     TickType_t absDeadline;
-    ListItem_t xTCBListItem;
+    EDFHeapItem_t xTCBHeapItem;
     BaseType_t xPriority; 
     BaseType_t xTaskNumber;
+    BaseType_t xCoreID; // core the task is pinned to and scheduled on, the shared run queue 0 with global EDF
     taskStatus status; 
+    BaseType_t xAddedOnline; // created by EDFAddPeriodicTask, the scheduler releases it once it has suspended itself
+    BaseType_t xReleased; // set when a job is released through the ready hook, see EDFPeriodicWrapper
+    BaseType_t xSkipRelease; // the next release is skipped, set by EDF_POLICY_SKIP_NEXT
+    EDFTaskPolicy_t xPolicy;
+    uint32_t ulJobHistory; // one bit per job, newest in bit 0, set if the job met its deadline
 
     #if USE_TBS == 1
-    BaseType_t executedTBSTask;
-    BaseType_t isPeriodic;
+    BaseType_t isPeriodic; // pdFALSE for the TBS workers
     #endif
 
     #if USE_WCET_CHECKS == 1
@@ -167,9 +354,37 @@ typedef struct extTCB
 
     #if USE_DEADLINE_CHECKS == 1
     BaseType_t deadlineExceeded;
+    EDFHeapItem_t xDeadlineHeapItem; // in the deadline index of its run queue while a job is pending
+    #endif
+
+    #if USE_GLOBAL_EDF_US == 1
+    BaseType_t xTopPriority; // heavy task, its jobs run ahead of every deadline (EDF-US)
+    #endif
+
+    #if USE_SRP == 1
+    BaseType_t xJobStarted; // the scheduler has run the current job, which no longer waits for the system ceiling
+    #endif
+
+    #if USE_EDF_TASK_STATS == 1
+    EDFTaskStats_t xStats;
+    BaseType_t xJobRunning; // between the start and the completion of a job in the wrapper
+    int64_t xJobExecTime; // us of the running job until the last switch out
+    BaseType_t xSwitchedOutCore; // core the started job was switched out on, -1 if none
+    uint32_t ulSwitchedOutCount; // switch ins of that core at the time, any later one is another job on it
     #endif
 } extTCB_t;
 
+#if USE_SRP == 1
+// Resource shared by periodic tasks of one core under the Stack Resource Policy, see EDFInitResource
+typedef struct EDFResource
+{
+    TickType_t xCeiling;                    // shortest relative deadline of the tasks that lock it
+    BaseType_t xCoreID;                     // core of the tasks that lock it, -1 until it is first locked
+    extTCB_t * pxHolder;
+    struct EDFResource * pxNext;            // resource locked before it on the core
+} EDFResource_t;
+#endif
+
 #if USE_TBS == 0
 typedef struct extTCBA
 {
@@ -181,50 +396,48 @@ typedef struct extTCBA
     BaseType_t executedThisInstance;
     BaseType_t xTaskNumber;
     TickType_t phase;
-    ListItem_t xTCBAListItem;
     uint32_t stackSize;
     taskStatusA status;
 } extTCBA_t;
 #endif
 // TODO 9: (Low) Add a task config structure to pass to the task creation functions rather than having many function arguments
 // ************************************************************************ //
-// *************************** Globals ************************************ //
-/*
-Some of these variables and arrays are externed by the trace macros
-*/
-
-#ifdef TRACE_CONFIG
-#define TRACE_ARRAY_WIDTH                   MAX_NUM_OF_APERIODIC_TASKS + MAX_NUM_OF_PERIODIC_TASKS + 2
-extern int task_nums[TRACE_ARRAY_SIZE][TRACE_ARRAY_WIDTH];
-extern int trcIndex;
-#endif
-
-#ifdef ESP_TRACE_CONFIG
-#define TRACE_TIMER_TIMEOUT                 5 * 1000 * 1000 // 5 seconds max
-#define MAX_NUM_OF_EVENTS                   1000           
-
-extern int64_t eventArray[MAX_NUM_OF_EVENTS][3];     // Structure of eventArray at each index  | -- Task Number -- | -- Entry Time -- | -- Exit Time -- |
-extern int64_t eventIndex;
-extern esp_timer_handle_t traceTimer;
-#endif
-
 // ********************** Function Declarations *************************** //
+// The task is only created by EDFStartScheduling(), *handle is NULL until then and must stay valid until it is set
 void EDFCreatePeriodicTask(const char* taskName, int stackSize, void (*instanceFunc)(void*), int timePeriod, int relDeadline, int phase, TaskHandle_t *handle, void *instanceParams, TickType_t WCETinTicks);
 void EDFCreateAperiodicTask(const char* taskName, void (*instanceFunc)(void*), void *instanceParams, int stackSize, TickType_t WCET, TickType_t arrivalTime);
+// Aperiodic job arriving now, served by the aperiodic server (or as a TBS job), pdFALSE if the arrival queue is full
+BaseType_t EDFSubmitAperiodicJob(const char* taskName, void (*instanceFunc)(void*), void *instanceParams, int stackSize, TickType_t WCET);
+BaseType_t EDFSubmitAperiodicJobFromISR(const char* taskName, void (*instanceFunc)(void*), void *instanceParams, int stackSize, TickType_t WCET, BaseType_t * pxHigherPriorityTaskWoken);
+// Same as above, pxPolicy selects what happens to overrunning and late jobs, NULL for EDF_POLICY_DEFAULT
+void EDFCreatePeriodicTaskWithPolicy(const char* taskName, int stackSize, void (*instanceFunc)(void*), int timePeriod, int relDeadline, int phase, TaskHandle_t *handle, void *instanceParams, TickType_t WCETinTicks, const EDFTaskPolicy_t * pxPolicy);
+// Mode changes while the scheduler runs, from one task at a time. A task is added if it passes the admission test against
+// the tasks admitted now, removed tasks keep their utilization until the deadline of their last job. The new task is
+// released at once, or at that deadline if it needs the utilization. pdFALSE if the task is not admitted
+BaseType_t EDFAddPeriodicTask(const char* taskName, int stackSize, void (*instanceFunc)(void*), int timePeriod, int relDeadline, TaskHandle_t *handle, void *instanceParams, TickType_t WCETinTicks);
+BaseType_t EDFAddPeriodicTaskWithPolicy(const char* taskName, int stackSize, void (*instanceFunc)(void*), int timePeriod, int relDeadline, TaskHandle_t *handle, void *instanceParams, TickType_t WCETinTicks, const EDFTaskPolicy_t * pxPolicy);
+// NULL removes the calling task, the call then does not return. pdFALSE if the task is no periodic EDF task
+BaseType_t EDFRemovePeriodicTask(TaskHandle_t xTask);
+#if USE_EDF_TASK_STATS == 1
+// Copies the statistics of an EDF task (or TBS worker), NULL for the calling task, from any task or core. pdFALSE if
+// the task has no extended TCB
+BaseType_t EDFGetTaskStats(TaskHandle_t xTask, EDFTaskStats_t * pxStats);
+#endif
+#if USE_SRP == 1
+// relDeadline is the shortest relative deadline (ms) of the periodic tasks that lock the resource, which must all run
+// on one core. A job locks and unlocks its resources in LIFO order and must not block or suspend while it holds one
+void EDFInitResource(EDFResource_t * pxResource, int relDeadline);
+// never blocks, the job only started when none of the resources it can lock was held
+void EDFLockResource(EDFResource_t * pxResource);
+void EDFUnlockResource(EDFResource_t * pxResource);
+#endif
 void EDFStartScheduling();
 void EDFDeleteAllTasks();
 void EDFInit();
 
 // TODO 10: (Low) Moved Function declarations for internal functions into the source file
 // ********************** Idle Hook Declaration **************************** //
-#ifdef TRACE_CONFIG
 void vApplicationIdleHook(void);
-#endif
-
-#ifdef ESP_TRACE_CONFIG
-void espTimerCallback(void *arg);
-void vApplicationIdleHook(void);
-#endif
 // ************************************************************************ //
 // ********************** Tick Hook Declaration **************************** //
 void vApplicationTickHook(void);
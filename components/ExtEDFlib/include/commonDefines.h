@@ -8,19 +8,139 @@
 #define _COMMON_DEFINES_H_
 
 // **************************** CONFIG DEFINES ***************************//
-//#define TRACE_CONFIG                        // Define this to enable trace features, must comment out ESP_TRACE_CONFIG Define 
-#define ESP_TRACE_CONFIG                    // Define this to enable trace features in microseconds, must comment out TRACE_CONFIG
+// Binary trace of the switches, releases, job ends, WCET overflows and deadline misses (EDFTrace.h), streamed to the
+// sink set with vEDFTraceSetSink() while the system runs
+#ifndef USE_EDF_TRACE
+#define USE_EDF_TRACE                       1  // Set to 0 to remove the trace
+#endif
+#define EDF_TRACE_BUFFER_SIZE               2048 // bytes of records per buffer, each core has two
+#ifndef USE_TRACE_DRAIN_TASK
+#define USE_TRACE_DRAIN_TASK                1  // Set to 0 to pass the buffers to the sink with vEDFTraceDrain() instead
+#endif
+#define EDF_TRACE_DRAIN_PERIOD_MS           50
+#define EDF_TRACE_DRAIN_STACK               3000
 
-#ifdef TRACE_CONFIG
-#define TRACE_ARRAY_SIZE                    configTICK_RATE_HZ * 3
+// Per-task job statistics (EDFGetTaskStats), updated in constant time by the switch hooks and the task wrapper
+#ifndef USE_EDF_TASK_STATS
+#define USE_EDF_TASK_STATS                  1  // Set to 0 to remove the statistics
 #endif
+#define EDF_STATS_NUM_OF_BUCKETS            24 // log2 buckets of the time histograms, up to 2^22 us and one for longer
 
+// The following can also be set from the build, e.g. by the host simulator in tools/EDFSimulator
+#ifndef USE_TBS
 #define USE_TBS                             0  // Set to 1 to use TBS instead of the aperiodic server
+#endif
+// Constant Bandwidth Server for the aperiodic tasks (needs USE_TBS 0): the server competes in the EDF ready queue with
+// a deadline of its own, CBS_BUDGET ticks every CBS_PERIOD ticks, and its bandwidth is admitted like a periodic task
+#ifndef USE_CBS
+#define USE_CBS                             0  // Set to 1 for the CBS, 0 serves the aperiodic tasks in the background
+#endif
+#ifndef CBS_BUDGET
+#define CBS_BUDGET                          10 // Qs in ticks
+#endif
+#ifndef CBS_PERIOD
+#define CBS_PERIOD                          100 // Ts in ticks
+#endif
+#ifndef USE_WCET_CHECKS
 #define USE_WCET_CHECKS                     1
+#endif
+#ifndef USE_DEADLINE_CHECKS
 #define USE_DEADLINE_CHECKS                 0
+#endif
+// Event driven instead of polled checks: the scheduler of every run queue arms one esp_timer for its next WCET, budget,
+// deadline or aperiodic arrival event, so the tick hook has nothing to do and the kernel may suppress ticks when idle
+#ifndef USE_EDF_TICKLESS
+#define USE_EDF_TICKLESS                    0
+#endif
+
+// Stack Resource Policy (EDFLockResource): a job only starts once its preemption level, the higher the shorter its
+// relative deadline, is above the ceiling of every resource locked on its core, so it never blocks on a lock
+#ifndef USE_SRP
+#define USE_SRP                             0
+#endif
+
+// Inline dispatch: every periodic task makes the scheduling decision of its own job end and release, without the
+// scheduler task. The other events are handled by a pass deferred to the timer service task (needs configUSE_TIMERS)
+#ifndef USE_EDF_INLINE_DISPATCH
+#define USE_EDF_INLINE_DISPATCH             0
+#endif
+
+// Kernel-native EDF (EDFKernel.h), set in FreeRTOSConfig.h: the EDF tasks all run at configEDF_PRIORITY, whose ready list
+// the kernel keeps in deadline order through the trace hooks. No scheduler task, no priority is changed
+#ifndef configUSE_EDF
+#define configUSE_EDF                       0
+#endif
+#define configEDF_PRIORITY                  (configMAX_PRIORITIES - 5) // RUNNING_TASK_PRIO
+
+// Binary log of the scheduling paths (EDFLog.h), 0: removed, 1: WCET and deadline overflows, 2: also job events
+#ifndef EDF_LOG_LEVEL
+#define EDF_LOG_LEVEL                       2
+#endif
+#define EDF_LOG_RING_SIZE                   64 // records per core, must be a power of 2
+#ifndef USE_LOG_DRAIN_TASK
+#define USE_LOG_DRAIN_TASK                  1  // Set to 0 to read the records with xEDFLogRead() instead of printing them
+#endif
+#define EDF_LOG_DRAIN_PERIOD_MS             100
+#define EDF_LOG_DRAIN_STACK                 3000
+
+// Static allocation (EDFPool.h): extended TCBs, task control blocks and stacks of all EDF tasks in compile time arenas
+#ifndef USE_STATIC_ALLOCATION
+#define USE_STATIC_ALLOCATION               0  // Set to 1 to create all tasks with xTaskCreateStatic, needs configSUPPORT_STATIC_ALLOCATION
+#endif
+#define EDF_POOL_STACK_DEPTH                3000 // largest stack of a periodic (or TBS) task
+#define EDF_SYSTEM_STACK_DEPTH              3000 // stack of every library task (generator, scheduler, server, log drain)
+
+// Admission test (EDFAdmission.h): ticks the demand walk may cover, tests that need more are EDF_ADMISSION_UNDECIDED
+#ifndef EDF_ADMISSION_HORIZON
+#define EDF_ADMISSION_HORIZON               0xFFFFFFFFULL
+#endif
+
+// Partitioned multi-core EDF: every core runs its own scheduler task and ready queue, tasks are pinned to one core
+// and placed at EDFStartScheduling() by bin-packing in decreasing utilization, each core admitting with EDFAdmission.h
+#ifndef EDF_NUM_OF_CORES
+#define EDF_NUM_OF_CORES                    1  // at most portNUM_PROCESSORS
+#endif
+#define EDF_FIRST_FIT                       0  // lowest numbered core the task fits on
+#define EDF_BEST_FIT                        1  // most utilized core the task fits on
+#define EDF_WORST_FIT                       2  // least utilized core the task fits on
+#ifndef EDF_PARTITION_FIT
+#define EDF_PARTITION_FIT                   EDF_FIRST_FIT
+#endif
+
+// Global multi-core EDF instead: a single ready queue and scheduler task for all cores, the EDF_NUM_OF_CORES earliest
+// deadline jobs run and a preempted job continues on whichever core frees up, admission by the GFB and BCL tests
+#ifndef USE_GLOBAL_EDF
+#define USE_GLOBAL_EDF                      0
+#endif
+// EDF-US[m/(2m-1)] on top of global EDF: tasks denser than m/(2m-1) always run first, which avoids the Dhall effect
+#ifndef USE_GLOBAL_EDF_US
+#define USE_GLOBAL_EDF_US                   0
+#endif
+// Ready queues with their scheduler task, signal queue and admitted task set
+#if USE_GLOBAL_EDF == 1
+#define EDF_NUM_OF_RUN_QUEUES               1
+#else
+#define EDF_NUM_OF_RUN_QUEUES               EDF_NUM_OF_CORES
+#endif
+
+// Scheduler signals (EDFSignalQueue.h) that can be pending at once, must be a power of 2 and at least twice the number of tasks
+#ifndef EDF_SIGNAL_QUEUE_SIZE
+#define EDF_SIGNAL_QUEUE_SIZE               32
+#endif
+
+// Aperiodic jobs submitted at runtime (EDFArrivalQueue.h) that can wait at once, must be a power of 2
+#ifndef EDF_ARRIVAL_QUEUE_SIZE
+#define EDF_ARRIVAL_QUEUE_SIZE              16
+#endif
 
 #if USE_TBS == 1
 
+// TBS jobs run on worker tasks created once at the start, per core, a job waits in the arrival queue while all are busy
+#ifndef EDF_TBS_NUM_OF_WORKERS
+#define EDF_TBS_NUM_OF_WORKERS              2
+#endif
+#define EDF_TBS_WORKER_STACK                3000
+
 #if USE_DEADLINE_CHECKS == 1
 #define USE_DEADLINE_CHECKS_TBS             0
 #endif 
@@ -3,34 +3,64 @@
 
 #include "commonDefines.h"
 
-#ifdef TRACE_CONFIG
-
-#define traceTASK_INCREMENT_TICK(xTickCount)\
-extern void tickTrace(BaseType_t xTickCount, BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
-tickTrace(xTickCount, pxCurrentTCB[0]->uxTaskNumber, pxCurrentTCB[0]->uxTCBNumber);
+// ESP-IDF keeps one current TCB per core and the hooks run on the core that switches, single core kernels
+// (e.g. the POSIX port) define this to pxCurrentTCB
+#ifndef EDF_TRACE_CURRENT_TCB
+#define EDF_TRACE_CURRENT_TCB               pxCurrentTCB[xPortGetCoreID()]
+#endif
+// pended yield of the core, xYieldPendings[0] on FreeRTOS V11
+#ifndef EDF_TRACE_YIELD_PENDING
+#define EDF_TRACE_YIELD_PENDING             xYieldPending[xPortGetCoreID()]
+#endif
 
-#define traceTASK_SWITCHED_OUT()\
-extern void switchedOutTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
-switchedOutTrace(pxCurrentTCB[0]->uxTaskNumber, pxCurrentTCB[0]->uxTCBNumber);
+#if USE_EDF_TRACE == 1
+// switch records of the binary trace (EDFTrace.h)
+#define edfTRACE_SWITCHED_OUT()\
+extern void EDFTraceSwitchedOut(BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
+EDFTraceSwitchedOut(EDF_TRACE_CURRENT_TCB->uxTaskNumber, EDF_TRACE_CURRENT_TCB->uxTCBNumber);
+
+#define edfTRACE_SWITCHED_IN()\
+extern void EDFTraceSwitchedIn(BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
+EDFTraceSwitchedIn(EDF_TRACE_CURRENT_TCB->uxTaskNumber, EDF_TRACE_CURRENT_TCB->uxTCBNumber);
+#else
+#define edfTRACE_SWITCHED_OUT()
+#define edfTRACE_SWITCHED_IN()
+#endif
 
-#define traceTASK_SWITCHED_IN()\
-extern void switchedInTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
-switchedInTrace(pxCurrentTCB[0]->uxTaskNumber, pxCurrentTCB[0]->uxTCBNumber);
+#if configUSE_EDF == 1
+// kernel-native EDF (EDFKernel.h): the ready list of the EDF tasks is kept in deadline order and selected from its
+// head. These hooks expand in tasks.c, where pxReadyTasksLists is
+#define edfKERNEL_SWITCHED_OUT()\
+extern void vEDFKernelSelectEarliest(List_t * pxReadyList, ListItem_t * pxCurrentItem);\
+vEDFKernelSelectEarliest(&(pxReadyTasksLists[configEDF_PRIORITY]), &(EDF_TRACE_CURRENT_TCB->xStateListItem));
 
+#define traceMOVED_TASK_TO_READY_STATE(xTask)\
+if ((xTask)->uxPriority == configEDF_PRIORITY)\
+{\
+    extern BaseType_t xEDFKernelPlaceReadyTask(List_t * pxReadyList, ListItem_t * pxItem, TaskHandle_t xCurrentTask);\
+    if (xEDFKernelPlaceReadyTask(&(pxReadyTasksLists[configEDF_PRIORITY]), &((xTask)->xStateListItem), (TaskHandle_t)EDF_TRACE_CURRENT_TCB) == pdTRUE)\
+    {\
+        EDF_TRACE_YIELD_PENDING = pdTRUE;\
+    }\
+}
+#else
+#define edfKERNEL_SWITCHED_OUT()
 #endif
 
-#ifdef ESP_TRACE_CONFIG
-
+// the execution time of the EDF tasks is accumulated between these two hooks, then the trace features are called
 #define traceTASK_SWITCHED_OUT()\
-extern void ESPSwitchedOutTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
-ESPSwitchedOutTrace(pxCurrentTCB[0]->uxTaskNumber, pxCurrentTCB[0]->uxTCBNumber);
+extern void EDFTaskSwitchedOut(TaskHandle_t xTask);\
+EDFTaskSwitchedOut((TaskHandle_t)EDF_TRACE_CURRENT_TCB);\
+edfTRACE_SWITCHED_OUT()\
+edfKERNEL_SWITCHED_OUT()
 
 #define traceTASK_SWITCHED_IN()\
-extern void ESPSwitchedInTrace(BaseType_t xTaskNumber, BaseType_t xTCBNumber);\
-ESPSwitchedInTrace(pxCurrentTCB[0]->uxTaskNumber, pxCurrentTCB[0]->uxTCBNumber);
-
-#endif
+extern void EDFTaskSwitchedIn(TaskHandle_t xTask);\
+EDFTaskSwitchedIn((TaskHandle_t)EDF_TRACE_CURRENT_TCB);\
+edfTRACE_SWITCHED_IN()
 
+#if configUSE_EDF == 0
+// the library scheduler keeps its own ready queue, it is told about every change of the task states
 #define traceMOVED_TASK_TO_READY_STATE(xTask)\
 extern void EDFMovedTaskToReadyState(TaskHandle_t xTaskToReadyState);\
 EDFMovedTaskToReadyState(xTask);
@@ -46,6 +76,7 @@ EDFTaskSuspended(xTask);
 #define traceTASK_RESUME(xTask)\
 extern void EDFTaskResumed(TaskHandle_t xTaskToResume);\
 EDFTaskResumed(xTask);
+#endif
 
 
 
@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include "ExtEDFlib.h"
 #include "esp_err.h"
+#include "driver/uart.h"
 
 
 #define NUM_OF_INSTR        100000  //Actual CPU cycles used will depend on compiler optimization
@@ -47,45 +48,11 @@ static void aperiodicTask(void *params)
     }
 }
 
-#ifdef TRACE_CONFIG
-static void printFunc1(void *pvParameters)
+static void traceSink(const void *pvData, size_t xLength)
 {
-    printf("********\n");
-    printf("[INFO] Schedule Data Gathered. Printing data......\n");
-
-    for (int i = 0; i < TRACE_ARRAY_SIZE; i++)
-    {
-        printf("Tick %d:   ", i+1);
-        for (int j = 0; j < TRACE_ARRAY_WIDTH; j++)
-        {
-            printf("%d, ", task_nums[i][j]);
-        }
-        printf("\n");
-    }
-    printf("\n[INFO] Schedule Printed!!!\n");
-    printf("\n********");
-
-    vTaskDelete(NULL);
-}
-#endif
-
-#ifdef ESP_TRACE_CONFIG
-static void printFunc2(void *pvParameters)
-{
-    printf("********\n");
-    printf("[INFO] Schedule Data Gathered. Printing data......\n");
-
-    for (int i = 0; i < MAX_NUM_OF_EVENTS; i++)
-    {
-        if ((i > 1) && !eventArray[i][0] && !eventArray[i][1] && !eventArray[i][2]) break;
-        printf("Event No: %d, Task No: %lld, Entry at: %lld us, Exit at: %lld us after startup\n", i, eventArray[i][0], eventArray[i][1], eventArray[i][2]);
-    }
-    printf("\n[INFO] Schedule Printed!!!\n");
-    printf("\n********");
-
-    vTaskDelete(NULL);
+    // the blocks go out on the console next to the log text, a reader picks them out by their magic
+    uart_write_bytes(CONFIG_ESP_CONSOLE_UART_NUM, pvData, xLength);
 }
-#endif
 
 
 void app_main(void)
@@ -94,6 +61,8 @@ void app_main(void)
     vTaskDelay(pdMS_TO_TICKS(100));
 
     EDFInit();
+    ESP_ERROR_CHECK(uart_driver_install(CONFIG_ESP_CONSOLE_UART_NUM, 256, 0, 0, NULL, 0));
+    vEDFTraceSetSink(traceSink);
 
     //TaskHandle_t curTask = xTaskGetCurrentTaskHandle();
     //vTaskSetTaskNumber(curTask, 7);
@@ -141,7 +110,7 @@ void app_main(void)
     EDFStartScheduling();
     vTaskDelay(4000 / portTICK_PERIOD_MS);
 
-    // In this time, the created tasks will run and data will be collected on the schedule
+    // In this time, the created tasks will run and their schedule is streamed to the console
     EDFDeleteAllTasks();
-    xTaskCreate(printFunc2, "Print Task", 2048, NULL, 1, NULL);
+    vEDFTraceFlush();
 }
@@ -0,0 +1,260 @@
+/*
+                    Scheduler Overhead Benchmark for the Extended EDF Library
+
+    Description:
+
+        Runs ExtEDFlib on the FreeRTOS POSIX port and measures the latency from EDFWakeScheduler() to the end of the
+        scheduler pass that serviced it, i.e. after the final vTaskPrioritySet(). The hooks are the traceEDF_SCHEDULER_*
+        macros of ExtEDFlib.h, routed here by FreeRTOSConfig.h. Wakes that arrive while a pass is pending are folded
+        into that pass, so every sample is measured from the first wake. Built with EDF_INLINE_DISPATCH, a sample
+        runs from the release or job end to the end of the pass the task made itself, or of the deferred pass.
+
+        Synthetic periodic task sets of increasing size (1, 2, 4, ... tasks, utilization about 0.4) are run one after
+        the other. Every task set runs in its own process as the library cannot be restarted once scheduling began.
+
+    Usage:
+
+        EDFSchedBench [-n maxTasks] [-d ticks] [-o prefix]
+
+            -n  largest task set, at most MAX_NUM_OF_PERIODIC_TASKS (default)
+            -d  ticks to run every task set for (default 2000)
+            -o  write the binary trace of the library (EDFTrace.h) of the task set with N tasks to prefix-N.bin
+
+        Prints one line per task set: number of tasks, samples, mean, median, 99th percentile and maximum in us.
+*/
+
+// ************************* File Includes *************************** //
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "ExtEDFlib.h"
+// ******************************************************************* //
+
+// ************************** Bench Defines ************************** //
+#define BENCH_MAX_SAMPLES                   200000
+#define BENCH_UTILIZATION                   0.4
+#define BENCH_MIN_PERIOD                    10
+#define BENCH_TASK_STACK                    (configMINIMAL_STACK_SIZE * 2)
+#define BENCH_APP_PRIO                      (tskIDLE_PRIORITY + 1)
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef struct benchTaskParams
+{
+    TickType_t execTime;
+} benchTaskParams_t;
+// *********************************************************************** //
+
+// **************************** Globals ******************************** //
+static benchTaskParams_t benchParams[MAX_NUM_OF_PERIODIC_TASKS];
+static char benchTaskNames[MAX_NUM_OF_PERIODIC_TASKS][configMAX_TASK_NAME_LEN];
+static TaskHandle_t benchHandles[MAX_NUM_OF_PERIODIC_TASKS];
+
+static uint32_t benchSamples[BENCH_MAX_SAMPLES];   // ns
+static uint32_t benchNumOfSamples = 0;
+static uint64_t benchWakeTime = 0;                 // ns, 0 while no scheduler pass is pending
+
+static int benchNumOfTasks = 0;
+static TickType_t benchDuration = 2000;
+static const char * benchTracePrefix = NULL;
+static FILE * benchTraceFile = NULL;
+// ******************************************************************* //
+
+static uint64_t benchNow(void)
+{
+    struct timespec xNow;
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+// ********************** Scheduler Latency Hooks ********************** //
+// The wake hook also runs from the tick (the SIGALRM handler of the port), so only atomics are used here
+void benchSchedulerWake(uint32_t xEvent)
+{
+    uint64_t expected = 0;
+    (void)xEvent;
+    __atomic_compare_exchange_n(&benchWakeTime, &expected, benchNow(), pdFALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+void benchSchedulerDone(uint32_t xEvents)
+{
+    uint64_t wakeTime = __atomic_exchange_n(&benchWakeTime, 0, __ATOMIC_RELAXED);
+    (void)xEvents;
+    if ((wakeTime != 0) && (benchNumOfSamples < BENCH_MAX_SAMPLES))
+    {
+        benchSamples[benchNumOfSamples++] = (uint32_t)(benchNow() - wakeTime);
+    }
+}
+// ******************************************************************* //
+
+static void benchJob(void * params)
+{
+    // busy wait for the execution time of the job, preemptions are counted as well
+    TickType_t execTime = ((benchTaskParams_t *)params)->execTime;
+    TickType_t start = xTaskGetTickCount();
+    while ((xTaskGetTickCount() - start) < execTime)
+    {
+    }
+}
+
+static void benchTraceSink(const void * pvData, size_t xLength)
+{
+    fwrite(pvData, 1, xLength, benchTraceFile);
+}
+
+static int compareSamples(const void * a, const void * b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void benchPrintResults(void)
+{
+    uint64_t sum = 0;
+
+    if (benchNumOfSamples == 0)
+    {
+        printf("%6d %10u %10s %10s %10s %10s\n", benchNumOfTasks, 0u, "-", "-", "-", "-");
+        return;
+    }
+
+    qsort(benchSamples, benchNumOfSamples, sizeof(benchSamples[0]), compareSamples);
+    for (uint32_t i = 0; i < benchNumOfSamples; i++)
+    {
+        sum += benchSamples[i];
+    }
+    printf("%6d %10u %10.2f %10.2f %10.2f %10.2f\n", benchNumOfTasks, benchNumOfSamples,
+           (double)sum / benchNumOfSamples / 1000.0,
+           benchSamples[benchNumOfSamples / 2] / 1000.0,
+           benchSamples[(uint32_t)(benchNumOfSamples * 0.99)] / 1000.0,
+           benchSamples[benchNumOfSamples - 1] / 1000.0);
+}
+
+static void benchAppTask(void * pvParameters)
+{
+    // periods are multiples of a base period that grows with the task set so that every job runs at least a tick
+    TickType_t basePeriod = (TickType_t)(2 * benchNumOfTasks);
+    TickType_t period;
+
+    (void) pvParameters;
+    if (basePeriod < BENCH_MIN_PERIOD)
+    {
+        basePeriod = BENCH_MIN_PERIOD;
+    }
+
+    EDFInit();
+    if (benchTraceFile != NULL)
+    {
+        vEDFTraceSetSink(benchTraceSink);
+    }
+
+    for (int i = 0; i < benchNumOfTasks; i++)
+    {
+        period = basePeriod * (TickType_t)(1 + (i % 4));
+        benchParams[i].execTime = (TickType_t)((double)period * BENCH_UTILIZATION / benchNumOfTasks);
+        if (benchParams[i].execTime == 0)
+        {
+            benchParams[i].execTime = 1;
+        }
+        snprintf(benchTaskNames[i], configMAX_TASK_NAME_LEN, "Periodic %d", i + 1);
+        EDFCreatePeriodicTask(benchTaskNames[i], BENCH_TASK_STACK, benchJob, period, period, 0, &benchHandles[i],
+                              &benchParams[i], benchParams[i].execTime + 1);
+    }
+
+    EDFStartScheduling();
+
+    // EDFInit() raised this task above the scheduler, so the results are printed as soon as the delay expires
+    vTaskDelay(benchDuration);
+    vTaskSuspendAll();
+    benchPrintResults();
+    fflush(stdout);
+    if (benchTraceFile != NULL)
+    {
+        vEDFTraceFlush();
+        fclose(benchTraceFile);
+    }
+    _exit(0);
+}
+
+static int benchRunTaskSet(int numOfTasks)
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        return 1;
+    }
+    if (pid == 0)
+    {
+        benchNumOfTasks = numOfTasks;
+        if (benchTracePrefix != NULL)
+        {
+            char fileName[256];
+            snprintf(fileName, sizeof(fileName), "%s-%d.bin", benchTracePrefix, numOfTasks);
+            benchTraceFile = fopen(fileName, "wb");
+            if (benchTraceFile == NULL)
+            {
+                perror(fileName);
+                _exit(1);
+            }
+        }
+        xTaskCreate(benchAppTask, "Bench App", BENCH_TASK_STACK, NULL, BENCH_APP_PRIO, NULL);
+        vTaskStartScheduler();
+        _exit(1);
+    }
+
+    if ((waitpid(pid, &status, 0) < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+    {
+        fprintf(stderr, "[ERROR] Task set with %d tasks did not complete\n", numOfTasks);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char ** argv)
+{
+    int maxNumOfTasks = MAX_NUM_OF_PERIODIC_TASKS;
+    int failed = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+        {
+            maxNumOfTasks = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc))
+        {
+            benchDuration = (TickType_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            benchTracePrefix = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n maxTasks] [-d ticks] [-o prefix]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((maxNumOfTasks < 1) || (maxNumOfTasks > MAX_NUM_OF_PERIODIC_TASKS))
+    {
+        fprintf(stderr, "maxTasks must be between 1 and %d\n", MAX_NUM_OF_PERIODIC_TASKS);
+        return 1;
+    }
+
+    printf("%6s %10s %10s %10s %10s %10s\n", "tasks", "samples", "mean_us", "p50_us", "p99_us", "max_us");
+    for (int numOfTasks = 1; numOfTasks <= maxNumOfTasks; numOfTasks *= 2)
+    {
+        failed |= benchRunTaskSet(numOfTasks);
+    }
+    return failed;
+}
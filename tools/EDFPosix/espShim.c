@@ -0,0 +1,115 @@
+/*
+    File Description:
+        ESP-IDF services used by ExtEDFlib, implemented on the FreeRTOS POSIX port.
+*/
+
+// ************************* File Includes *************************** //
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "timers.h"
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+struct esp_timer
+{
+    TimerHandle_t xTimer;
+    esp_timer_cb_t callback;
+    void * arg;
+};
+// *********************************************************************** //
+
+static int64_t xStartTime = -1;
+
+static void prvTimerCallback(TimerHandle_t xTimer)
+{
+    esp_timer_handle_t timer = (esp_timer_handle_t)pvTimerGetTimerID(xTimer);
+    timer->callback(timer->arg);
+}
+
+void vEDFPosixAssert(const char * pcFile, unsigned long ulLine)
+{
+    fprintf(stderr, "[ERROR] Assert failed in %s:%lu\n", pcFile, ulLine);
+    abort();
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec xNow;
+    int64_t xTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    xTime = ((int64_t)xNow.tv_sec * 1000000) + (xNow.tv_nsec / 1000);
+    if (xStartTime < 0)
+    {
+        xStartTime = xTime;
+    }
+    return xTime - xStartTime;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t * create_args, esp_timer_handle_t * out_handle)
+{
+    esp_timer_handle_t timer;
+
+    if ((create_args == NULL) || (create_args->callback == NULL) || (out_handle == NULL))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    timer = (esp_timer_handle_t)pvPortMalloc(sizeof(struct esp_timer));
+    if (timer == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    timer->callback = create_args->callback;
+    timer->arg = create_args->arg;
+    // period is set on every start, the kernel only requires it to be non zero here
+    timer->xTimer = xTimerCreate(create_args->name, 1, pdFALSE, timer, prvTimerCallback);
+    if (timer->xTimer == NULL)
+    {
+        vPortFree(timer);
+        return ESP_ERR_NO_MEM;
+    }
+
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    // round up to whole ticks, the timer must not fire early
+    uint64_t ticks = (timeout_us + (portTICK_PERIOD_MS * 1000) - 1) / (portTICK_PERIOD_MS * 1000);
+
+    if (ticks == 0)
+    {
+        ticks = 1;
+    }
+    if (xTimerIsTimerActive(timer->xTimer) != pdFALSE)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // changing the period also starts the timer
+    return (xTimerChangePeriod(timer->xTimer, (TickType_t)ticks, portMAX_DELAY) == pdPASS) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (xTimerIsTimerActive(timer->xTimer) == pdFALSE)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return (xTimerStop(timer->xTimer, portMAX_DELAY) == pdPASS) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (xTimerDelete(timer->xTimer, portMAX_DELAY) != pdPASS)
+    {
+        return ESP_FAIL;
+    }
+    vPortFree(timer);
+    return ESP_OK;
+}
@@ -0,0 +1,82 @@
+/*
+    File Description:
+        Kernel configuration for running ExtEDFlib on the FreeRTOS POSIX port. The values follow the ESP-IDF
+        defaults that the library is developed against (25 priorities, 1 kHz tick, thread local storage) and,
+        as on the target, the EDF trace hooks are wired into the kernel by including traceMacros.h at the end.
+*/
+
+#ifndef _EDF_POSIX_FREERTOS_CONFIG_H_
+#define _EDF_POSIX_FREERTOS_CONFIG_H_
+
+#include <limits.h>
+#include <stdint.h>
+
+// ************************* Kernel Config ***************************** //
+#define configUSE_PREEMPTION                        1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION     0
+#define configUSE_TIME_SLICING                      1
+#define configTICK_RATE_HZ                          1000
+#define configTICK_TYPE_WIDTH_IN_BITS               TICK_TYPE_WIDTH_32_BITS
+#define configMAX_PRIORITIES                        25
+#define configMAX_TASK_NAME_LEN                     16
+#define configMINIMAL_STACK_SIZE                    ((unsigned short)(PTHREAD_STACK_MIN / sizeof(StackType_t)))
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS     1
+#define configUSE_TASK_NOTIFICATIONS                1
+#define configUSE_MUTEXES                           1
+#define configUSE_COUNTING_SEMAPHORES               1
+#define configQUEUE_REGISTRY_SIZE                   0
+#define configSUPPORT_DYNAMIC_ALLOCATION            1
+#define configSUPPORT_STATIC_ALLOCATION             1  // for USE_STATIC_ALLOCATION of the library
+#define configKERNEL_PROVIDED_STATIC_MEMORY         1  // idle and timer task buffers
+#define configUSE_MALLOC_FAILED_HOOK                0
+#define configCHECK_FOR_STACK_OVERFLOW              0
+
+// Hooks implemented by ExtEDFlib.c
+#define configUSE_TICK_HOOK                         1
+#define configUSE_IDLE_HOOK                         1
+
+// uxTaskNumber and uxTCBNumber are read by the trace macros, vTaskSetTaskNumber is used by the library
+#define configUSE_TRACE_FACILITY                    1
+
+// Software timers back the esp_timer shim, run them above the EDF scheduler task
+#define configUSE_TIMERS                            1
+#define configTIMER_TASK_PRIORITY                   (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH                    10
+#define configTIMER_TASK_STACK_DEPTH                (configMINIMAL_STACK_SIZE * 2)
+
+#define INCLUDE_vTaskPrioritySet                    1
+#define INCLUDE_uxTaskPriorityGet                   1
+#define INCLUDE_vTaskDelete                         1
+#define INCLUDE_vTaskSuspend                        1
+#define INCLUDE_xTaskResumeFromISR                  1
+#define INCLUDE_xTaskDelayUntil                     1
+#define INCLUDE_vTaskDelay                          1
+#define INCLUDE_xTaskGetCurrentTaskHandle           1
+#define INCLUDE_xTaskGetSchedulerState              1
+#define INCLUDE_pcTaskGetTaskName                   1
+
+void vEDFPosixAssert(const char * pcFile, unsigned long ulLine);
+#define configASSERT(x)                             if (!(x)) { vEDFPosixAssert(__FILE__, __LINE__); }
+// *********************************************************************** //
+
+// ************************* EDF Trace Hooks *************************** //
+// The POSIX port is single core, the current TCB is not an array as in ESP-IDF
+#define EDF_TRACE_CURRENT_TCB                       pxCurrentTCB
+// V11 keeps the pended yield in an array even on a single core
+#define EDF_TRACE_YIELD_PENDING                     xYieldPendings[0]
+
+// Scheduler latency hooks of ExtEDFlib.h, implemented by EDFSchedBench.c
+#ifdef EDF_SCHED_BENCH
+#define traceEDF_SCHEDULER_WAKE(event)\
+extern void benchSchedulerWake(uint32_t xEvent);\
+benchSchedulerWake(event);
+
+#define traceEDF_SCHEDULER_DONE(events)\
+extern void benchSchedulerDone(uint32_t xEvents);\
+benchSchedulerDone(events);
+#endif
+
+#include "traceMacros.h"
+// *********************************************************************** //
+
+#endif // _EDF_POSIX_FREERTOS_CONFIG_H_
@@ -0,0 +1,14 @@
+#ifndef _EDF_POSIX_ESP_ERR_H_
+#define _EDF_POSIX_ESP_ERR_H_
+
+typedef int esp_err_t;
+
+#define ESP_OK                              0
+#define ESP_FAIL                            -1
+#define ESP_ERR_NO_MEM                      0x101
+#define ESP_ERR_INVALID_ARG                 0x102
+#define ESP_ERR_INVALID_STATE               0x103
+
+#define ESP_ERROR_CHECK(x)                  do { esp_err_t __err_rc = (x); configASSERT(__err_rc == ESP_OK); } while (0)
+
+#endif // _EDF_POSIX_ESP_ERR_H_
@@ -0,0 +1,38 @@
+/*
+    File Description:
+        esp_timer replacement for the POSIX port. The time base is CLOCK_MONOTONIC in microseconds since the
+        first call, one-shot timers are FreeRTOS software timers and so have tick resolution.
+*/
+
+#ifndef _EDF_POSIX_ESP_TIMER_H_
+#define _EDF_POSIX_ESP_TIMER_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef void (*esp_timer_cb_t)(void * arg);
+
+typedef enum
+{
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR
+} esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t callback;
+    void * arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char * name;
+    int skip_unhandled_events;
+} esp_timer_create_args_t;
+
+typedef struct esp_timer * esp_timer_handle_t;
+
+int64_t esp_timer_get_time(void);
+esp_err_t esp_timer_create(const esp_timer_create_args_t * create_args, esp_timer_handle_t * out_handle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+
+#endif // _EDF_POSIX_ESP_TIMER_H_
@@ -0,0 +1,15 @@
+/*
+    File Description:
+        ESP-IDF keeps the kernel headers in a freertos/ directory and pulls the esp_timer API in with them,
+        these wrappers let ExtEDFlib build unchanged against the FreeRTOS-Kernel headers.
+*/
+
+#ifndef _EDF_POSIX_FREERTOS_H_
+#define _EDF_POSIX_FREERTOS_H_
+
+#include <FreeRTOS.h>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+
+#endif // _EDF_POSIX_FREERTOS_H_
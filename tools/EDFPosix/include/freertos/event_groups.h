@@ -0,0 +1,7 @@
+#ifndef _EDF_POSIX_EVENT_GROUPS_H_
+#define _EDF_POSIX_EVENT_GROUPS_H_
+
+#include "freertos/FreeRTOS.h"
+#include <event_groups.h>
+
+#endif // _EDF_POSIX_EVENT_GROUPS_H_
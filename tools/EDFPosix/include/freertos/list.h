@@ -0,0 +1,7 @@
+#ifndef _EDF_POSIX_LIST_H_
+#define _EDF_POSIX_LIST_H_
+
+#include "freertos/FreeRTOS.h"
+#include <list.h>
+
+#endif // _EDF_POSIX_LIST_H_
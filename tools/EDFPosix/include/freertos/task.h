@@ -0,0 +1,7 @@
+#ifndef _EDF_POSIX_TASK_H_
+#define _EDF_POSIX_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+#include <task.h>
+
+#endif // _EDF_POSIX_TASK_H_
@@ -0,0 +1,7 @@
+#ifndef _EDF_POSIX_TIMERS_H_
+#define _EDF_POSIX_TIMERS_H_
+
+#include "freertos/FreeRTOS.h"
+#include <timers.h>
+
+#endif // _EDF_POSIX_TIMERS_H_
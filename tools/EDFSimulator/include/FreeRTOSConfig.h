@@ -0,0 +1,47 @@
+/*
+    File Description:
+        Kernel configuration of the simulated FreeRTOS used by the host side EDF simulator. The values follow
+        the ESP-IDF defaults that the library is developed against (25 priorities, 1 kHz tick, thread local storage).
+        As on the target, the EDF trace hooks are wired into the kernel by including traceMacros.h at the end.
+*/
+
+#ifndef _SIM_FREERTOS_CONFIG_H_
+#define _SIM_FREERTOS_CONFIG_H_
+
+#define configUSE_PREEMPTION                        1
+#define configUSE_TIME_SLICING                      1
+#define configTICK_RATE_HZ                          1000
+#define configMAX_PRIORITIES                        25
+#define configMAX_TASK_NAME_LEN                     16
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS     1
+#define configUSE_TICK_HOOK                         1
+#define configUSE_IDLE_HOOK                         0
+
+// Timer service task, it only runs the function calls deferred with xTimerPendFunctionCallFromISR
+#ifndef configUSE_TIMERS
+#define configUSE_TIMERS                            0
+#endif
+#define configTIMER_TASK_PRIORITY                   (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH                    16
+
+#ifndef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES                       1
+#endif
+
+// Stack given to every simulated task in bytes, FreeRTOS stack depths are ignored as host code needs more stack
+#ifndef SIM_TASK_STACK_SIZE
+#define SIM_TASK_STACK_SIZE                         (64 * 1024)
+#endif
+
+// Scheduler wakes and passes of the library (ExtEDFlib.h), counted and timed by simMain.c
+#define traceEDF_SCHEDULER_WAKE(event)\
+extern void simSchedulerWake(uint32_t ulEvent);\
+simSchedulerWake(event);
+
+#define traceEDF_SCHEDULER_DONE(events)\
+extern void simSchedulerDone(uint32_t ulEvents);\
+simSchedulerDone(events);
+
+#include "traceMacros.h"
+
+#endif // _SIM_FREERTOS_CONFIG_H_
@@ -0,0 +1,11 @@
+#ifndef _SIM_ESP_ERR_H_
+#define _SIM_ESP_ERR_H_
+
+typedef int esp_err_t;
+
+#define ESP_OK                              0
+#define ESP_FAIL                            -1
+
+#define ESP_ERROR_CHECK(x)                  do { esp_err_t __err_rc = (x); if (__err_rc != ESP_OK) { simAssertFailed(__FILE__, __LINE__, #x); } } while (0)
+
+#endif // _SIM_ESP_ERR_H_
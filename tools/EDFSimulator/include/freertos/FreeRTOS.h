@@ -0,0 +1,99 @@
+/*
+    File Description:
+        Minimal FreeRTOS API surface used by ExtEDFlib, implemented on top of the discrete-event kernel in
+        simKernel.c. Only the parts of the API that the library and the simulator use are provided.
+*/
+
+#ifndef _SIM_FREERTOS_H_
+#define _SIM_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOSConfig.h"
+
+// ************************* Port Types ********************************** //
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef unsigned long TickType_t;
+typedef unsigned long StackType_t;
+
+#define portMAX_DELAY                       ((TickType_t)~0UL)
+#define portTICK_PERIOD_MS                  ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portNUM_PROCESSORS                  configNUMBER_OF_CORES
+
+#define pdFALSE                             ((BaseType_t)0)
+#define pdTRUE                              ((BaseType_t)1)
+#define pdPASS                              (pdTRUE)
+#define pdFAIL                              (pdFALSE)
+#define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY   (-1)
+
+#define pdMS_TO_TICKS(xTimeInMs)            ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+#define pdTICKS_TO_MS(xTicks)               ((TickType_t)(((uint64_t)(xTicks) * (uint64_t)1000U) / (uint64_t)configTICK_RATE_HZ))
+
+#define tskIDLE_PRIORITY                    ((UBaseType_t)0U)
+#define tskNO_AFFINITY                      ((BaseType_t)0x7FFFFFFF)
+// *********************************************************************** //
+
+// *************************** Kernel Hooks ****************************** //
+void simAssertFailed(const char * pcFile, int iLine, const char * pcExpr);
+void simYieldFromISR(BaseType_t xSwitchRequired);
+BaseType_t xPortGetCoreID(void);
+void * pvPortMalloc(size_t xSize);
+void vPortFree(void * pv);
+
+#define configASSERT(x)                     if (!(x)) { simAssertFailed(__FILE__, __LINE__, #x); }
+#define portYIELD_FROM_ISR(x)               simYieldFromISR(x)
+#define portENTER_CRITICAL(pxMux)           ((void)(pxMux))
+#define portEXIT_CRITICAL(pxMux)            ((void)(pxMux))
+#define portENTER_CRITICAL_ISR(pxMux)       ((void)(pxMux))
+#define portEXIT_CRITICAL_ISR(pxMux)        ((void)(pxMux))
+#define portENTER_CRITICAL_SAFE(pxMux)      ((void)(pxMux))
+#define portEXIT_CRITICAL_SAFE(pxMux)       ((void)(pxMux))
+#define portSET_INTERRUPT_MASK_FROM_ISR()   0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) ((void)(x))
+#define portMUX_INITIALIZER_UNLOCKED        0
+typedef int portMUX_TYPE;
+// *********************************************************************** //
+
+// Trace hooks the library does not define expand to nothing, as in the real FreeRTOS.h
+#ifndef traceTASK_INCREMENT_TICK
+#define traceTASK_INCREMENT_TICK(xTickCount)
+#endif
+#ifndef traceTASK_SWITCHED_IN
+#define traceTASK_SWITCHED_IN()
+#endif
+#ifndef traceTASK_SWITCHED_OUT
+#define traceTASK_SWITCHED_OUT()
+#endif
+#ifndef traceMOVED_TASK_TO_READY_STATE
+#define traceMOVED_TASK_TO_READY_STATE(xTask)
+#endif
+#ifndef traceTASK_DELAY_UNTIL
+#define traceTASK_DELAY_UNTIL(xAbsTick)
+#endif
+#ifndef traceTASK_DELAY
+#define traceTASK_DELAY()
+#endif
+#ifndef traceTASK_SUSPEND
+#define traceTASK_SUSPEND(xTask)
+#endif
+#ifndef traceTASK_RESUME
+#define traceTASK_RESUME(xTask)
+#endif
+#ifndef traceTASK_RESUME_FROM_ISR
+#define traceTASK_RESUME_FROM_ISR(xTask)
+#endif
+
+#include "esp_err.h"
+#include "esp_timer.h"
+
+// The library prints on its job paths, route that output through the simulator so it can be silenced
+#ifdef SIM_REDIRECT_PRINTF
+int simLibPrintf(const char * pcFormat, ...);
+#define printf(...)                         simLibPrintf(__VA_ARGS__)
+#endif
+
+#endif // _SIM_FREERTOS_H_
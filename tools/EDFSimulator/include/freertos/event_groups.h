@@ -0,0 +1,8 @@
+#ifndef _SIM_EVENT_GROUPS_H_
+#define _SIM_EVENT_GROUPS_H_
+
+#include "freertos/FreeRTOS.h"
+
+// Event groups are not used by the library, the header only exists so that ExtEDFlib.h can be included unchanged
+
+#endif // _SIM_EVENT_GROUPS_H_
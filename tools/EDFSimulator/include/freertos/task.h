@@ -0,0 +1,75 @@
+/*
+    File Description:
+        Task API of the simulated FreeRTOS kernel. Tasks run as coroutines on the host and only advance
+        virtual time through simConsume(), every other call completes in zero virtual time.
+*/
+
+#ifndef _SIM_TASK_H_
+#define _SIM_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/list.h"
+
+struct tskTaskControlBlock;
+typedef struct tskTaskControlBlock * TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// Buffers given to xTaskCreateStatic are not used, simulated tasks always run on stacks of the simulator
+typedef struct xSTATIC_TCB
+{
+    void * pvDummy;
+} StaticTask_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+#define taskYIELD()                         vTaskYield()
+#define taskENTER_CRITICAL(pxMux)           portENTER_CRITICAL(pxMux)
+#define taskEXIT_CRITICAL(pxMux)            portEXIT_CRITICAL(pxMux)
+
+// ********************** Function Declarations *************************** //
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, const BaseType_t xCoreID);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer);
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer, const BaseType_t xCoreID);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+void vTaskDelay(const TickType_t xTicksToDelay);
+BaseType_t xTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+void vTaskSuspend(TaskHandle_t xTaskToSuspend);
+void vTaskResume(TaskHandle_t xTaskToResume);
+BaseType_t xTaskResumeFromISR(TaskHandle_t xTaskToResume);
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+void vTaskYield(void);
+
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t xCoreID);
+TaskHandle_t xTaskGetIdleTaskHandle(void);
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t xCoreID);
+char * pcTaskGetName(TaskHandle_t xTaskToQuery);
+
+void vTaskSetTaskNumber(TaskHandle_t xTask, const UBaseType_t uxHandle);
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t xTask);
+void vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void * pvValue);
+void * pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex);
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t * pulNotificationValue, TickType_t xTicksToWait);
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t * pxHigherPriorityTaskWoken);
+
+// Application hooks
+void vApplicationTickHook(void);
+// ************************************************************************ //
+
+#endif // _SIM_TASK_H_
@@ -0,0 +1,19 @@
+/*
+    File Description:
+        Software timer API of the simulated FreeRTOS kernel. Only the function calls deferred to the timer service
+        task are provided, which is what the library uses them for (USE_EDF_INLINE_DISPATCH).
+*/
+
+#ifndef _SIM_TIMERS_H_
+#define _SIM_TIMERS_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*PendedFunction_t)(void *, uint32_t);
+
+// ********************** Function Declarations *************************** //
+BaseType_t xTimerPendFunctionCall(PendedFunction_t xFunctionToPend, void * pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait);
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t xFunctionToPend, void * pvParameter1, uint32_t ulParameter2, BaseType_t * pxHigherPriorityTaskWoken);
+// ************************************************************************ //
+
+#endif // _SIM_TIMERS_H_
@@ -0,0 +1,42 @@
+/*
+    File Description:
+        Control interface of the discrete-event FreeRTOS kernel used by the host side EDF simulator.
+
+        Virtual time advances one tick at a time. Each tick the kernel unblocks delayed tasks, calls the
+        application tick hook and applies time slicing exactly like xTaskIncrementTick. Tasks are coroutines
+        and only consume virtual time by calling simConsume(), so the library code runs unmodified while its
+        scheduling decisions are evaluated much faster than real time.
+*/
+
+#ifndef _SIM_KERNEL_H_
+#define _SIM_KERNEL_H_
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef void (*simSwitchHook_t)(TaskHandle_t xTaskOut, TaskHandle_t xTaskIn);
+// interrupt of the application, runs on core 0 every tick after the tick hook
+typedef void (*simTickHook_t)(void);
+
+typedef struct simTaskStats
+{
+    uint64_t ulSwitchIns;               // number of times the task was switched in
+    uint64_t ulNotifyWaits;             // number of completed xTaskNotifyWait calls
+    uint64_t ulRunTicks;                // ticks of simConsume work executed
+} simTaskStats_t;
+
+// ********************** Function Declarations *************************** //
+void simInit(void);
+void simRun(TickType_t xTicksToRun);
+void simStop(void);
+void simShutdown(void);
+void simConsume(TickType_t xTicks);
+void simSetSwitchHook(simSwitchHook_t pxHook);
+void simSetTickHook(simTickHook_t pxHook);
+void simSetLibraryOutput(BaseType_t xEnable);
+TaskHandle_t simFindTask(const char * pcName);
+void simGetTaskStats(TaskHandle_t xTask, simTaskStats_t * pxStats);
+uint64_t simGetContextSwitches(void);
+// ************************************************************************ //
+
+#endif // _SIM_KERNEL_H_
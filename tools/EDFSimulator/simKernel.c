@@ -0,0 +1,1199 @@
+/*
+    File Description:
+        Discrete-event implementation of the FreeRTOS task API for the host side EDF simulator.
+
+        The kernel follows the behaviour of tasks.c closely where the EDF library depends on it: ready lists per
+        priority walked round robin, tasks unblocked and time sliced in the tick, traceMOVED_TASK_TO_READY_STATE
+        emitted by every path that adds a task to a ready list (including vTaskPrioritySet) and the other trace
+        hooks from traceMacros.h emitted from the same places as in the real kernel.
+
+        Tasks are coroutines: they are started with makecontext() and switched with _setjmp()/_longjmp(), which
+        avoids a system call per context switch. Yields requested from inside a kernel call or from a trace hook
+        are deferred until the kernel call completes, the same way a pended yield is handled by FreeRTOS.
+
+        With configNUMBER_OF_CORES > 1 every core has its own current task, idle task and pended yield, and
+        selects the highest priority ready task that may run on it (affinity as in ESP-IDF) and is not running
+        on another core. Within a tick the cores run their tasks one after the other until each of them either
+        consumes time or idles, then the tick advances on all cores at once and the tick hook runs on each core.
+
+        With configUSE_TIMERS the timer service task is created as well, it only runs the function calls pended
+        with xTimerPendFunctionCallFromISR(), on core 0 above every other task.
+*/
+
+// ************************* File Includes *************************** //
+#include <setjmp.h>
+#include <stdarg.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "simKernel.h"
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef enum simState
+{
+    simREADY = 0,
+    simDELAYED,
+    simSUSPENDED,
+    simNOTIFY_WAIT,
+    simDELETED
+} simState_t;
+
+/*
+Simulated TCB, the first two members are the ones read by the trace macros
+*/
+typedef struct tskTaskControlBlock
+{
+    UBaseType_t uxTCBNumber;
+    UBaseType_t uxTaskNumber;
+    char pcTaskName[configMAX_TASK_NAME_LEN];
+    UBaseType_t uxPriority;
+    BaseType_t xCoreID;
+    ListItem_t xStateListItem;
+    simState_t eState;
+    TickType_t xWakeTime;
+    UBaseType_t uxDelayIndex;
+    BaseType_t xInDelayHeap;
+    void * pvThreadLocalStoragePointers[configNUM_THREAD_LOCAL_STORAGE_POINTERS];
+    uint32_t ulNotifiedValue;
+    BaseType_t xNotifyPending;
+    TaskFunction_t pxTaskCode;
+    void * pvParameters;
+    ucontext_t xStartContext;
+    jmp_buf xContext;
+    void * pvStack;
+    BaseType_t xStarted;
+    TickType_t xWorkRemaining;
+    simTaskStats_t xStats;
+    struct tskTaskControlBlock * pxNextAllocated;
+} simTCB_t;
+
+#if configUSE_TIMERS == 1
+typedef struct simPendedCall
+{
+    PendedFunction_t xFunction;
+    void * pvParameter1;
+    uint32_t ulParameter2;
+} simPendedCall_t;
+#endif
+
+struct esp_timer
+{
+    esp_timer_cb_t callback;
+    void * arg;
+    BaseType_t xArmed;
+    int64_t llExpiryTime;
+    struct esp_timer * pxNext;
+};
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+/*
+Read by the trace macros in traceMacros.h
+*/
+simTCB_t * volatile pxCurrentTCB[configNUMBER_OF_CORES] = {NULL};
+
+static List_t pxReadyTasksLists[configMAX_PRIORITIES];
+static UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+static simTCB_t * pxIdleTCB[configNUMBER_OF_CORES] = {NULL};
+static simTCB_t * pxAllocatedTCBs = NULL;
+// TCB numbers as on the ESP32 where the library expects the idle task to be number 3 (IDLE_TASK_NUM)
+static UBaseType_t uxTaskNumber = 3;
+
+// Tasks waiting for a time, binary heap ordered on xWakeTime
+static simTCB_t ** pxDelayedTasks = NULL;
+static UBaseType_t uxDelayedCount = 0;
+static UBaseType_t uxDelayedCapacity = 0;
+
+static struct esp_timer * pxTimers = NULL;
+
+#if configUSE_TIMERS == 1
+// Timer service task and the calls pended on it, run in the order they were pended
+static simTCB_t * pxTimerTCB = NULL;
+static simPendedCall_t xPendedCalls[configTIMER_QUEUE_LENGTH];
+static UBaseType_t uxPendedCallsHead = 0;
+static UBaseType_t uxNumOfPendedCalls = 0;
+#endif
+
+static volatile TickType_t xTickCount = 0;
+static BaseType_t xYieldPending[configNUMBER_OF_CORES] = {pdFALSE};
+// core whose task is executing or being scheduled, returned by xPortGetCoreID()
+static BaseType_t xCurrentCore = 0;
+static UBaseType_t uxSchedulerSuspended = 0;
+static BaseType_t xInKernel = pdTRUE;
+static BaseType_t xSimRunning = pdFALSE;
+static BaseType_t xLibraryOutput = pdFALSE;
+static jmp_buf xKernelContext;
+
+static uint64_t ulContextSwitches = 0;
+static simSwitchHook_t pxSwitchHook = NULL;
+static simTickHook_t pxTickHook = NULL;
+// *********************************************************************** //
+
+// ****************** Private Function Declarations ***************** //
+static void prvTaskEntry(void);
+static void prvResumeTask(simTCB_t * pxTCB);
+static void prvSwitchToKernel(void);
+static void prvYieldWithinAPI(void);
+static void prvYieldIfPending(void);
+static BaseType_t prvRunningOnCore(simTCB_t * pxTCB);
+static BaseType_t prvYieldForTask(simTCB_t * pxTCB, BaseType_t xPreemptEqual);
+static void prvSwitchContext(BaseType_t xCore);
+static void prvIncrementTick(void);
+static void prvProcessTimers(void);
+static void prvAddTaskToReadyList(simTCB_t * pxTCB);
+static void prvRemoveFromReadyList(simTCB_t * pxTCB);
+static void prvAddCurrentTaskToDelayedList(TickType_t xTicksToWait, simState_t eState);
+static void prvDelayedInsert(simTCB_t * pxTCB);
+static void prvDelayedRemove(simTCB_t * pxTCB);
+static void prvDelayedPlace(simTCB_t * pxTCB, UBaseType_t uxIndex);
+static simTCB_t * prvCreateTask(TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters, UBaseType_t uxPriority, BaseType_t xCoreID, BaseType_t xNeedsStack);
+#if configUSE_TIMERS == 1
+static void prvTimerTask(void * pvParameters);
+#endif
+// ******************************************************************* //
+
+// ************************ Context Switching ************************ //
+static void prvTaskEntry(void)
+{
+    simTCB_t * pxTCB = pxCurrentTCB[xCurrentCore];
+    pxTCB->pxTaskCode(pxTCB->pvParameters);
+    // FreeRTOS tasks must not return, treat it as deleting itself
+    vTaskDelete(NULL);
+}
+
+static void prvResumeTask(simTCB_t * pxTCB)
+{
+    xInKernel = pdFALSE;
+    if (_setjmp(xKernelContext) == 0)
+    {
+        if (pxTCB->xStarted == pdFALSE)
+        {
+            pxTCB->xStarted = pdTRUE;
+            setcontext(&pxTCB->xStartContext);
+        }
+        _longjmp(pxTCB->xContext, 1);
+    }
+    xInKernel = pdTRUE;
+}
+
+static void prvSwitchToKernel(void)
+{
+    simTCB_t * pxTCB = pxCurrentTCB[xCurrentCore];
+    if (_setjmp(pxTCB->xContext) == 0)
+    {
+        _longjmp(xKernelContext, 1);
+    }
+}
+
+static void prvYieldWithinAPI(void)
+{
+    xYieldPending[xCurrentCore] = pdTRUE;
+    prvYieldIfPending();
+}
+
+static void prvYieldIfPending(void)
+{
+    if ((xInKernel == pdFALSE) && (xYieldPending[xCurrentCore] == pdTRUE) && (uxSchedulerSuspended == 0))
+    {
+        prvSwitchToKernel();
+    }
+}
+
+static BaseType_t prvRunningOnCore(simTCB_t * pxTCB)
+{
+    // core the task is the current task of, -1 if none
+    for (BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++)
+    {
+        if (pxCurrentTCB[xCore] == pxTCB)
+        {
+            return xCore;
+        }
+    }
+    return -1;
+}
+
+static BaseType_t prvYieldForTask(simTCB_t * pxTCB, BaseType_t xPreemptEqual)
+{
+    // pend a yield on a core whose current task the given task preempts, the calling core first as in ESP-IDF
+    // returns that core or -1
+    BaseType_t xCore;
+
+    if (prvRunningOnCore(pxTCB) >= 0)
+    {
+        return -1;
+    }
+    for (BaseType_t i = 0; i < configNUMBER_OF_CORES; i++)
+    {
+        xCore = (xCurrentCore + i) % configNUMBER_OF_CORES;
+        if ((pxCurrentTCB[xCore] == NULL) || ((pxTCB->xCoreID != tskNO_AFFINITY) && (pxTCB->xCoreID != xCore)))
+        {
+            continue;
+        }
+        if ((pxTCB->uxPriority > pxCurrentTCB[xCore]->uxPriority) ||
+            ((xPreemptEqual == pdTRUE) && (pxTCB->uxPriority == pxCurrentTCB[xCore]->uxPriority)))
+        {
+            xYieldPending[xCore] = pdTRUE;
+            return xCore;
+        }
+    }
+    return -1;
+}
+
+static void prvSwitchContext(BaseType_t xCore)
+{
+    simTCB_t * pxPrevious = pxCurrentTCB[xCore];
+    simTCB_t * pxTCB = NULL;
+    BaseType_t xOtherCore;
+    UBaseType_t uxPriority;
+
+    xCurrentCore = xCore;
+    if (pxPrevious != NULL)
+    {
+        traceTASK_SWITCHED_OUT();
+    }
+
+    while (listLIST_IS_EMPTY(&pxReadyTasksLists[uxTopReadyPriority]))
+    {
+        configASSERT(uxTopReadyPriority > 0);
+        uxTopReadyPriority--;
+    }
+
+    // round robin within the highest priority that has a task this core may run, the idle task of the core always qualifies
+    for (uxPriority = uxTopReadyPriority; pxTCB == NULL; uxPriority--)
+    {
+        for (UBaseType_t i = listCURRENT_LIST_LENGTH(&pxReadyTasksLists[uxPriority]); (i > 0) && (pxTCB == NULL); i--)
+        {
+            listGET_OWNER_OF_NEXT_ENTRY(pxTCB, &pxReadyTasksLists[uxPriority]);
+            xOtherCore = prvRunningOnCore(pxTCB);
+            if (((pxTCB->xCoreID != tskNO_AFFINITY) && (pxTCB->xCoreID != xCore)) || ((xOtherCore >= 0) && (xOtherCore != xCore)))
+            {
+                pxTCB = NULL;
+            }
+        }
+        configASSERT((pxTCB != NULL) || (uxPriority > 0));
+    }
+    pxCurrentTCB[xCore] = pxTCB;
+
+    traceTASK_SWITCHED_IN();
+
+    if (pxPrevious != pxTCB)
+    {
+        ulContextSwitches++;
+        pxTCB->xStats.ulSwitchIns++;
+        if (pxSwitchHook != NULL)
+        {
+            pxSwitchHook(pxPrevious, pxTCB);
+        }
+    }
+    xYieldPending[xCore] = pdFALSE;
+}
+// ******************************************************************* //
+
+// ************************** Task Lists ***************************** //
+static void prvAddTaskToReadyList(simTCB_t * pxTCB)
+{
+    traceMOVED_TASK_TO_READY_STATE(pxTCB);
+    pxTCB->eState = simREADY;
+    vListInsertEnd(&pxReadyTasksLists[pxTCB->uxPriority], &pxTCB->xStateListItem);
+    if (pxTCB->uxPriority > uxTopReadyPriority)
+    {
+        uxTopReadyPriority = pxTCB->uxPriority;
+    }
+}
+
+static void prvRemoveFromReadyList(simTCB_t * pxTCB)
+{
+    if (listLIST_ITEM_CONTAINER(&pxTCB->xStateListItem) != NULL)
+    {
+        uxListRemove(&pxTCB->xStateListItem);
+    }
+}
+
+static void prvDelayedPlace(simTCB_t * pxTCB, UBaseType_t uxIndex)
+{
+    pxDelayedTasks[uxIndex] = pxTCB;
+    pxTCB->uxDelayIndex = uxIndex;
+}
+
+static void prvDelayedInsert(simTCB_t * pxTCB)
+{
+    UBaseType_t uxIndex;
+    UBaseType_t uxParent;
+
+    if (uxDelayedCount == uxDelayedCapacity)
+    {
+        uxDelayedCapacity = (uxDelayedCapacity == 0) ? 64 : uxDelayedCapacity * 2;
+        pxDelayedTasks = realloc(pxDelayedTasks, uxDelayedCapacity * sizeof(simTCB_t *));
+        configASSERT(pxDelayedTasks != NULL);
+    }
+
+    uxIndex = uxDelayedCount++;
+    while (uxIndex > 0)
+    {
+        uxParent = (uxIndex - 1) / 2;
+        if (pxDelayedTasks[uxParent]->xWakeTime <= pxTCB->xWakeTime)
+        {
+            break;
+        }
+        prvDelayedPlace(pxDelayedTasks[uxParent], uxIndex);
+        uxIndex = uxParent;
+    }
+    prvDelayedPlace(pxTCB, uxIndex);
+    pxTCB->xInDelayHeap = pdTRUE;
+}
+
+static void prvDelayedRemove(simTCB_t * pxTCB)
+{
+    UBaseType_t uxIndex;
+    UBaseType_t uxChild;
+    simTCB_t * pxLast;
+
+    if (pxTCB->xInDelayHeap == pdFALSE)
+    {
+        return;
+    }
+    pxTCB->xInDelayHeap = pdFALSE;
+
+    uxIndex = pxTCB->uxDelayIndex;
+    pxLast = pxDelayedTasks[--uxDelayedCount];
+    if (pxLast == pxTCB)
+    {
+        return;
+    }
+
+    // sift the last task up or down from the hole
+    while ((uxIndex > 0) && (pxDelayedTasks[(uxIndex - 1) / 2]->xWakeTime > pxLast->xWakeTime))
+    {
+        prvDelayedPlace(pxDelayedTasks[(uxIndex - 1) / 2], uxIndex);
+        uxIndex = (uxIndex - 1) / 2;
+    }
+    for (;;)
+    {
+        uxChild = (2 * uxIndex) + 1;
+        if (uxChild >= uxDelayedCount)
+        {
+            break;
+        }
+        if (((uxChild + 1) < uxDelayedCount) && (pxDelayedTasks[uxChild + 1]->xWakeTime < pxDelayedTasks[uxChild]->xWakeTime))
+        {
+            uxChild++;
+        }
+        if (pxDelayedTasks[uxChild]->xWakeTime >= pxLast->xWakeTime)
+        {
+            break;
+        }
+        prvDelayedPlace(pxDelayedTasks[uxChild], uxIndex);
+        uxIndex = uxChild;
+    }
+    prvDelayedPlace(pxLast, uxIndex);
+}
+
+static void prvAddCurrentTaskToDelayedList(TickType_t xTicksToWait, simState_t eState)
+{
+    simTCB_t * pxTCB = pxCurrentTCB[xCurrentCore];
+
+    prvRemoveFromReadyList(pxTCB);
+    pxTCB->eState = eState;
+    if (xTicksToWait != portMAX_DELAY)
+    {
+        pxTCB->xWakeTime = xTickCount + xTicksToWait;
+        prvDelayedInsert(pxTCB);
+    }
+}
+// ******************************************************************* //
+
+// **************************** Tick ********************************* //
+static void prvProcessTimers(void)
+{
+    struct esp_timer * pxTimer;
+    int64_t llNow = esp_timer_get_time();
+
+    for (pxTimer = pxTimers; pxTimer != NULL; pxTimer = pxTimer->pxNext)
+    {
+        if ((pxTimer->xArmed == pdTRUE) && (pxTimer->llExpiryTime <= llNow))
+        {
+            pxTimer->xArmed = pdFALSE;
+            pxTimer->callback(pxTimer->arg);
+        }
+    }
+}
+
+static void prvIncrementTick(void)
+{
+    simTCB_t * pxTCB;
+
+    // the tick is counted on core 0, as in ESP-IDF
+    xCurrentCore = 0;
+    xTickCount++;
+    traceTASK_INCREMENT_TICK(xTickCount);
+
+    while ((uxDelayedCount > 0) && (pxDelayedTasks[0]->xWakeTime <= xTickCount))
+    {
+        pxTCB = pxDelayedTasks[0];
+        prvDelayedRemove(pxTCB);
+        prvAddTaskToReadyList(pxTCB);
+        (void)prvYieldForTask(pxTCB, pdTRUE);
+    }
+
+    for (BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++)
+    {
+        if (listCURRENT_LIST_LENGTH(&pxReadyTasksLists[pxCurrentTCB[xCore]->uxPriority]) > 1)
+        {
+            xYieldPending[xCore] = pdTRUE;
+        }
+    }
+
+    prvProcessTimers();
+    // every core runs the tick hook from its own tick interrupt
+    for (BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++)
+    {
+        xCurrentCore = xCore;
+        vApplicationTickHook();
+    }
+    if (pxTickHook != NULL)
+    {
+        xCurrentCore = 0;
+        pxTickHook();
+    }
+}
+// ******************************************************************* //
+
+// ************************ Task Creation **************************** //
+static simTCB_t * prvCreateTask(TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters, volatile UBaseType_t uxPriority, BaseType_t xCoreID, BaseType_t xNeedsStack)
+{
+    // volatile as getcontext() returns twice
+    simTCB_t * volatile pxTCB = calloc(1, sizeof(simTCB_t));
+
+    if (pxTCB == NULL)
+    {
+        return NULL;
+    }
+
+    if (xNeedsStack == pdTRUE)
+    {
+        pxTCB->pvStack = malloc(SIM_TASK_STACK_SIZE);
+        if (pxTCB->pvStack == NULL)
+        {
+            free(pxTCB);
+            return NULL;
+        }
+        getcontext(&pxTCB->xStartContext);
+        pxTCB->xStartContext.uc_stack.ss_sp = pxTCB->pvStack;
+        pxTCB->xStartContext.uc_stack.ss_size = SIM_TASK_STACK_SIZE;
+        pxTCB->xStartContext.uc_link = NULL;
+        makecontext(&pxTCB->xStartContext, prvTaskEntry, 0);
+    }
+
+    if (uxPriority >= configMAX_PRIORITIES)
+    {
+        uxPriority = configMAX_PRIORITIES - 1;
+    }
+
+    strncpy(pxTCB->pcTaskName, pcName, configMAX_TASK_NAME_LEN - 1);
+    pxTCB->uxTCBNumber = uxTaskNumber++;
+    pxTCB->uxPriority = uxPriority;
+    pxTCB->xCoreID = xCoreID;
+    pxTCB->pxTaskCode = pxTaskCode;
+    pxTCB->pvParameters = pvParameters;
+    vListInitialiseItem(&pxTCB->xStateListItem);
+    listSET_LIST_ITEM_OWNER(&pxTCB->xStateListItem, pxTCB);
+
+    pxTCB->pxNextAllocated = pxAllocatedTCBs;
+    pxAllocatedTCBs = pxTCB;
+
+    prvAddTaskToReadyList(pxTCB);
+    return pxTCB;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, const BaseType_t xCoreID)
+{
+    simTCB_t * pxTCB;
+    (void)usStackDepth;
+
+    pxTCB = prvCreateTask(pxTaskCode, pcName, pvParameters, uxPriority, xCoreID, pdTRUE);
+    if (pxTCB == NULL)
+    {
+        return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+    if (pxCreatedTask != NULL)
+    {
+        *pxCreatedTask = pxTCB;
+    }
+
+    if (pxCurrentTCB[xCurrentCore] != NULL)
+    {
+        (void)prvYieldForTask(pxTCB, pdFALSE);
+        prvYieldIfPending();
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    return xTaskCreatePinnedToCore(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, tskNO_AFFINITY);
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer)
+{
+    TaskHandle_t xHandle = NULL;
+
+    configASSERT((puxStackBuffer != NULL) && (pxTaskBuffer != NULL));
+    (void)xTaskCreatePinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xHandle, tskNO_AFFINITY);
+    return xHandle;
+}
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer, const BaseType_t xCoreID)
+{
+    TaskHandle_t xHandle = NULL;
+
+    configASSERT((puxStackBuffer != NULL) && (pxTaskBuffer != NULL));
+    (void)xTaskCreatePinnedToCore(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xHandle, xCoreID);
+    return xHandle;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete)
+{
+    simTCB_t * pxTCB = (xTaskToDelete == NULL) ? pxCurrentTCB[xCurrentCore] : xTaskToDelete;
+    BaseType_t xCore = prvRunningOnCore(pxTCB);
+
+    if (pxTCB->eState == simDELETED)
+    {
+        return;
+    }
+
+    prvRemoveFromReadyList(pxTCB);
+    prvDelayedRemove(pxTCB);
+    pxTCB->eState = simDELETED;
+
+    if (pxTCB == pxCurrentTCB[xCurrentCore])
+    {
+        // the stack is released by the kernel once it is no longer in use
+        prvYieldWithinAPI();
+        configASSERT(xInKernel == pdTRUE);
+    }
+    else
+    {
+        // a task current on another core is not executing, only its core has to select a new task
+        if (xCore >= 0)
+        {
+            xYieldPending[xCore] = pdTRUE;
+        }
+        free(pxTCB->pvStack);
+        pxTCB->pvStack = NULL;
+    }
+}
+// ******************************************************************* //
+
+// ************************ Task Control ***************************** //
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    if (xTicksToDelay > 0)
+    {
+        traceTASK_DELAY();
+        prvAddCurrentTaskToDelayedList(xTicksToDelay, simDELAYED);
+    }
+    prvYieldWithinAPI();
+}
+
+BaseType_t xTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement)
+{
+    TickType_t xTimeToWake;
+    BaseType_t xShouldDelay = pdFALSE;
+    const TickType_t xConstTickCount = xTickCount;
+
+    xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+    if (xConstTickCount < *pxPreviousWakeTime)
+    {
+        if ((xTimeToWake < *pxPreviousWakeTime) && (xTimeToWake > xConstTickCount))
+        {
+            xShouldDelay = pdTRUE;
+        }
+    }
+    else
+    {
+        if ((xTimeToWake < *pxPreviousWakeTime) || (xTimeToWake > xConstTickCount))
+        {
+            xShouldDelay = pdTRUE;
+        }
+    }
+
+    *pxPreviousWakeTime = xTimeToWake;
+
+    if (xShouldDelay == pdTRUE)
+    {
+        traceTASK_DELAY_UNTIL(xTimeToWake);
+        prvAddCurrentTaskToDelayedList(xTimeToWake - xConstTickCount, simDELAYED);
+    }
+    prvYieldWithinAPI();
+    return xShouldDelay;
+}
+
+void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement)
+{
+    (void) xTaskDelayUntil(pxPreviousWakeTime, xTimeIncrement);
+}
+
+void vTaskSuspend(TaskHandle_t xTaskToSuspend)
+{
+    simTCB_t * pxTCB = (xTaskToSuspend == NULL) ? pxCurrentTCB[xCurrentCore] : xTaskToSuspend;
+    BaseType_t xCore = prvRunningOnCore(pxTCB);
+
+    traceTASK_SUSPEND(pxTCB);
+
+    prvRemoveFromReadyList(pxTCB);
+    prvDelayedRemove(pxTCB);
+    pxTCB->eState = simSUSPENDED;
+
+    if (pxTCB == pxCurrentTCB[xCurrentCore])
+    {
+        prvYieldWithinAPI();
+    }
+    else
+    {
+        if (xCore >= 0)
+        {
+            xYieldPending[xCore] = pdTRUE;
+        }
+        prvYieldIfPending();
+    }
+}
+
+void vTaskResume(TaskHandle_t xTaskToResume)
+{
+    simTCB_t * pxTCB = xTaskToResume;
+
+    if ((pxTCB != NULL) && (pxTCB != pxCurrentTCB[xCurrentCore]) && (pxTCB->eState == simSUSPENDED))
+    {
+        traceTASK_RESUME(pxTCB);
+        prvAddTaskToReadyList(pxTCB);
+        (void)prvYieldForTask(pxTCB, pdTRUE);
+    }
+    prvYieldIfPending();
+}
+
+BaseType_t xTaskResumeFromISR(TaskHandle_t xTaskToResume)
+{
+    simTCB_t * pxTCB = xTaskToResume;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    if ((pxTCB != NULL) && (pxTCB->eState == simSUSPENDED))
+    {
+        traceTASK_RESUME_FROM_ISR(pxTCB);
+        prvAddTaskToReadyList(pxTCB);
+        if (prvYieldForTask(pxTCB, pdTRUE) == xCurrentCore)
+        {
+            xYieldRequired = pdTRUE;
+        }
+    }
+    return xYieldRequired;
+}
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority)
+{
+    simTCB_t * pxTCB = (xTask == NULL) ? pxCurrentTCB[xCurrentCore] : xTask;
+    UBaseType_t uxOldPriority = pxTCB->uxPriority;
+    BaseType_t xCore = prvRunningOnCore(pxTCB);
+
+    if (uxNewPriority >= configMAX_PRIORITIES)
+    {
+        uxNewPriority = configMAX_PRIORITIES - 1;
+    }
+
+    if (uxNewPriority != uxOldPriority)
+    {
+        pxTCB->uxPriority = uxNewPriority;
+
+        if (uxNewPriority > uxOldPriority)
+        {
+            // as in tasks.c the yield does not depend on the task being ready
+            (void)prvYieldForTask(pxTCB, pdTRUE);
+        }
+        else if (xCore >= 0)
+        {
+            xYieldPending[xCore] = pdTRUE;
+        }
+
+        // as in tasks.c a ready task is re-added to the ready lists, which emits traceMOVED_TASK_TO_READY_STATE
+        if (listIS_CONTAINED_WITHIN(&pxReadyTasksLists[uxOldPriority], &pxTCB->xStateListItem) == pdTRUE)
+        {
+            uxListRemove(&pxTCB->xStateListItem);
+            prvAddTaskToReadyList(pxTCB);
+        }
+    }
+    prvYieldIfPending();
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask)
+{
+    simTCB_t * pxTCB = (xTask == NULL) ? pxCurrentTCB[xCurrentCore] : xTask;
+    return pxTCB->uxPriority;
+}
+
+void vTaskYield(void)
+{
+    prvYieldWithinAPI();
+}
+
+void vTaskSuspendAll(void)
+{
+    // tasks only advance time through simConsume(), so holding back pended yields is all that is needed
+    uxSchedulerSuspended++;
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    BaseType_t xAlreadyYielded = pdFALSE;
+
+    configASSERT(uxSchedulerSuspended > 0);
+    uxSchedulerSuspended--;
+    if ((uxSchedulerSuspended == 0) && (xYieldPending[xCurrentCore] == pdTRUE))
+    {
+        xAlreadyYielded = pdTRUE;
+        prvYieldIfPending();
+    }
+    return xAlreadyYielded;
+}
+// ******************************************************************* //
+
+// ************************ Task Utilities *************************** //
+TickType_t xTaskGetTickCount(void)
+{
+    return xTickCount;
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return xTickCount;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return pxCurrentTCB[xCurrentCore];
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t xCoreID)
+{
+    return pxCurrentTCB[xCoreID];
+}
+
+TaskHandle_t xTaskGetIdleTaskHandle(void)
+{
+    return pxIdleTCB[xCurrentCore];
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t xCoreID)
+{
+    return pxIdleTCB[xCoreID];
+}
+
+char * pcTaskGetName(TaskHandle_t xTaskToQuery)
+{
+    simTCB_t * pxTCB = (xTaskToQuery == NULL) ? pxCurrentTCB[xCurrentCore] : xTaskToQuery;
+    return pxTCB->pcTaskName;
+}
+
+void vTaskSetTaskNumber(TaskHandle_t xTask, const UBaseType_t uxHandle)
+{
+    if (xTask != NULL)
+    {
+        xTask->uxTaskNumber = uxHandle;
+    }
+}
+
+UBaseType_t uxTaskGetTaskNumber(TaskHandle_t xTask)
+{
+    return (xTask != NULL) ? xTask->uxTaskNumber : 0;
+}
+
+void vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void * pvValue)
+{
+    simTCB_t * pxTCB = (xTaskToSet == NULL) ? pxCurrentTCB[xCurrentCore] : xTaskToSet;
+    pxTCB->pvThreadLocalStoragePointers[xIndex] = pvValue;
+}
+
+void * pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex)
+{
+    simTCB_t * pxTCB = (xTaskToQuery == NULL) ? pxCurrentTCB[xCurrentCore] : xTaskToQuery;
+    return pxTCB->pvThreadLocalStoragePointers[xIndex];
+}
+// ******************************************************************* //
+
+// ************************ Notifications **************************** //
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t * pulNotificationValue, TickType_t xTicksToWait)
+{
+    simTCB_t * pxTCB = pxCurrentTCB[xCurrentCore];
+    BaseType_t xReturn;
+
+    if (pxTCB->xNotifyPending == pdFALSE)
+    {
+        pxTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+        if (xTicksToWait > 0)
+        {
+            prvAddCurrentTaskToDelayedList(xTicksToWait, simNOTIFY_WAIT);
+            prvYieldWithinAPI();
+        }
+    }
+
+    if (pulNotificationValue != NULL)
+    {
+        *pulNotificationValue = pxTCB->ulNotifiedValue;
+    }
+
+    if (pxTCB->xNotifyPending == pdFALSE)
+    {
+        xReturn = pdFALSE;
+    }
+    else
+    {
+        pxTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+        pxTCB->xStats.ulNotifyWaits++;
+        xReturn = pdTRUE;
+    }
+    pxTCB->xNotifyPending = pdFALSE;
+
+    return xReturn;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t * pxHigherPriorityTaskWoken)
+{
+    simTCB_t * pxTCB = xTaskToNotify;
+
+    switch (eAction)
+    {
+        case eSetBits:
+            pxTCB->ulNotifiedValue |= ulValue;
+            break;
+        case eIncrement:
+            pxTCB->ulNotifiedValue++;
+            break;
+        case eSetValueWithOverwrite:
+            pxTCB->ulNotifiedValue = ulValue;
+            break;
+        case eSetValueWithoutOverwrite:
+            if (pxTCB->xNotifyPending == pdFALSE)
+            {
+                pxTCB->ulNotifiedValue = ulValue;
+            }
+            break;
+        default:
+            break;
+    }
+    pxTCB->xNotifyPending = pdTRUE;
+
+    if (pxTCB->eState == simNOTIFY_WAIT)
+    {
+        prvDelayedRemove(pxTCB);
+        prvAddTaskToReadyList(pxTCB);
+        // a task woken for another core makes that core yield directly
+        if ((prvYieldForTask(pxTCB, pdFALSE) == xCurrentCore) && (pxHigherPriorityTaskWoken != NULL))
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction)
+{
+    BaseType_t xReturn = xTaskNotifyFromISR(xTaskToNotify, ulValue, eAction, NULL);
+    prvYieldIfPending();
+    return xReturn;
+}
+// ******************************************************************* //
+
+// ************************ Timer Service **************************** //
+#if configUSE_TIMERS == 1
+static void prvTimerTask(void * pvParameters)
+{
+    simPendedCall_t xCall;
+    (void)pvParameters;
+
+    for (;;)
+    {
+        while (uxNumOfPendedCalls > 0)
+        {
+            xCall = xPendedCalls[uxPendedCallsHead];
+            uxPendedCallsHead = (uxPendedCallsHead + 1) % configTIMER_QUEUE_LENGTH;
+            uxNumOfPendedCalls--;
+            xCall.xFunction(xCall.pvParameter1, xCall.ulParameter2);
+        }
+        (void)xTaskNotifyWait(0x00, 0x00, NULL, portMAX_DELAY);
+    }
+}
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t xFunctionToPend, void * pvParameter1, uint32_t ulParameter2, BaseType_t * pxHigherPriorityTaskWoken)
+{
+    simPendedCall_t * pxCall;
+
+    // the timer command queue is full
+    if (uxNumOfPendedCalls == configTIMER_QUEUE_LENGTH)
+    {
+        return pdFAIL;
+    }
+    pxCall = &xPendedCalls[(uxPendedCallsHead + uxNumOfPendedCalls) % configTIMER_QUEUE_LENGTH];
+    pxCall->xFunction = xFunctionToPend;
+    pxCall->pvParameter1 = pvParameter1;
+    pxCall->ulParameter2 = ulParameter2;
+    uxNumOfPendedCalls++;
+    return xTaskNotifyFromISR(pxTimerTCB, 0, eNoAction, pxHigherPriorityTaskWoken);
+}
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t xFunctionToPend, void * pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait)
+{
+    BaseType_t xReturn = xTimerPendFunctionCallFromISR(xFunctionToPend, pvParameter1, ulParameter2, NULL);
+    (void)xTicksToWait;
+    prvYieldIfPending();
+    return xReturn;
+}
+#endif
+// ******************************************************************* //
+
+// **************************** Port ********************************* //
+void simYieldFromISR(BaseType_t xSwitchRequired)
+{
+    // only pend the yield, hooks run inside kernel calls which switch once they complete
+    if (xSwitchRequired != pdFALSE)
+    {
+        xYieldPending[xCurrentCore] = pdTRUE;
+    }
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+    return xCurrentCore;
+}
+
+void * pvPortMalloc(size_t xSize)
+{
+    return malloc(xSize);
+}
+
+void vPortFree(void * pv)
+{
+    free(pv);
+}
+
+void simAssertFailed(const char * pcFile, int iLine, const char * pcExpr)
+{
+    fprintf(stderr, "[SIM] Assertion failed at %s:%d: %s (tick %lu)\n", pcFile, iLine, pcExpr, (unsigned long)xTickCount);
+    abort();
+}
+
+int simLibPrintf(const char * pcFormat, ...)
+{
+    va_list xArgs;
+    int iWritten = 0;
+
+    if (xLibraryOutput == pdTRUE)
+    {
+        va_start(xArgs, pcFormat);
+        iWritten = vprintf(pcFormat, xArgs);
+        va_end(xArgs);
+    }
+    return iWritten;
+}
+// ******************************************************************* //
+
+// ***************************** esp_timer *************************** //
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)xTickCount * (1000000 / configTICK_RATE_HZ);
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t * create_args, esp_timer_handle_t * out_handle)
+{
+    struct esp_timer * pxTimer = calloc(1, sizeof(struct esp_timer));
+
+    if (pxTimer == NULL)
+    {
+        return ESP_FAIL;
+    }
+    pxTimer->callback = create_args->callback;
+    pxTimer->arg = create_args->arg;
+    pxTimer->pxNext = pxTimers;
+    pxTimers = pxTimer;
+    *out_handle = pxTimer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    timer->llExpiryTime = esp_timer_get_time() + (int64_t)timeout_us;
+    timer->xArmed = pdTRUE;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    timer->xArmed = pdFALSE;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    struct esp_timer ** ppxTimer;
+
+    for (ppxTimer = &pxTimers; *ppxTimer != NULL; ppxTimer = &(*ppxTimer)->pxNext)
+    {
+        if (*ppxTimer == timer)
+        {
+            *ppxTimer = timer->pxNext;
+            free(timer);
+            return ESP_OK;
+        }
+    }
+    return ESP_FAIL;
+}
+// ******************************************************************* //
+
+// *********************** Simulator Control ************************* //
+void simInit(void)
+{
+    for (UBaseType_t uxPriority = 0; uxPriority < configMAX_PRIORITIES; uxPriority++)
+    {
+        vListInitialise(&pxReadyTasksLists[uxPriority]);
+    }
+    // the idle tasks never execute code, the kernel advances time while they are selected
+    pxIdleTCB[0] = prvCreateTask(NULL, "IDLE", NULL, tskIDLE_PRIORITY, 0, pdFALSE);
+    for (BaseType_t xCore = 1; xCore < configNUMBER_OF_CORES; xCore++)
+    {
+        char pcName[configMAX_TASK_NAME_LEN];
+        snprintf(pcName, sizeof(pcName), "IDLE%d", xCore);
+        pxIdleTCB[xCore] = prvCreateTask(NULL, pcName, NULL, tskIDLE_PRIORITY, xCore, pdFALSE);
+    }
+    #if configUSE_TIMERS == 1
+    pxTimerTCB = prvCreateTask(prvTimerTask, "Tmr Svc", NULL, configTIMER_TASK_PRIORITY, 0, pdTRUE);
+    #endif
+}
+
+void simRun(TickType_t xTicksToRun)
+{
+    const TickType_t xEndTick = xTickCount + xTicksToRun;
+    simTCB_t * pxTCB;
+    BaseType_t xProgress;
+
+    xSimRunning = pdTRUE;
+    while ((xSimRunning == pdTRUE) && (xTickCount < xEndTick))
+    {
+        // run every core until its task consumes time or the core idles, a task may make another core yield
+        do
+        {
+            xProgress = pdFALSE;
+            for (BaseType_t xCore = 0; (xCore < configNUMBER_OF_CORES) && (xSimRunning == pdTRUE); xCore++)
+            {
+                xCurrentCore = xCore;
+                if ((pxCurrentTCB[xCore] == NULL) || (xYieldPending[xCore] == pdTRUE) || (pxCurrentTCB[xCore]->eState != simREADY))
+                {
+                    prvSwitchContext(xCore);
+                }
+
+                pxTCB = pxCurrentTCB[xCore];
+                if ((pxTCB != pxIdleTCB[xCore]) && (pxTCB->xWorkRemaining == 0))
+                {
+                    prvResumeTask(pxTCB);
+                    if ((pxTCB->eState == simDELETED) && (pxTCB->pvStack != NULL))
+                    {
+                        free(pxTCB->pvStack);
+                        pxTCB->pvStack = NULL;
+                    }
+                    xProgress = pdTRUE;
+                }
+            }
+        } while ((xProgress == pdTRUE) && (xSimRunning == pdTRUE));
+
+        if (xSimRunning == pdFALSE)
+        {
+            break;
+        }
+
+        for (BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++)
+        {
+            pxTCB = pxCurrentTCB[xCore];
+            if (pxTCB != pxIdleTCB[xCore])
+            {
+                pxTCB->xWorkRemaining--;
+                pxTCB->xStats.ulRunTicks++;
+            }
+        }
+        prvIncrementTick();
+    }
+    xSimRunning = pdFALSE;
+}
+
+void simStop(void)
+{
+    xSimRunning = pdFALSE;
+}
+
+void simShutdown(void)
+{
+    simTCB_t * pxTCB;
+
+    while (pxAllocatedTCBs != NULL)
+    {
+        pxTCB = pxAllocatedTCBs;
+        pxAllocatedTCBs = pxTCB->pxNextAllocated;
+        free(pxTCB->pvStack);
+        free(pxTCB);
+    }
+    free(pxDelayedTasks);
+    pxDelayedTasks = NULL;
+    uxDelayedCount = 0;
+    uxDelayedCapacity = 0;
+}
+
+void simConsume(TickType_t xTicks)
+{
+    if (xTicks == 0)
+    {
+        return;
+    }
+    pxCurrentTCB[xCurrentCore]->xWorkRemaining = xTicks;
+    prvSwitchToKernel();
+}
+
+void simSetSwitchHook(simSwitchHook_t pxHook)
+{
+    pxSwitchHook = pxHook;
+}
+
+void simSetTickHook(simTickHook_t pxHook)
+{
+    pxTickHook = pxHook;
+}
+
+void simSetLibraryOutput(BaseType_t xEnable)
+{
+    xLibraryOutput = xEnable;
+}
+
+TaskHandle_t simFindTask(const char * pcName)
+{
+    simTCB_t * pxTCB;
+
+    // a deleted task is not found, like in FreeRTOS its handle is no longer valid
+    for (pxTCB = pxAllocatedTCBs; pxTCB != NULL; pxTCB = pxTCB->pxNextAllocated)
+    {
+        if ((pxTCB->eState != simDELETED) && (strncmp(pxTCB->pcTaskName, pcName, configMAX_TASK_NAME_LEN - 1) == 0))
+        {
+            return pxTCB;
+        }
+    }
+    return NULL;
+}
+
+void simGetTaskStats(TaskHandle_t xTask, simTaskStats_t * pxStats)
+{
+    *pxStats = xTask->xStats;
+}
+
+uint64_t simGetContextSwitches(void)
+{
+    return ulContextSwitches;
+}
+// ******************************************************************* //
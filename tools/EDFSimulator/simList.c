@@ -0,0 +1,75 @@
+// ************************* File Includes *************************** //
+#include "freertos/FreeRTOS.h"
+#include "freertos/list.h"
+// ******************************************************************* //
+
+void vListInitialise(List_t * const pxList)
+{
+    pxList->pxIndex = (ListItem_t *)&(pxList->xListEnd);
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = (ListItem_t *)&(pxList->xListEnd);
+    pxList->xListEnd.pxPrevious = (ListItem_t *)&(pxList->xListEnd);
+    pxList->uxNumberOfItems = 0;
+}
+
+void vListInitialiseItem(ListItem_t * const pxItem)
+{
+    pxItem->pxContainer = NULL;
+}
+
+void vListInsertEnd(List_t * const pxList, ListItem_t * const pxNewListItem)
+{
+    // insert so that the item is the last one returned by listGET_OWNER_OF_NEXT_ENTRY
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+
+    pxNewListItem->pxContainer = pxList;
+    pxList->uxNumberOfItems++;
+}
+
+void vListInsert(List_t * const pxList, ListItem_t * const pxNewListItem)
+{
+    ListItem_t * pxIterator;
+    const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+    if (xValueOfInsertion == portMAX_DELAY)
+    {
+        pxIterator = pxList->xListEnd.pxPrevious;
+    }
+    else
+    {
+        for (pxIterator = (ListItem_t *)&(pxList->xListEnd); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext)
+        {
+        }
+    }
+
+    pxNewListItem->pxNext = pxIterator->pxNext;
+    pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+    pxNewListItem->pxPrevious = pxIterator;
+    pxIterator->pxNext = pxNewListItem;
+
+    pxNewListItem->pxContainer = pxList;
+    pxList->uxNumberOfItems++;
+}
+
+UBaseType_t uxListRemove(ListItem_t * const pxItemToRemove)
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if (pxList->pxIndex == pxItemToRemove)
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    pxList->uxNumberOfItems--;
+
+    return pxList->uxNumberOfItems;
+}
@@ -0,0 +1,1015 @@
+/*
+                    Host Side Discrete-Event Simulator for the Extended EDF Library
+
+    Description:
+
+        Runs the unmodified scheduling code of ExtEDFlib.c on the simulated FreeRTOS kernel in simKernel.c. The task
+        set is created through the public library API in the same way as main/EDF_implementation_test.c does on the
+        ESP32, every job then consumes its execution time in virtual ticks. At the end of the run the simulator prints
+        the number of deadline misses, job preemptions and scheduler invocations (of all cores when built with
+        EDF_SIM_NUM_OF_CORES > 1, which also counts the jobs that continued on another core). With -v the host time
+        of the scheduler passes, from the first wake to the end of the pass, is printed as well. Inline dispatch
+        reports the passes made by the tasks apart from the ones deferred to the timer service task.
+
+    Usage:
+
+        EDFSimulator [-f taskset.txt] [-r N:U[:seed[:Tmin:Tmax]]] [-t ticks] [-s] [-v] [-l] [-o trace.bin]
+        EDFSimulator -a N[:seed]
+
+            -f  read the task set from a file (see tasksets/EDF_implementation_test.txt for the format,
+                tasksets/mode_change.txt for periodic tasks added and removed while the scheduler runs and
+                tasksets/job_policies.txt for the overrun and deadline miss policies, tasksets/srp.txt for
+                critical sections, which are locked with EDFLockResource() when built with EDF_SIM_SRP=1)
+            -r  generate N periodic tasks with total utilization U (UUniFast, periods log-uniform between Tmin and Tmax,
+                default 10 and 1000 ticks). Execution times are rounded down to whole ticks but at least 1, so
+                for large N the periods have to be long enough to reach U, the generated utilization is printed
+            -t  number of ticks to simulate (default 10000)
+            -s  submit the aperiodic tasks at their arrival time from a simulated interrupt with
+                EDFSubmitAperiodicJobFromISR() instead of declaring them before the start
+            -v  print per task statistics and the host time of the scheduler passes
+            -l  print the output of the library itself
+            -o  write the binary trace of the library (EDFTrace.h) to a file, drained on every tick
+            -a  check the admission test of EDFAdmission.h against a brute-force demand scan on N random task sets
+                with constrained deadlines (periods divide 720, utilization up to 1.05), tasks are added one by one
+*/
+
+// ************************* File Includes *************************** //
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "ExtEDFlib.h"
+#include "simKernel.h"
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef struct simTaskSpec
+{
+    char taskName[configMAX_TASK_NAME_LEN];
+    BaseType_t isPeriodic;
+    TickType_t period;                  // ms, or arrival time for aperiodic tasks
+    TickType_t relDeadline;             // ms
+    TickType_t phase;                   // ms
+    TickType_t WCET;                    // ticks, passed to the library
+    TickType_t execTime;                // ticks, actually consumed by every job
+    TickType_t addTime;                 // ms, added with EDFAddPeriodicTask at this time, 0 to create it before the start
+    TickType_t removeTime;              // ms, removed with EDFRemovePeriodicTask at this time, 0 to keep it
+    EDFTaskPolicy_t policy;
+    BaseType_t csResource;              // resource of the critical section of every job, -1 for none
+    TickType_t csOffset;                // ticks into the job the critical section starts at
+    TickType_t csLength;                // ticks
+    TaskHandle_t handle;
+
+    // statistics
+    BaseType_t jobActive;
+    uint64_t jobs;
+    uint64_t deadlineMisses;
+    uint64_t preemptions;
+    uint64_t migrations;
+    BaseType_t lastCore;
+    TickType_t maxResponseTime;
+    BaseType_t submitted;
+    #if USE_EDF_TASK_STATS == 1
+    EDFTaskStats_t libStats;            // of the library, taken before the tasks are deleted or removed
+    #endif
+} simTaskSpec_t;
+
+#define SIM_MAX_RESOURCES               4
+
+typedef struct simResource
+{
+    #if USE_SRP == 1
+    EDFResource_t resource;
+    #endif
+    TickType_t ceiling;                 // ms, shortest relative deadline of the tasks that lock it
+    BaseType_t users;                   // jobs in the critical section, more than one is an overlap
+} simResource_t;
+
+typedef struct simLatency
+{
+    uint64_t samples;
+    uint64_t sumNs;
+    uint64_t maxNs;
+} simLatency_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+static simTaskSpec_t * taskSpecs = NULL;
+static BaseType_t numOfTaskSpecs = 0;
+static TickType_t simTicks = 10000;
+static simTaskSpec_t * lastJob[configNUMBER_OF_CORES] = {NULL};
+static simTaskSpec_t * serverJob = NULL;
+static TickType_t sysStartTime = 0;
+static uint64_t aperiodicResponseSum = 0;
+static uint64_t totalPreemptions = 0;
+static uint64_t totalMigrations = 0;
+// scheduler passes of all cores, counted by the traceEDF_SCHEDULER_DONE hook
+static uint64_t schedPasses = 0;
+// host time from the first wake of a pass (traceEDF_SCHEDULER_WAKE) to its end, in ns. Wakes folded into a pending
+// pass keep the time of the first one, as in tools/EDFPosix/EDFSchedBench.c. Only timed with -v, the clock reads
+// slow the simulation down noticeably
+static BaseType_t timePasses = pdFALSE;
+static struct timespec schedWakeTime;
+static BaseType_t schedWakePending = pdFALSE;
+static simLatency_t schedLatency = {0};
+#if USE_EDF_INLINE_DISPATCH == 1
+// passes deferred to the timer service task, schedLatency holds the ones the tasks made inline
+static simLatency_t deferredLatency = {0};
+static TaskHandle_t timerTaskHandle = NULL;
+#endif
+static BaseType_t submitAtRuntime = pdFALSE;
+static BaseType_t schedulingStarted = pdFALSE;
+static uint64_t rejectedSubmissions = 0;
+static uint64_t addedTasks = 0;
+static uint64_t rejectedTasks = 0;
+static uint64_t removedTasks = 0;
+static BaseType_t modeChanges = pdFALSE;
+static simResource_t resources[SIM_MAX_RESOURCES];
+static uint64_t criticalSections = 0;
+static uint64_t overlappingSections = 0;
+static FILE * traceFile = NULL;
+// wall clock time the scheduling started at, after the tasks were created and admitted
+static struct timespec schedulingStartTime;
+// *********************************************************************** //
+
+// ****************** Private Function Declarations ***************** //
+static void simJob(void * pvParameters);
+static void simSwitchHook(TaskHandle_t xTaskOut, TaskHandle_t xTaskIn);
+static void simTickHook(void);
+static void simModeChanges(void);
+static void simAppMain(void * pvParameters);
+static simTaskSpec_t * addTaskSpec(void);
+static BaseType_t loadTaskSet(const char * fileName);
+static void generateTaskSet(int numOfTasks, double utilization, unsigned int seed, double minPeriod, double maxPeriod);
+static void printResults(double setupTime, double wallTime, BaseType_t verbose);
+static void printLatency(const char * pcName, const simLatency_t * latency);
+static EDFJobPolicy_t parsePolicy(const char * line, const char * key);
+static void simCriticalSection(simTaskSpec_t * spec);
+static void initResources(void);
+#if USE_EDF_TRACE == 1
+static void simTraceSink(const void * pvData, size_t xLength);
+#endif
+static BaseType_t bruteForceDemand(const TickType_t * WCETs, const TickType_t * periods, const TickType_t * relDeadlines, int numOfTasks, TickType_t * slack);
+static int checkAdmission(int numOfSets, unsigned int seed);
+// ******************************************************************* //
+
+static void simJob(void * pvParameters)
+{
+    simTaskSpec_t * spec = (simTaskSpec_t *)pvParameters;
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(NULL, LOCAL_STORAGE_INDEX);
+    TickType_t releaseTime = xTaskGetTickCount();
+    TickType_t deadline = portMAX_DELAY;
+    TickType_t completionTime;
+
+    if (spec->isPeriodic == pdTRUE)
+    {
+        // deadline of the job as seen by the library when it was released
+        releaseTime = xTCB->relArrivalTime;
+        deadline = xTCB->relArrivalTime + xTCB->relDeadline;
+    }
+    else
+    {
+        // aperiodic jobs are run by the server (which has a TCB of its own with the CBS), response from the arrival
+        releaseTime = sysStartTime + spec->period / portTICK_PERIOD_MS;
+        serverJob = spec;
+    }
+
+    if (spec->jobActive == pdTRUE)
+    {
+        // the previous job was aborted by its overrun or deadline miss policy and never completed
+        spec->deadlineMisses++;
+    }
+    spec->jobActive = pdTRUE;
+    if ((lastJob[xPortGetCoreID()] != NULL) && (lastJob[xPortGetCoreID()] != spec) && (lastJob[xPortGetCoreID()]->jobActive == pdTRUE) &&
+        (lastJob[xPortGetCoreID()]->lastCore == xPortGetCoreID()))
+    {
+        // the task got the core without a switch to it, at its release with USE_EDF_INLINE_DISPATCH
+        lastJob[xPortGetCoreID()]->preemptions++;
+        totalPreemptions++;
+    }
+    lastJob[xPortGetCoreID()] = spec;
+    if (spec->csResource >= 0)
+    {
+        simConsume(spec->csOffset);
+        simCriticalSection(spec);
+        simConsume(spec->execTime - spec->csOffset - spec->csLength);
+    }
+    else
+    {
+        simConsume(spec->execTime);
+    }
+    spec->jobActive = pdFALSE;
+
+    completionTime = xTaskGetTickCount();
+    spec->jobs++;
+    if (completionTime > deadline)
+    {
+        spec->deadlineMisses++;
+    }
+    if ((completionTime - releaseTime) > spec->maxResponseTime)
+    {
+        spec->maxResponseTime = completionTime - releaseTime;
+    }
+    if (spec->isPeriodic == pdFALSE)
+    {
+        aperiodicResponseSum += completionTime - releaseTime;
+    }
+}
+
+static void simCriticalSection(simTaskSpec_t * spec)
+{
+    // without a lock every job that enters while another one is inside overlaps with it, with SRP none may
+    simResource_t * res = &resources[spec->csResource];
+
+    #if USE_SRP == 1
+    EDFLockResource(&res->resource);
+    #endif
+    criticalSections++;
+    if (res->users++ > 0)
+    {
+        overlappingSections++;
+    }
+    simConsume(spec->csLength);
+    res->users--;
+    #if USE_SRP == 1
+    EDFUnlockResource(&res->resource);
+    #endif
+}
+
+static void initResources(void)
+{
+    // the ceiling of a resource is the shortest relative deadline of the tasks that lock it
+    for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+    {
+        simTaskSpec_t * spec = &taskSpecs[i];
+        if ((spec->csResource >= 0) && ((resources[spec->csResource].ceiling == 0) || (spec->relDeadline < resources[spec->csResource].ceiling)))
+        {
+            resources[spec->csResource].ceiling = spec->relDeadline;
+        }
+    }
+    #if USE_SRP == 1
+    for (BaseType_t i = 0; i < SIM_MAX_RESOURCES; i++)
+    {
+        EDFInitResource(&resources[i].resource, resources[i].ceiling);
+    }
+    #endif
+}
+
+static void simSwitchHook(TaskHandle_t xTaskOut, TaskHandle_t xTaskIn)
+{
+    simTaskSpec_t * spec = NULL;
+    extTCB_t * xTCB = (extTCB_t *)pvTaskGetThreadLocalStoragePointer(xTaskIn, LOCAL_STORAGE_INDEX);
+    BaseType_t xCore = xPortGetCoreID();
+    (void)xTaskOut;
+
+    // the server runs the aperiodic jobs, with the CBS it also has an extended TCB
+    if (strcmp(pcTaskGetName(xTaskIn), "Aperiodic Server") == 0)
+    {
+        spec = serverJob;
+    }
+    else if (xTCB != NULL)
+    {
+        spec = (simTaskSpec_t *)xTCB->instanceParams;
+    }
+    #if USE_EDF_INLINE_DISPATCH == 1
+    if ((xTCB != NULL) && (xTCB->xPriority == SCHED_PRIO))
+    {
+        // a released task makes its own decision first, its job gets the core only if it wins (counted in simJob)
+        spec = NULL;
+    }
+    #endif
+
+    // a job migrates when it continues on another core than the one it was preempted on
+    if (spec != NULL)
+    {
+        if ((spec->jobActive == pdTRUE) && (spec->lastCore != xCore))
+        {
+            spec->migrations++;
+            totalMigrations++;
+        }
+        spec->lastCore = xCore;
+    }
+
+    // a job is preempted when another application job gets its core before it completes, unless it already continued elsewhere
+    if ((spec != NULL) && (spec != lastJob[xCore]))
+    {
+        if ((lastJob[xCore] != NULL) && (lastJob[xCore]->jobActive == pdTRUE) && (lastJob[xCore]->lastCore == xCore))
+        {
+            lastJob[xCore]->preemptions++;
+            totalPreemptions++;
+        }
+        lastJob[xCore] = spec;
+    }
+}
+
+static void simTickHook(void)
+{
+    // the interrupt submits every aperiodic job in the tick it arrives in, a rejected job is retried on the next tick
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    #if USE_EDF_TRACE == 1
+    if (traceFile != NULL)
+    {
+        // the simulator has no drain task, the buffers of the last tick go to the file
+        vEDFTraceDrain();
+    }
+    #endif
+
+    if ((submitAtRuntime == pdFALSE) || (schedulingStarted == pdFALSE))
+    {
+        return;
+    }
+
+    for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+    {
+        simTaskSpec_t * spec = &taskSpecs[i];
+        if ((spec->isPeriodic == pdTRUE) || (spec->submitted == pdTRUE) || (xTaskGetTickCountFromISR() < sysStartTime + spec->period / portTICK_PERIOD_MS))
+        {
+            continue;
+        }
+        if (EDFSubmitAperiodicJobFromISR(spec->taskName, simJob, (void *)spec, 2000, spec->WCET, &xHigherPriorityTaskWoken) == pdTRUE)
+        {
+            spec->submitted = pdTRUE;
+        }
+        else
+        {
+            rejectedSubmissions++;
+        }
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+#if USE_EDF_TRACE == 1
+static void simTraceSink(const void * pvData, size_t xLength)
+{
+    fwrite(pvData, 1, xLength, traceFile);
+}
+#endif
+
+static void simModeChanges(void)
+{
+    // the application task adds and removes periodic tasks at their times, in time order, like a mode manager would
+    TickType_t wakeTime = sysStartTime;
+    TickType_t nextTime;
+    BaseType_t found;
+
+    for (;;)
+    {
+        found = pdFALSE;
+        nextTime = portMAX_DELAY;
+        for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+        {
+            simTaskSpec_t * spec = &taskSpecs[i];
+            if ((spec->addTime > 0) && (spec->handle == NULL) && (sysStartTime + spec->addTime / portTICK_PERIOD_MS < nextTime))
+            {
+                nextTime = sysStartTime + spec->addTime / portTICK_PERIOD_MS;
+                found = pdTRUE;
+            }
+            if ((spec->removeTime > 0) && (sysStartTime + spec->removeTime / portTICK_PERIOD_MS < nextTime))
+            {
+                nextTime = sysStartTime + spec->removeTime / portTICK_PERIOD_MS;
+                found = pdTRUE;
+            }
+        }
+        if ((found == pdFALSE) || (nextTime >= sysStartTime + simTicks))
+        {
+            return;
+        }
+        if (nextTime > wakeTime)
+        {
+            vTaskDelayUntil(&wakeTime, nextTime - wakeTime);
+        }
+
+        for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+        {
+            simTaskSpec_t * spec = &taskSpecs[i];
+            if ((spec->removeTime > 0) && (sysStartTime + spec->removeTime / portTICK_PERIOD_MS == nextTime))
+            {
+                // tasks created before the start got their handle from EDFStartScheduling()
+                #if USE_EDF_TASK_STATS == 1
+                if ((spec->handle != NULL) && (simFindTask(spec->taskName) == spec->handle))
+                {
+                    // the extended TCB is freed with the task, a job still running is not counted
+                    (void)EDFGetTaskStats(spec->handle, &spec->libStats);
+                }
+                #endif
+                if ((spec->handle != NULL) && (EDFRemovePeriodicTask(spec->handle) == pdTRUE))
+                {
+                    removedTasks++;
+                }
+                spec->removeTime = 0;
+            }
+        }
+        for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+        {
+            simTaskSpec_t * spec = &taskSpecs[i];
+            if ((spec->addTime > 0) && (spec->handle == NULL) && (sysStartTime + spec->addTime / portTICK_PERIOD_MS == nextTime))
+            {
+                if (EDFAddPeriodicTaskWithPolicy(spec->taskName, 2000, simJob, spec->period, spec->relDeadline, &spec->handle, (void *)spec, spec->WCET, &spec->policy) == pdTRUE)
+                {
+                    addedTasks++;
+                }
+                else
+                {
+                    rejectedTasks++;
+                    spec->addTime = 0;
+                    spec->removeTime = 0;
+                }
+            }
+        }
+    }
+}
+
+static void simAppMain(void * pvParameters)
+{
+    TickType_t endTime;
+    (void)pvParameters;
+
+    EDFInit();
+    initResources();
+
+    for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+    {
+        simTaskSpec_t * spec = &taskSpecs[i];
+        if ((spec->isPeriodic == pdTRUE) && (spec->addTime > 0))
+        {
+            continue;
+        }
+        if (spec->isPeriodic == pdTRUE)
+        {
+            EDFCreatePeriodicTaskWithPolicy(spec->taskName, 2000, simJob, spec->period, spec->relDeadline, spec->phase, &spec->handle, (void *)spec, spec->WCET, &spec->policy);
+        }
+        else if (submitAtRuntime == pdFALSE)
+        {
+            EDFCreateAperiodicTask(spec->taskName, simJob, (void *)spec, 2000, spec->WCET, spec->period);
+        }
+    }
+
+    EDFStartScheduling();
+    // the generator task sets the system start time in this tick, once this task delays
+    sysStartTime = xTaskGetTickCount();
+    #if USE_EDF_INLINE_DISPATCH == 1
+    timerTaskHandle = simFindTask("Tmr Svc");
+    #endif
+    schedulingStarted = pdTRUE;
+    clock_gettime(CLOCK_MONOTONIC, &schedulingStartTime);
+    if (modeChanges == pdTRUE)
+    {
+        simModeChanges();
+    }
+    endTime = sysStartTime;
+    vTaskDelayUntil(&endTime, simTicks);
+
+    #if USE_EDF_TASK_STATS == 1
+    for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+    {
+        TaskHandle_t xTask = simFindTask(taskSpecs[i].taskName);
+        if ((taskSpecs[i].isPeriodic == pdTRUE) && (xTask != NULL))
+        {
+            (void)EDFGetTaskStats(xTask, &taskSpecs[i].libStats);
+        }
+    }
+    #endif
+    EDFDeleteAllTasks();
+    #if USE_EDF_TRACE == 1
+    if (traceFile != NULL)
+    {
+        vEDFTraceFlush();
+    }
+    #endif
+    simStop();
+    vTaskDelete(NULL);
+}
+
+static simTaskSpec_t * addTaskSpec(void)
+{
+    taskSpecs = realloc(taskSpecs, (numOfTaskSpecs + 1) * sizeof(simTaskSpec_t));
+    if (taskSpecs == NULL)
+    {
+        fprintf(stderr, "Could not allocate Memory......\n");
+        exit(1);
+    }
+    memset(&taskSpecs[numOfTaskSpecs], 0, sizeof(simTaskSpec_t));
+    taskSpecs[numOfTaskSpecs].csResource = -1;
+    return &taskSpecs[numOfTaskSpecs++];
+}
+
+static BaseType_t loadTaskSet(const char * fileName)
+{
+    char line[256];
+    char type[16];
+    char name[configMAX_TASK_NAME_LEN];
+    unsigned long v[7];
+    simTaskSpec_t * spec;
+    FILE * file = fopen(fileName, "r");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Could not open task set '%s'\n", fileName);
+        return pdFALSE;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if ((line[0] == '#') || (sscanf(line, "%15s", type) != 1))
+        {
+            continue;
+        }
+
+        v[5] = 0;
+        v[6] = 0;
+        if ((strcmp(type, "periodic") == 0) && (sscanf(line, "%*s %15s %lu %lu %lu %lu %lu %lu %lu", name, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6]) >= 6))
+        {
+            spec = addTaskSpec();
+            spec->addTime = v[5];
+            spec->removeTime = v[6];
+            if ((v[5] > 0) || (v[6] > 0))
+            {
+                modeChanges = pdTRUE;
+            }
+            spec->isPeriodic = pdTRUE;
+            spec->period = v[0];
+            spec->relDeadline = v[1];
+            spec->phase = v[2];
+            spec->WCET = v[3];
+            spec->execTime = v[4];
+            spec->policy.xOverrunPolicy = parsePolicy(line, "overrun=");
+            spec->policy.xMissPolicy = parsePolicy(line, "miss=");
+            if ((strstr(line, "mk=") != NULL) && (sscanf(strstr(line, "mk="), "mk=%lu:%lu", &v[0], &v[1]) == 2))
+            {
+                spec->policy.uxM = v[0];
+                spec->policy.uxK = v[1];
+            }
+            // optional "cs=<resource>:<offset>:<length>", a critical section within the execution time of every job
+            if ((strstr(line, "cs=") != NULL) && (sscanf(strstr(line, "cs="), "cs=%lu:%lu:%lu", &v[0], &v[1], &v[2]) == 3))
+            {
+                if ((v[0] >= SIM_MAX_RESOURCES) || (v[1] + v[2] > spec->execTime))
+                {
+                    fprintf(stderr, "Critical section out of range in line: %s", line);
+                }
+                else
+                {
+                    spec->csResource = v[0];
+                    spec->csOffset = v[1];
+                    spec->csLength = v[2];
+                }
+            }
+        }
+        else if ((strcmp(type, "aperiodic") == 0) && (sscanf(line, "%*s %15s %lu %lu %lu", name, &v[0], &v[1], &v[2]) == 4))
+        {
+            spec = addTaskSpec();
+            spec->isPeriodic = pdFALSE;
+            spec->period = v[0];
+            spec->WCET = v[1];
+            spec->execTime = v[2];
+        }
+        else
+        {
+            fprintf(stderr, "Ignoring malformed line: %s", line);
+            continue;
+        }
+        snprintf(spec->taskName, configMAX_TASK_NAME_LEN, "%s", name);
+    }
+
+    fclose(file);
+    return pdTRUE;
+}
+
+static EDFJobPolicy_t parsePolicy(const char * line, const char * key)
+{
+    // optional "overrun=<policy>" and "miss=<policy>" at the end of a periodic line
+    static const char * const names[] = {"default", "abort", "skip", "late", "mk"};
+    const char * value = strstr(line, key);
+
+    if (value != NULL)
+    {
+        value += strlen(key);
+        for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        {
+            if ((strncmp(value, names[i], strlen(names[i])) == 0) && (strchr(" \t\r\n", value[strlen(names[i])]) != NULL))
+            {
+                return (EDFJobPolicy_t)i;
+            }
+        }
+        fprintf(stderr, "Unknown policy in line: %s", line);
+    }
+    return EDF_POLICY_DEFAULT;
+}
+
+static void generateTaskSet(int numOfTasks, double utilization, unsigned int seed, double minPeriod, double maxPeriod)
+{
+    // UUniFast for the utilizations, periods log-uniform between minPeriod and maxPeriod
+    double sumU = utilization;
+    double generatedU = 0.0;
+    double nextSumU;
+    double taskU;
+    simTaskSpec_t * spec;
+
+    srand(seed);
+    for (int i = 0; i < numOfTasks; i++)
+    {
+        if (i < numOfTasks - 1)
+        {
+            nextSumU = sumU * pow((double)rand() / RAND_MAX, 1.0 / (double)(numOfTasks - i - 1));
+        }
+        else
+        {
+            nextSumU = 0.0;
+        }
+        taskU = sumU - nextSumU;
+        sumU = nextSumU;
+
+        spec = addTaskSpec();
+        // at most 5 digits fit the name, the sets stay far below that with MAX_NUM_OF_PERIODIC_TASKS
+        snprintf(spec->taskName, configMAX_TASK_NAME_LEN, "Periodic %u", (unsigned int)(i + 1) % 100000u);
+        spec->isPeriodic = pdTRUE;
+        spec->period = (TickType_t)exp(log(minPeriod) + ((double)rand() / RAND_MAX) * (log(maxPeriod) - log(minPeriod)));
+        spec->relDeadline = spec->period;
+        spec->phase = 0;
+        spec->execTime = (TickType_t)floor(taskU * (double)spec->period);
+        if (spec->execTime == 0)
+        {
+            spec->execTime = 1;
+        }
+        spec->WCET = spec->execTime;
+        generatedU += (double)spec->execTime / (double)spec->period;
+    }
+
+    printf("[SIM] Generated %d tasks, utilization %.4f (requested %.4f)\n", numOfTasks, generatedU, utilization);
+}
+
+static BaseType_t bruteForceDemand(const TickType_t * WCETs, const TickType_t * periods, const TickType_t * relDeadlines, int numOfTasks, TickType_t * slack)
+{
+    // h(t) <= t at every deadline up to the hyperperiod plus the longest deadline, the tightest slack min(t - h(t))
+    TickType_t hyperperiod = 1;
+    TickType_t maxDeadline = 0;
+    TickType_t demand;
+    TickType_t a, b, r;
+    uint64_t workload = 0;
+    BaseType_t isDeadline;
+
+    for (int i = 0; i < numOfTasks; i++)
+    {
+        a = hyperperiod;
+        b = periods[i];
+        while (b != 0)
+        {
+            r = a % b;
+            a = b;
+            b = r;
+        }
+        hyperperiod = (hyperperiod / a) * periods[i];
+        maxDeadline = (relDeadlines[i] > maxDeadline) ? relDeadlines[i] : maxDeadline;
+    }
+    for (int i = 0; i < numOfTasks; i++)
+    {
+        workload += (uint64_t)(hyperperiod / periods[i]) * WCETs[i];
+    }
+    *slack = 0;
+    if (workload > hyperperiod)
+    {
+        return pdFALSE;
+    }
+
+    *slack = portMAX_DELAY;
+    for (TickType_t t = 1; t <= hyperperiod + maxDeadline; t++)
+    {
+        demand = 0;
+        isDeadline = pdFALSE;
+        for (int i = 0; i < numOfTasks; i++)
+        {
+            if (relDeadlines[i] <= t)
+            {
+                demand += ((t - relDeadlines[i]) / periods[i] + 1) * WCETs[i];
+                isDeadline = (((t - relDeadlines[i]) % periods[i]) == 0) ? pdTRUE : isDeadline;
+            }
+        }
+        if (isDeadline == pdFALSE)
+        {
+            continue;
+        }
+        if (demand > t)
+        {
+            *slack = 0;
+            return pdFALSE;
+        }
+        *slack = (t - demand < *slack) ? t - demand : *slack;
+    }
+    return pdTRUE;
+}
+
+static int checkAdmission(int numOfSets, unsigned int seed)
+{
+    // random sets of up to 8 tasks, added on core 0 until the test rejects one, every decision compared with the scan
+    static const TickType_t divisors[] = {2, 3, 4, 5, 6, 8, 9, 10, 12, 15, 16, 18, 20, 24, 30, 36, 40, 45, 48, 60, 72, 80, 90,
+                                          120, 144, 180, 240, 360, 720};
+    const int numOfDivisors = sizeof(divisors) / sizeof(divisors[0]);
+    TickType_t WCETs[8];
+    TickType_t periods[8];
+    TickType_t relDeadlines[8];
+    TickType_t expectedSlack;
+    TickType_t slack;
+    BaseType_t expected;
+    BaseType_t admitted;
+    double sumU;
+    double nextSumU;
+    double taskU;
+    int numOfTasks;
+    uint64_t tests = 0;
+    uint64_t accepted = 0;
+    uint64_t undecided = 0;
+    uint64_t mismatches = 0;
+
+    srand(seed);
+    for (int set = 0; set < numOfSets; set++)
+    {
+        vEDFAdmissionInit();
+        numOfTasks = 1 + rand() % 8;
+        sumU = 0.2 + 0.85 * ((double)rand() / RAND_MAX);
+        for (int i = 0; i < numOfTasks; i++)
+        {
+            // UUniFast, as generateTaskSet
+            if (i < numOfTasks - 1)
+            {
+                nextSumU = sumU * pow((double)rand() / RAND_MAX, 1.0 / (numOfTasks - 1 - i));
+                taskU = sumU - nextSumU;
+                sumU = nextSumU;
+            }
+            else
+            {
+                taskU = sumU;
+            }
+            periods[i] = divisors[rand() % numOfDivisors];
+            WCETs[i] = (TickType_t)(taskU * periods[i] + 0.5);
+            WCETs[i] = (WCETs[i] < 1) ? 1 : ((WCETs[i] > periods[i]) ? periods[i] : WCETs[i]);
+            relDeadlines[i] = WCETs[i] + rand() % (periods[i] - WCETs[i] + 1);
+
+            expected = bruteForceDemand(WCETs, periods, relDeadlines, i + 1, &expectedSlack);
+            admitted = xEDFAdmissionAdd(0, WCETs[i], periods[i], relDeadlines[i], &slack);
+            tests++;
+            if (admitted == EDF_ADMISSION_UNDECIDED)
+            {
+                undecided++;
+                break;
+            }
+            if ((admitted != expected) || ((expected == pdTRUE) && (slack != expectedSlack)))
+            {
+                mismatches++;
+                fprintf(stderr, "Admission mismatch in set %d task %d (C %lu T %lu D %lu): %ld slack %lu, expected %ld slack %lu\n", set, i,
+                        (unsigned long)WCETs[i], (unsigned long)periods[i], (unsigned long)relDeadlines[i], (long)admitted, (unsigned long)slack,
+                        (long)expected, (unsigned long)expectedSlack);
+            }
+            if (expected == pdFALSE)
+            {
+                break;
+            }
+            accepted++;
+        }
+    }
+
+    printf("[SIM] Admission check: %d sets, %llu tests, %llu accepted, %llu undecided, %llu mismatches\n", numOfSets,
+           (unsigned long long)tests, (unsigned long long)accepted, (unsigned long long)undecided, (unsigned long long)mismatches);
+    return (mismatches == 0) ? 0 : 1;
+}
+
+void simSchedulerWake(uint32_t ulEvent)
+{
+    (void)ulEvent;
+    if ((timePasses == pdTRUE) && (schedulingStarted == pdTRUE) && (schedWakePending == pdFALSE))
+    {
+        clock_gettime(CLOCK_MONOTONIC, &schedWakeTime);
+        schedWakePending = pdTRUE;
+    }
+}
+
+void simSchedulerDone(uint32_t ulEvents)
+{
+    struct timespec doneTime;
+    simLatency_t * latency = &schedLatency;
+    uint64_t ns;
+
+    (void)ulEvents;
+    schedPasses++;
+    if (schedWakePending == pdTRUE)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &doneTime);
+        ns = (uint64_t)(doneTime.tv_sec - schedWakeTime.tv_sec) * 1000000000u + (uint64_t)doneTime.tv_nsec - (uint64_t)schedWakeTime.tv_nsec;
+        #if USE_EDF_INLINE_DISPATCH == 1
+        if (xTaskGetCurrentTaskHandle() == timerTaskHandle)
+        {
+            latency = &deferredLatency;
+        }
+        #endif
+        latency->samples++;
+        latency->sumNs += ns;
+        if (ns > latency->maxNs)
+        {
+            latency->maxNs = ns;
+        }
+        schedWakePending = pdFALSE;
+    }
+}
+
+static void printLatency(const char * pcName, const simLatency_t * latency)
+{
+    if (latency->samples > 0)
+    {
+        printf("[SIM] %s latency (host wall time): %llu passes, mean %.2f us, max %.2f us\n", pcName, (unsigned long long)latency->samples,
+               (double)latency->sumNs / (double)latency->samples / 1000.0, (double)latency->maxNs / 1000.0);
+    }
+}
+
+static void printResults(double setupTime, double wallTime, BaseType_t verbose)
+{
+    #if USE_EDF_INLINE_DISPATCH == 1
+    simTaskStats_t timerStats;
+    TaskHandle_t timerHandle = simFindTask("Tmr Svc");
+    #endif
+    uint64_t jobs = 0;
+    uint64_t misses = 0;
+    uint64_t aperiodicJobs = 0;
+    TickType_t aperiodicMaxResponse = 0;
+
+    for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+    {
+        jobs += taskSpecs[i].jobs;
+        misses += taskSpecs[i].deadlineMisses;
+        if (taskSpecs[i].isPeriodic == pdFALSE)
+        {
+            aperiodicJobs += taskSpecs[i].jobs;
+            if (taskSpecs[i].maxResponseTime > aperiodicMaxResponse)
+            {
+                aperiodicMaxResponse = taskSpecs[i].maxResponseTime;
+            }
+        }
+    }
+
+    if (verbose == pdTRUE)
+    {
+        printf("%-16s %8s %8s %8s %10s %8s %10s %12s", "Task", "Period", "WCET", "Exec", "Jobs", "Misses", "Preempted", "MaxResponse");
+        #if USE_EDF_TASK_STATS == 1
+        // the longest job as measured by the library (EDFGetTaskStats), in us
+        printf(" %10s", "MaxExecUs");
+        #endif
+        printf("\n");
+        for (BaseType_t i = 0; i < numOfTaskSpecs; i++)
+        {
+            simTaskSpec_t * spec = &taskSpecs[i];
+            printf("%-16s %8lu %8lu %8lu %10llu %8llu %10llu %12lu", spec->taskName, spec->period, spec->WCET, spec->execTime,
+                (unsigned long long)spec->jobs, (unsigned long long)spec->deadlineMisses, (unsigned long long)spec->preemptions, spec->maxResponseTime);
+            #if USE_EDF_TASK_STATS == 1
+            printf(" %10lu", (unsigned long)spec->libStats.ulMaxExecTime);
+            #endif
+            printf("\n");
+        }
+    }
+
+    // the ticks per second are of the simulation only, the setup covers the creation and admission of the tasks
+    printf("[SIM] Tasks: %d, simulated ticks: %lu, setup time: %.3f s, wall time: %.3f s, ticks per second: %.0f\n", (int)numOfTaskSpecs, (unsigned long)xTaskGetTickCount(),
+           setupTime, wallTime, (double)xTaskGetTickCount() / wallTime);
+    printf("[SIM] Jobs completed: %llu, deadline misses: %llu, preemptions: %llu\n", (unsigned long long)jobs, (unsigned long long)misses, (unsigned long long)totalPreemptions);
+    if (aperiodicJobs > 0)
+    {
+        printf("[SIM] Aperiodic jobs: %llu, mean response: %.1f, max response: %lu\n", (unsigned long long)aperiodicJobs, (double)aperiodicResponseSum / (double)aperiodicJobs, (unsigned long)aperiodicMaxResponse);
+    }
+    if (submitAtRuntime == pdTRUE)
+    {
+        printf("[SIM] Aperiodic submissions rejected (arrival queue full): %llu\n", (unsigned long long)rejectedSubmissions);
+    }
+    if (criticalSections > 0)
+    {
+        printf("[SIM] Critical sections: %llu, entered while another job was inside: %llu\n", (unsigned long long)criticalSections, (unsigned long long)overlappingSections);
+    }
+    if (modeChanges == pdTRUE)
+    {
+        printf("[SIM] Tasks added at runtime: %llu, rejected: %llu, removed: %llu\n", (unsigned long long)addedTasks, (unsigned long long)rejectedTasks, (unsigned long long)removedTasks);
+    }
+    #if configNUMBER_OF_CORES > 1
+    printf("[SIM] Job migrations: %llu\n", (unsigned long long)totalMigrations);
+    #endif
+    printf("[SIM] Scheduler invocations: %llu, context switches: %llu\n", (unsigned long long)schedPasses, (unsigned long long)simGetContextSwitches());
+    #if USE_EDF_INLINE_DISPATCH == 1
+    // the other passes were made inline by the tasks themselves
+    simGetTaskStats(timerHandle, &timerStats);
+    printf("[SIM] Passes deferred to the timer service task: %llu\n", (unsigned long long)timerStats.ulNotifyWaits);
+    printLatency("Inline decision", &schedLatency);
+    printLatency("Deferred pass", &deferredLatency);
+    #else
+    printLatency("Scheduler pass", &schedLatency);
+    #endif
+}
+
+int main(int argc, char ** argv)
+{
+    BaseType_t verbose = pdFALSE;
+    struct timespec startTime;
+    struct timespec endTime;
+    int numOfTasks;
+    double utilization;
+    unsigned int seed;
+    double minPeriod;
+    double maxPeriod;
+    int numOfSets;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc))
+        {
+            if (loadTaskSet(argv[++i]) == pdFALSE)
+            {
+                return 1;
+            }
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+        {
+            seed = 1;
+            minPeriod = 10.0;
+            maxPeriod = 1000.0;
+            if ((sscanf(argv[++i], "%d:%lf:%u:%lf:%lf", &numOfTasks, &utilization, &seed, &minPeriod, &maxPeriod) < 2) ||
+                (minPeriod < 1.0) || (maxPeriod < minPeriod))
+            {
+                fprintf(stderr, "Expected -r N:U[:seed[:Tmin:Tmax]]\n");
+                return 1;
+            }
+            generateTaskSet(numOfTasks, utilization, seed, minPeriod, maxPeriod);
+        }
+        else if ((strcmp(argv[i], "-a") == 0) && (i + 1 < argc))
+        {
+            seed = 1;
+            if ((sscanf(argv[++i], "%d:%u", &numOfSets, &seed) < 1) || (numOfSets < 1))
+            {
+                fprintf(stderr, "Expected -a N[:seed]\n");
+                return 1;
+            }
+            // the library tests on their own, without the simulated kernel
+            return checkAdmission(numOfSets, seed);
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            simTicks = strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "-s") == 0)
+        {
+            submitAtRuntime = pdTRUE;
+        }
+        else if (strcmp(argv[i], "-v") == 0)
+        {
+            verbose = pdTRUE;
+            timePasses = pdTRUE;
+        }
+        else if (strcmp(argv[i], "-l") == 0)
+        {
+            simSetLibraryOutput(pdTRUE);
+        }
+        #if USE_EDF_TRACE == 1
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            traceFile = fopen(argv[++i], "wb");
+            if (traceFile == NULL)
+            {
+                fprintf(stderr, "Cannot open %s\n", argv[i]);
+                return 1;
+            }
+        }
+        #endif
+        else
+        {
+            fprintf(stderr, "Usage: %s [-f taskset.txt] [-r N:U[:seed[:Tmin:Tmax]]] [-t ticks] [-s] [-v] [-l] [-o trace.bin] | -a N[:seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (numOfTaskSpecs == 0)
+    {
+        fprintf(stderr, "No tasks given, use -f or -r\n");
+        return 1;
+    }
+
+    #if USE_EDF_TRACE == 1
+    if (traceFile != NULL)
+    {
+        vEDFTraceSetSink(simTraceSink);
+    }
+    #endif
+
+    simInit();
+    simSetSwitchHook(simSwitchHook);
+    simSetTickHook(simTickHook);
+    // the application task starts at priority 1, like app_main on the ESP32
+    xTaskCreate(simAppMain, "main", 4096, NULL, 1, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    simRun(portMAX_DELAY);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    printResults((schedulingStartTime.tv_sec - startTime.tv_sec) + (schedulingStartTime.tv_nsec - startTime.tv_nsec) / 1e9,
+                 (endTime.tv_sec - schedulingStartTime.tv_sec) + (endTime.tv_nsec - schedulingStartTime.tv_nsec) / 1e9, verbose);
+
+    simShutdown();
+    free(taskSpecs);
+    if (traceFile != NULL)
+    {
+        fclose(traceFile);
+    }
+    return 0;
+}
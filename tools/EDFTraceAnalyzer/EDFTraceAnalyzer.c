@@ -0,0 +1,839 @@
+/*
+                    Trace Converter and Analyzer for the Extended EDF Library
+
+    Description:
+
+        Reads the binary trace of EDFTrace.h, as written by EDFSimulator -o, EDFSchedBench -o or captured from the
+        console UART of the ESP32, and prints the timing of every task. Optionally it converts the trace into a JSON
+        timeline in the Chrome trace event format, which Perfetto (ui.perfetto.dev) and chrome://tracing open: one
+        process per core, one thread per task, a slice per execution and instants for the job events.
+
+        The input is read block by block, so traces of any length are processed in bounded memory. Bytes that do
+        not belong to a valid block (console text, a block cut off by a reset) are skipped up to the next magic. The
+        blocks of the cores are merged on their time stamps, holding at most TRACE_MERGE_DEPTH blocks of every core.
+
+    Usage:
+
+        EDFTraceAnalyzer [-j timeline.json] [trace.bin]
+
+            -j  write the timeline to a file
+            reads stdin when no trace is given or it is -
+
+        Per task: completed jobs, preemptions, WCET overflows, deadline misses, response time (release to job end),
+        release jitter (spread of the time from the release to the deadline, which is constant for a periodic task
+        released on time), deadline slack (deadline minus job end, negative for a miss) and share of the processor
+        time. The summary gives the scheduler overhead, i.e. the time in the scheduler tasks, and the idle time in
+        percent of the traced time of all cores. Times are in us.
+
+        Preemptions are counted as by the simulator. With inline dispatch the scheduling decisions run in the tasks,
+        which shows as more preemptions than the simulator counts. The jobs of the aperiodic server are not traced as
+        jobs, they only add to its processor time. The events of a task that migrates between cores are ordered by the
+        clocks of the cores, which may differ by a few us on the device.
+*/
+
+// ************************* File Includes *************************** //
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "EDFTrace.h"
+// ******************************************************************* //
+
+// ************************** Analyzer Defines *********************** //
+#define TRACE_HEADER_SIZE                   24
+#define TRACE_MAX_BLOCK                     (TRACE_HEADER_SIZE + 0xFFFF)
+#define TRACE_READ_BUFFER_SIZE              (2 * TRACE_MAX_BLOCK)
+#define TRACE_MAX_CORES                     64
+#define TRACE_MAX_TASKS                     65536   // larger task numbers are taken as corrupted records
+#define TRACE_MERGE_DEPTH                   8       // blocks held per core while waiting for the other cores
+#define TRACE_MAX_SEQUENCE_GAP              0x10000 // blocks, a larger jump of the sequence is taken as a false magic
+#define TRACE_NO_TASK                       UINT32_MAX
+
+_Static_assert(sizeof(EDFTraceBlockHeader_t) == TRACE_HEADER_SIZE, "EDFTraceBlockHeader_t layout changed");
+// ******************************************************************* //
+
+// ************************* Data Structures ***************************** //
+typedef struct traceRecord
+{
+    int64_t time;                       // us
+    uint32_t event;
+    uint32_t task;
+    uint32_t toDeadline;                // us, release records only
+} traceRecord_t;
+
+typedef struct traceBlock
+{
+    uint32_t sequence;
+    uint32_t dropped;
+    int64_t baseTime;
+    uint32_t length;
+    uint8_t records[0xFFFF];
+} traceBlock_t;
+
+typedef struct traceCore
+{
+    // merge queue, blocks are decoded one record at a time
+    traceBlock_t * blocks[TRACE_MERGE_DEPTH];
+    uint32_t head;
+    uint32_t count;
+    uint32_t position;                  // in the records of the head block
+    int64_t time;                       // of the last record decoded
+    traceRecord_t next;
+    int hasNext;
+
+    // stream state, as read and as merged
+    int seen;
+    uint32_t queuedSequence;
+    int64_t queuedEndTime;
+    uint32_t nextSequence;
+    uint32_t dropped;
+    uint64_t droppedBefore;             // by the runs before the last restart
+    uint64_t lostBlocks;
+    uint64_t restarts;
+    int64_t tracedTime;                 // of the runs before the last restart
+    int64_t firstTime;
+    int64_t lastTime;
+
+    // the task on the processor, a switch out is held until the next switch in as the kernel may select it again
+    uint32_t running;
+    int64_t runStart;
+    uint32_t switchedOut;
+    int64_t switchedOutTime;
+    uint32_t lastJob;                   // the EDF task that ran last, it is preempted if another one runs before its job ends
+} traceCore_t;
+
+typedef struct traceTask
+{
+    int seen;
+    uint64_t namedOnCores;              // thread names written to the timeline, cores 0 to 63
+
+    // the pending job
+    int jobActive;
+    int jobStarted;
+    int overrun;
+    uint32_t lastCore;
+    int64_t releaseTime;
+    int64_t deadline;
+
+    uint64_t releases;
+    uint64_t jobs;
+    uint64_t preemptions;
+    uint64_t wcetOverflows;
+    uint64_t deadlineMisses;
+    uint64_t unmatchedEnds;             // job ends without a traced release
+    int64_t execTime;
+
+    int64_t responseMin;
+    int64_t responseMax;
+    int64_t responseSum;
+    uint32_t toDeadlineMin;
+    uint32_t toDeadlineMax;
+    int64_t slackMin;
+    int64_t slackSum;
+} traceTask_t;
+// *********************************************************************** //
+
+// *************************** Globals ************************************ //
+static uint8_t readBuffer[TRACE_READ_BUFFER_SIZE];
+static size_t readStart = 0;
+static size_t readEnd = 0;
+static int readEOF = 0;
+static FILE * inputFile = NULL;
+
+static traceCore_t cores[TRACE_MAX_CORES];
+static traceTask_t * tasks = NULL;
+static uint32_t numOfTasks = 0;
+
+static FILE * jsonFile = NULL;
+static int jsonFirst = 1;
+
+static uint64_t numOfBlocks = 0;
+static uint64_t numOfRecords = 0;
+static uint64_t skippedBytes = 0;
+static uint64_t truncatedBlocks = 0;
+
+static const char * eventNames[EDF_TRACE_NUM_OF_EVENTS] = {"switch in", "switch out", "release", "job end", "WCET overflow", "deadline miss"};
+// *********************************************************************** //
+
+// ****************** Private Function Declarations ***************** //
+static int fillReadBuffer(void);
+static int readBlock(void);
+static int decodeVarint(const uint8_t * data, uint32_t length, uint32_t * position, uint64_t * value);
+static int decodeRecord(const uint8_t * data, uint32_t length, uint32_t * position, int64_t * time, traceRecord_t * record);
+static int validateBlock(const uint8_t * data, uint32_t length, size_t available, int64_t * endTime);
+static int acceptBlock(const uint8_t * header, int64_t endTime);
+static void queueBlock(uint32_t core, const uint8_t * header);
+static void advanceCore(traceCore_t * core);
+static void mergeRecords(int force, traceCore_t * until);
+static traceTask_t * getTask(uint32_t task);
+static const char * taskName(uint32_t task, char * buffer, size_t size);
+static void processRecord(uint32_t coreID, const traceRecord_t * record);
+static void closeSlice(uint32_t coreID, uint32_t task, int64_t start, int64_t end);
+static void jsonEvent(const char * format, ...) __attribute__((format(printf, 1, 2)));
+static void jsonThreadName(uint32_t coreID, uint32_t task);
+static void printResults(void);
+// ******************************************************************* //
+
+static uint32_t readLE32(const uint8_t * data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static int fillReadBuffer(void)
+{
+    // moves the unread bytes to the front and reads behind them, returns 0 once nothing more can be read
+    size_t bytesRead;
+
+    if (readEOF)
+    {
+        return 0;
+    }
+    memmove(readBuffer, &readBuffer[readStart], readEnd - readStart);
+    readEnd -= readStart;
+    readStart = 0;
+    bytesRead = fread(&readBuffer[readEnd], 1, sizeof(readBuffer) - readEnd, inputFile);
+    readEnd += bytesRead;
+    if (bytesRead == 0)
+    {
+        readEOF = 1;
+    }
+    return (int)bytesRead;
+}
+
+static int decodeVarint(const uint8_t * data, uint32_t length, uint32_t * position, uint64_t * value)
+{
+    uint64_t result = 0;
+
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        if (*position >= length)
+        {
+            return 0;
+        }
+        result |= (uint64_t)(data[*position] & 0x7F) << shift;
+        if ((data[(*position)++] & 0x80) == 0)
+        {
+            *value = result;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int decodeRecord(const uint8_t * data, uint32_t length, uint32_t * position, int64_t * time, traceRecord_t * record)
+{
+    uint64_t head;
+    uint64_t task;
+    uint64_t toDeadline = 0;
+
+    if (!decodeVarint(data, length, position, &head) || !decodeVarint(data, length, position, &task))
+    {
+        return 0;
+    }
+    record->event = (uint32_t)(head & ((1u << EDF_TRACE_EVENT_BITS) - 1));
+    if ((record->event >= EDF_TRACE_NUM_OF_EVENTS) || (task >= TRACE_MAX_TASKS))
+    {
+        return 0;
+    }
+    if ((record->event == EDF_TRACE_RELEASE) && (!decodeVarint(data, length, position, &toDeadline) || (toDeadline > UINT32_MAX)))
+    {
+        return 0;
+    }
+    *time += (int64_t)(head >> EDF_TRACE_EVENT_BITS);
+    record->time = *time;
+    record->task = (uint32_t)task;
+    record->toDeadline = (uint32_t)toDeadline;
+    return 1;
+}
+
+static int validateBlock(const uint8_t * data, uint32_t length, size_t available, int64_t * endTime)
+{
+    // a block is only taken if all of its records decode and end with it, so a magic in console text is skipped.
+    // Records never hold a header as the event of 'F' is invalid, a header starting among them (available bytes are
+    // read past the end) is the next block behind a cut-off one
+    uint32_t position = 0;
+    int64_t time = 0;
+    traceRecord_t record;
+
+    if (length == 0)
+    {
+        return 0;
+    }
+    for (uint32_t i = 0; (i < length) && (i + 5 <= available); i++)
+    {
+        if ((readLE32(&data[i]) == EDF_TRACE_MAGIC) && (data[i + 4] == EDF_TRACE_VERSION))
+        {
+            return 0;
+        }
+    }
+    while (position < length)
+    {
+        if (!decodeRecord(data, length, &position, &time, &record))
+        {
+            return 0;
+        }
+    }
+    *endTime = time;
+    return 1;
+}
+
+static int acceptBlock(const uint8_t * header, int64_t endTime)
+{
+    // the blocks of a core follow each other in sequence and time, except when the system restarted with sequence 0.
+    // Anything else is a stale copy of a block or a false magic
+    traceCore_t * core;
+    uint32_t sequence = readLE32(&header[8]);
+    int64_t baseTime = (int64_t)((uint64_t)readLE32(&header[16]) | ((uint64_t)readLE32(&header[20]) << 32));
+
+    if (header[5] >= TRACE_MAX_CORES)
+    {
+        return 0;
+    }
+    core = &cores[header[5]];
+    if (core->seen && (sequence != 0))
+    {
+        if ((sequence - (core->queuedSequence + 1) >= TRACE_MAX_SEQUENCE_GAP) || (baseTime < core->queuedEndTime))
+        {
+            return 0;
+        }
+    }
+    core->queuedSequence = sequence;
+    core->queuedEndTime = baseTime + endTime;
+    return 1;
+}
+
+static int readBlock(void)
+{
+    // finds the next valid block and queues it, returns 0 at the end of the input
+    for (;;)
+    {
+        uint8_t * header;
+        uint32_t length;
+        int64_t endTime;
+
+        if ((readEnd - readStart < TRACE_HEADER_SIZE) && (fillReadBuffer() == 0) && (readEnd - readStart < TRACE_HEADER_SIZE))
+        {
+            skippedBytes += readEnd - readStart;
+            readStart = readEnd;
+            return 0;
+        }
+        header = &readBuffer[readStart];
+        if ((readLE32(header) != EDF_TRACE_MAGIC) || (header[4] != EDF_TRACE_VERSION))
+        {
+            readStart++;
+            skippedBytes++;
+            continue;
+        }
+        length = (uint32_t)header[6] | ((uint32_t)header[7] << 8);
+        while ((readEnd - readStart < TRACE_HEADER_SIZE + length) && (fillReadBuffer() > 0))
+        {
+        }
+        header = &readBuffer[readStart];
+        if (readEnd - readStart < TRACE_HEADER_SIZE + length)
+        {
+            // cut off at the end of the input, the bytes behind the magic may still hold a complete block
+            truncatedBlocks++;
+            readStart++;
+            skippedBytes++;
+            continue;
+        }
+        if (!validateBlock(&header[TRACE_HEADER_SIZE], length, readEnd - readStart - TRACE_HEADER_SIZE, &endTime) || !acceptBlock(header, endTime))
+        {
+            readStart++;
+            skippedBytes++;
+            continue;
+        }
+        queueBlock(header[5], header);
+        readStart += TRACE_HEADER_SIZE + length;
+        return 1;
+    }
+}
+
+static void queueBlock(uint32_t coreID, const uint8_t * header)
+{
+    traceCore_t * core = &cores[coreID];
+    traceBlock_t * block;
+    uint32_t slot;
+
+    if (core->count == TRACE_MERGE_DEPTH)
+    {
+        // the other cores are behind, their records so far are merged without waiting for more
+        mergeRecords(1, core);
+    }
+
+    slot = (core->head + core->count) % TRACE_MERGE_DEPTH;
+    if (core->blocks[slot] == NULL)
+    {
+        core->blocks[slot] = malloc(sizeof(traceBlock_t));
+        if (core->blocks[slot] == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+    }
+    block = core->blocks[slot];
+    block->sequence = readLE32(&header[8]);
+    block->dropped = readLE32(&header[12]);
+    block->baseTime = (int64_t)((uint64_t)readLE32(&header[16]) | ((uint64_t)readLE32(&header[20]) << 32));
+    block->length = (uint32_t)header[6] | ((uint32_t)header[7] << 8);
+    memcpy(block->records, &header[TRACE_HEADER_SIZE], block->length);
+    numOfBlocks++;
+
+    if (!core->seen)
+    {
+        core->seen = 1;
+        core->nextSequence = block->sequence;
+        core->firstTime = block->baseTime;
+        core->running = TRACE_NO_TASK;
+        core->switchedOut = TRACE_NO_TASK;
+        core->lastJob = TRACE_NO_TASK;
+    }
+    core->count++;
+    if (!core->hasNext)
+    {
+        advanceCore(core);
+    }
+}
+
+static void advanceCore(traceCore_t * core)
+{
+    // decodes the next record of the core into core->next, moving on to the next queued block at the end of one
+    traceBlock_t * block;
+
+    core->hasNext = 0;
+    while (core->count > 0)
+    {
+        block = core->blocks[core->head];
+        if (core->position == 0)
+        {
+            // a new block, a gap in the sequence or new drops mean that records are missing before it
+            if ((block->sequence != core->nextSequence) || (block->dropped != core->dropped))
+            {
+                if (block->sequence < core->nextSequence)
+                {
+                    // the system restarted, its clock and counters begin again
+                    if ((core->running != TRACE_NO_TASK) && (core->switchedOut == TRACE_NO_TASK))
+                    {
+                        closeSlice((uint32_t)(core - cores), core->running, core->runStart, core->lastTime);
+                    }
+                    core->tracedTime += core->lastTime - core->firstTime;
+                    core->droppedBefore += core->dropped;
+                    core->firstTime = block->baseTime;
+                    core->lastTime = block->baseTime;
+                    core->restarts++;
+                }
+                else
+                {
+                    core->lostBlocks += block->sequence - core->nextSequence;
+                }
+                core->dropped = block->dropped;
+                core->running = TRACE_NO_TASK;
+                core->switchedOut = TRACE_NO_TASK;
+                core->lastJob = TRACE_NO_TASK;
+                for (uint32_t i = 0; i < numOfTasks; i++)
+                {
+                    tasks[i].jobActive = 0;
+                }
+            }
+            core->nextSequence = block->sequence + 1;
+            core->time = block->baseTime;
+        }
+        if (core->position < block->length)
+        {
+            (void)decodeRecord(block->records, block->length, &core->position, &core->time, &core->next);
+            core->hasNext = 1;
+            return;
+        }
+        core->head = (core->head + 1) % TRACE_MERGE_DEPTH;
+        core->count--;
+        core->position = 0;
+    }
+}
+
+static void mergeRecords(int force, traceCore_t * until)
+{
+    // processes the records of all cores in time order. Without force it stops as soon as a core that has been seen
+    // has no record queued, as its next block may still hold earlier ones. With until, it stops once that core has
+    // room for another block
+    for (;;)
+    {
+        traceCore_t * earliest = NULL;
+
+        if ((until != NULL) && (until->count < TRACE_MERGE_DEPTH))
+        {
+            return;
+        }
+        for (uint32_t i = 0; i < TRACE_MAX_CORES; i++)
+        {
+            if (!cores[i].seen)
+            {
+                continue;
+            }
+            if (!cores[i].hasNext)
+            {
+                if (!force)
+                {
+                    return;
+                }
+                continue;
+            }
+            if ((earliest == NULL) || (cores[i].next.time < earliest->next.time))
+            {
+                earliest = &cores[i];
+            }
+        }
+        if (earliest == NULL)
+        {
+            return;
+        }
+        processRecord((uint32_t)(earliest - cores), &earliest->next);
+        advanceCore(earliest);
+    }
+}
+
+static traceTask_t * getTask(uint32_t task)
+{
+    // the table grows with the largest task number, not with the length of the trace
+    if (task >= numOfTasks)
+    {
+        uint32_t newNumOfTasks = (task + 64) & ~63u;
+        traceTask_t * newTasks = realloc(tasks, newNumOfTasks * sizeof(traceTask_t));
+        if (newTasks == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        memset(&newTasks[numOfTasks], 0, (newNumOfTasks - numOfTasks) * sizeof(traceTask_t));
+        tasks = newTasks;
+        numOfTasks = newNumOfTasks;
+    }
+    return &tasks[task];
+}
+
+static const char * taskName(uint32_t task, char * buffer, size_t size)
+{
+    switch (task)
+    {
+        case EDF_TRACE_TASK_OTHER:
+            return "Other";
+        case EDF_TRACE_TASK_SCHEDULER:
+            return "Scheduler";
+        case EDF_TRACE_TASK_SERVER:
+            return "Aperiodic";
+        case EDF_TRACE_TASK_IDLE:
+            return "Idle";
+        default:
+            snprintf(buffer, size, "Task %" PRIu32, task);
+            return buffer;
+    }
+}
+
+static void jsonEvent(const char * format, ...)
+{
+    va_list args;
+
+    if (jsonFile == NULL)
+    {
+        return;
+    }
+    fputs(jsonFirst ? "\n" : ",\n", jsonFile);
+    jsonFirst = 0;
+    va_start(args, format);
+    vfprintf(jsonFile, format, args);
+    va_end(args);
+}
+
+static void jsonThreadName(uint32_t coreID, uint32_t task)
+{
+    traceTask_t * pxTask = getTask(task);
+    char name[32];
+
+    if ((jsonFile == NULL) || (coreID >= 64) || (pxTask->namedOnCores & (1ULL << coreID)))
+    {
+        return;
+    }
+    pxTask->namedOnCores |= 1ULL << coreID;
+    // the EDF tasks are sorted by their number, below the library tasks
+    jsonEvent("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%" PRIu32 ",\"tid\":%" PRIu32 ",\"args\":{\"name\":\"%s\"}}",
+              coreID, task, taskName(task, name, sizeof(name)));
+    jsonEvent("{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":%" PRIu32 ",\"tid\":%" PRIu32 ",\"args\":{\"sort_index\":%" PRIu32 "}}",
+              coreID, task, task);
+}
+
+static void closeSlice(uint32_t coreID, uint32_t task, int64_t start, int64_t end)
+{
+    traceTask_t * pxTask = getTask(task);
+    char name[32];
+
+    pxTask->execTime += end - start;
+    jsonThreadName(coreID, task);
+    jsonEvent("{\"ph\":\"X\",\"name\":\"%s\",\"pid\":%" PRIu32 ",\"tid\":%" PRIu32 ",\"ts\":%" PRId64 ",\"dur\":%" PRId64 "}",
+              taskName(task, name, sizeof(name)), coreID, task, start, end - start);
+}
+
+static void processRecord(uint32_t coreID, const traceRecord_t * record)
+{
+    traceCore_t * core = &cores[coreID];
+    traceTask_t * pxTask = getTask(record->task);
+    int64_t response;
+    int64_t slack;
+
+    numOfRecords++;
+    pxTask->seen = 1;
+    core->lastTime = record->time;
+
+    switch (record->event)
+    {
+        case EDF_TRACE_SWITCH_OUT:
+            core->switchedOut = record->task;
+            core->switchedOutTime = record->time;
+            return;
+
+        case EDF_TRACE_SWITCH_IN:
+            if ((core->switchedOut == record->task) && (core->running == record->task))
+            {
+                // selected again, the slice goes on
+                core->switchedOut = TRACE_NO_TASK;
+                return;
+            }
+            if ((core->running != TRACE_NO_TASK) && (core->switchedOut != TRACE_NO_TASK))
+            {
+                // the slice goes to the task as it left, the aperiodic server takes the number of the job it runs
+                closeSlice(coreID, core->switchedOut, core->runStart, core->switchedOutTime);
+            }
+            if ((record->task == EDF_TRACE_TASK_SERVER) || (record->task > EDF_TRACE_TASK_IDLE))
+            {
+                // as counted by the simulator: the job that ran last on the core has not ended and did not continue on
+                // another core meanwhile. A job suspended on a WCET overflow is not preempted
+                if ((core->lastJob != TRACE_NO_TASK) && (core->lastJob != record->task))
+                {
+                    traceTask_t * pxLast = getTask(core->lastJob);
+                    if (pxLast->jobActive && pxLast->jobStarted && !pxLast->overrun && (pxLast->lastCore == coreID))
+                    {
+                        pxLast->preemptions++;
+                    }
+                }
+                core->lastJob = record->task;
+                pxTask->lastCore = coreID;
+                pxTask->jobStarted = pxTask->jobActive;
+            }
+            core->running = record->task;
+            core->runStart = record->time;
+            core->switchedOut = TRACE_NO_TASK;
+            return;
+
+        case EDF_TRACE_RELEASE:
+            pxTask->jobActive = 1;
+            pxTask->jobStarted = 0;
+            pxTask->overrun = 0;
+            pxTask->releaseTime = record->time;
+            pxTask->deadline = record->time + record->toDeadline;
+            if ((pxTask->releases == 0) || (record->toDeadline < pxTask->toDeadlineMin))
+            {
+                pxTask->toDeadlineMin = record->toDeadline;
+            }
+            if ((pxTask->releases == 0) || (record->toDeadline > pxTask->toDeadlineMax))
+            {
+                pxTask->toDeadlineMax = record->toDeadline;
+            }
+            pxTask->releases++;
+            break;
+
+        case EDF_TRACE_BLOCK:
+            if (!pxTask->jobActive)
+            {
+                pxTask->unmatchedEnds++;
+                break;
+            }
+            response = record->time - pxTask->releaseTime;
+            slack = pxTask->deadline - record->time;
+            if ((pxTask->jobs == 0) || (response < pxTask->responseMin))
+            {
+                pxTask->responseMin = response;
+            }
+            if ((pxTask->jobs == 0) || (response > pxTask->responseMax))
+            {
+                pxTask->responseMax = response;
+            }
+            if ((pxTask->jobs == 0) || (slack < pxTask->slackMin))
+            {
+                pxTask->slackMin = slack;
+            }
+            pxTask->responseSum += response;
+            pxTask->slackSum += slack;
+            pxTask->jobs++;
+            pxTask->jobActive = 0;
+            break;
+
+        case EDF_TRACE_WCET_OVERFLOW:
+            pxTask->wcetOverflows++;
+            pxTask->overrun = 1;
+            break;
+
+        case EDF_TRACE_DEADLINE_MISS:
+            pxTask->deadlineMisses++;
+            break;
+
+        default:
+            return;
+    }
+
+    jsonThreadName(coreID, record->task);
+    if (record->event == EDF_TRACE_RELEASE)
+    {
+        jsonEvent("{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\",\"pid\":%" PRIu32 ",\"tid\":%" PRIu32 ",\"ts\":%" PRId64 ",\"args\":{\"deadline\":%" PRId64 "}}",
+                  eventNames[record->event], coreID, record->task, record->time, pxTask->deadline);
+    }
+    else
+    {
+        jsonEvent("{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\",\"pid\":%" PRIu32 ",\"tid\":%" PRIu32 ",\"ts\":%" PRId64 "}",
+                  eventNames[record->event], coreID, record->task, record->time);
+    }
+}
+
+static void printResults(void)
+{
+    int64_t totalTime = 0;
+    int64_t schedulerTime = 0;
+    int64_t idleTime = 0;
+    uint64_t droppedRecords = 0;
+    uint64_t lostBlocks = 0;
+    uint64_t restarts = 0;
+    char name[32];
+
+    for (uint32_t i = 0; i < TRACE_MAX_CORES; i++)
+    {
+        if (cores[i].seen)
+        {
+            totalTime += cores[i].tracedTime + cores[i].lastTime - cores[i].firstTime;
+            droppedRecords += cores[i].droppedBefore + cores[i].dropped;
+            lostBlocks += cores[i].lostBlocks;
+            restarts += cores[i].restarts;
+        }
+    }
+    if (numOfTasks > EDF_TRACE_TASK_IDLE)
+    {
+        schedulerTime = tasks[EDF_TRACE_TASK_SCHEDULER].execTime;
+        idleTime = tasks[EDF_TRACE_TASK_IDLE].execTime;
+    }
+
+    printf("%-12s %8s %8s %6s %6s %10s %10s %10s %8s %10s %10s %7s\n", "task", "jobs", "preempt", "wcet", "miss",
+           "resp_min", "resp_mean", "resp_max", "jitter", "slack_min", "slack_mean", "cpu_%");
+    for (uint32_t i = 0; i < numOfTasks; i++)
+    {
+        traceTask_t * pxTask = &tasks[i];
+        if (!pxTask->seen)
+        {
+            continue;
+        }
+        printf("%-12s %8" PRIu64 " %8" PRIu64 " %6" PRIu64 " %6" PRIu64, taskName(i, name, sizeof(name)), pxTask->jobs,
+               pxTask->preemptions, pxTask->wcetOverflows, pxTask->deadlineMisses);
+        if (pxTask->jobs > 0)
+        {
+            printf(" %10" PRId64 " %10.1f %10" PRId64 " %8" PRIu32 " %10" PRId64 " %10.1f", pxTask->responseMin,
+                   (double)pxTask->responseSum / (double)pxTask->jobs, pxTask->responseMax, pxTask->toDeadlineMax - pxTask->toDeadlineMin,
+                   pxTask->slackMin, (double)pxTask->slackSum / (double)pxTask->jobs);
+        }
+        else
+        {
+            printf(" %10s %10s %10s %8s %10s %10s", "-", "-", "-", "-", "-", "-");
+        }
+        printf(" %7.2f\n", (totalTime > 0) ? 100.0 * (double)pxTask->execTime / (double)totalTime : 0.0);
+    }
+
+    printf("[TRACE] Blocks: %" PRIu64 ", records: %" PRIu64 ", traced time: %" PRId64 " us\n", numOfBlocks, numOfRecords, totalTime);
+    printf("[TRACE] Dropped records: %" PRIu64 ", lost blocks: %" PRIu64 ", restarts: %" PRIu64 ", truncated blocks: %" PRIu64 ", skipped bytes: %" PRIu64 "\n",
+           droppedRecords, lostBlocks, restarts, truncatedBlocks, skippedBytes);
+    printf("[TRACE] Scheduler overhead: %.2f %%, idle: %.2f %%\n", (totalTime > 0) ? 100.0 * (double)schedulerTime / (double)totalTime : 0.0,
+           (totalTime > 0) ? 100.0 * (double)idleTime / (double)totalTime : 0.0);
+}
+
+int main(int argc, char ** argv)
+{
+    const char * inputName = NULL;
+    const char * jsonName = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+        {
+            jsonName = argv[++i];
+        }
+        else if ((inputName == NULL) && ((argv[i][0] != '-') || (strcmp(argv[i], "-") == 0)))
+        {
+            inputName = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-j timeline.json] [trace.bin]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    inputFile = ((inputName == NULL) || (strcmp(inputName, "-") == 0)) ? stdin : fopen(inputName, "rb");
+    if (inputFile == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", inputName);
+        return 1;
+    }
+    if (jsonName != NULL)
+    {
+        jsonFile = fopen(jsonName, "w");
+        if (jsonFile == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", jsonName);
+            return 1;
+        }
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", jsonFile);
+    }
+
+    while (readBlock())
+    {
+        mergeRecords(0, NULL);
+    }
+    mergeRecords(1, NULL);
+
+    // the slices still open end with the trace
+    for (uint32_t i = 0; i < TRACE_MAX_CORES; i++)
+    {
+        if (cores[i].seen && (cores[i].running != TRACE_NO_TASK))
+        {
+            if (cores[i].switchedOut != TRACE_NO_TASK)
+            {
+                closeSlice(i, cores[i].switchedOut, cores[i].runStart, cores[i].switchedOutTime);
+            }
+            else
+            {
+                closeSlice(i, cores[i].running, cores[i].runStart, cores[i].lastTime);
+            }
+        }
+        if (cores[i].seen && (jsonFile != NULL))
+        {
+            jsonEvent("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%" PRIu32 ",\"args\":{\"name\":\"Core %" PRIu32 "\"}}", i, i);
+        }
+    }
+
+    if (jsonFile != NULL)
+    {
+        fputs("\n]}\n", jsonFile);
+        fclose(jsonFile);
+    }
+    if (inputFile != stdin)
+    {
+        fclose(inputFile);
+    }
+
+    printResults();
+    for (uint32_t i = 0; i < TRACE_MAX_CORES; i++)
+    {
+        for (uint32_t j = 0; j < TRACE_MERGE_DEPTH; j++)
+        {
+            free(cores[i].blocks[j]);
+        }
+    }
+    free(tasks);
+    return 0;
+}